@@ -0,0 +1,454 @@
+/**
+ * @file console.c
+ * @brief Debug console command table and handlers
+ *
+ * REQ-SW-054: Debug Console
+ * Handlers print with printf: on the device that is UART0 next to the
+ * log, in the host build stdout.
+ */
+
+#include "console.h"
+#include "pet.h"
+#include "pet_history.h"
+#include "sim.h"
+#include "replay.h"
+#include "save_manager.h"
+#include "display.h"
+#include "telemetry.h"
+#include "esp_timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+
+//=============================================================================
+// Configuration
+//=============================================================================
+
+// pet_update() applies whole minutes, so a warp steps one sim minute at a
+// time: ticks rounded up to cover 60 s
+#define WARP_TICKS_PER_MIN  ((60000 + SIM_TICK_MS - 1) / SIM_TICK_MS)
+#define WARP_MS_PER_MIN     (WARP_TICKS_PER_MIN * SIM_TICK_MS)
+#define WARP_CHECK_MIN      16                  // Minutes between clock reads
+#define WARP_MAX_MIN        (60u * 24 * 60)     // 60 days
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+static console_executor_t s_executor = NULL;
+
+static struct {
+    uint32_t left;              // Minutes still to simulate
+    uint32_t done;              // Minutes simulated so far
+    int64_t start_us;           // Wall clock at the warp command
+    int64_t busy_us;            // Time spent inside console_warp_step()
+} s_warp;
+
+static const char *s_render_names[DISPLAY_RENDER_COUNT] = {
+    [DISPLAY_RENDER_IMMEDIATE] = "immediate",
+    [DISPLAY_RENDER_FRAMEBUFFER] = "framebuffer",
+    [DISPLAY_RENDER_BANDED] = "banded",
+};
+
+static const char *s_stage_names[] = {
+    [PET_STAGE_EGG] = "egg",
+    [PET_STAGE_BABY] = "baby",
+    [PET_STAGE_CHILD] = "child",
+    [PET_STAGE_TEEN] = "teen",
+    [PET_STAGE_ADULT] = "adult",
+    [PET_STAGE_DEAD] = "dead",
+};
+
+#define STAGE_COUNT     ((int)(sizeof(s_stage_names) / sizeof(s_stage_names[0])))
+
+// Byte-sized pet fields `pet set` may change directly
+static const struct {
+    const char *name;
+    size_t offset;
+    uint8_t min, max;
+} s_pet_fields[] = {
+    { "hunger",     offsetof(pet_state_t, hunger),     PET_STAT_MIN, PET_STAT_MAX },
+    { "happiness",  offsetof(pet_state_t, happiness),  PET_STAT_MIN, PET_STAT_MAX },
+    { "health",     offsetof(pet_state_t, health),     PET_STAT_MIN, PET_STAT_MAX },
+    { "energy",     offsetof(pet_state_t, energy),     PET_STAT_MIN, PET_STAT_MAX },
+    { "discipline", offsetof(pet_state_t, discipline), PET_STAT_MIN, PET_STAT_MAX },
+    { "weight",     offsetof(pet_state_t, weight),     1, 99 },
+};
+
+#define PET_FIELD_COUNT ((int)(sizeof(s_pet_fields) / sizeof(s_pet_fields[0])))
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+static bool parse_u32(const char *text, uint32_t max, uint32_t *out)
+{
+    char *end;
+    unsigned long v = strtoul(text, &end, 10);
+    if (end == text || *end != '\0' || v > max) return false;
+    *out = (uint32_t)v;
+    return true;
+}
+
+/**
+ * @brief Parse a duration: plain minutes, or a number with m, h or d
+ */
+static bool parse_minutes(const char *text, uint32_t max, uint32_t *out)
+{
+    char num[12];
+    size_t len = strlen(text);
+    uint32_t unit = 1;
+
+    if (len == 0 || len >= sizeof(num)) return false;
+    memcpy(num, text, len + 1);
+    switch (num[len - 1]) {
+        case 'd': unit = 24 * 60; num[len - 1] = '\0'; break;
+        case 'h': unit = 60;      num[len - 1] = '\0'; break;
+        case 'm':                 num[len - 1] = '\0'; break;
+        default: break;
+    }
+
+    uint32_t v;
+    if (!parse_u32(num, max / unit, &v)) return false;
+    *out = v * unit;
+    return true;
+}
+
+/**
+ * @brief Console changes are not input events: a recording would replay
+ *        without them, so end it
+ */
+static void leave_replay(void)
+{
+    if (replay_get_mode() != REPLAY_IDLE) {
+        replay_stop();
+        printf("Replay stopped: console changes are not recorded\n");
+    }
+}
+
+static void print_pet(void)
+{
+    const pet_state_t *pet = pet_get_state();
+
+    printf("stage %s, age %lu min (%lu d %lu h), mood %s%s\n",
+           pet_get_stage_name(), (unsigned long)pet->age_minutes,
+           (unsigned long)(pet->age_minutes / (24 * 60)),
+           (unsigned long)(pet->age_minutes / 60 % 24),
+           pet_get_mood_name(), pet->attention_needed ? ", needs attention" : "");
+    printf("hunger %u, happiness %u, health %u, energy %u, weight %u, discipline %u\n",
+           pet->hunger, pet->happiness, pet->health, pet->energy, pet->weight, pet->discipline);
+    printf("sick %d, poop %u, sleeping %d, sim time %lu s\n",
+           pet->is_sick, pet->poop_count, pet->is_sleeping,
+           (unsigned long)(sim_now_ms() / 1000));
+}
+
+static void print_warp_result(const char *how)
+{
+    uint32_t busy_us = (uint32_t)s_warp.busy_us;
+    uint32_t wall_ms = (uint32_t)((esp_timer_get_time() - s_warp.start_us) / 1000);
+    uint32_t rate = s_warp.busy_us > 0 ?
+                    (uint32_t)((uint64_t)s_warp.done * 1000000 / (uint64_t)s_warp.busy_us) : 0;
+
+    printf("Warp %s: %lu min (%lu.%lu d) in %lu.%lu ms of simulation, %lu sim-min/s (%lu ms wall)\n",
+           how, (unsigned long)s_warp.done,
+           (unsigned long)(s_warp.done / (24 * 60)),
+           (unsigned long)(s_warp.done % (24 * 60) * 10 / (24 * 60)),
+           (unsigned long)(busy_us / 1000), (unsigned long)(busy_us % 1000 / 100),
+           (unsigned long)rate, (unsigned long)wall_ms);
+    print_pet();
+}
+
+//=============================================================================
+// Command Handlers
+//=============================================================================
+
+static int cmd_help(int argc, char **argv);
+
+static int cmd_pet(int argc, char **argv)
+{
+    if (argc == 1) {
+        print_pet();
+        return 0;
+    }
+    if (argc != 4 || strcmp(argv[1], "set") != 0) {
+        printf("usage: pet [set <field> <value>]\n");
+        return 1;
+    }
+
+    const char *field = argv[2];
+    const char *value = argv[3];
+    pet_state_t *pet = pet_get_state_mutable();
+    uint32_t v;
+
+    for (int i = 0; i < PET_FIELD_COUNT; i++) {
+        if (strcmp(field, s_pet_fields[i].name) != 0) continue;
+        if (!parse_u32(value, s_pet_fields[i].max, &v) || v < s_pet_fields[i].min) {
+            printf("%s: %u..%u\n", field, s_pet_fields[i].min, s_pet_fields[i].max);
+            return 1;
+        }
+        leave_replay();
+        *((uint8_t *)pet + s_pet_fields[i].offset) = (uint8_t)v;
+        print_pet();
+        return 0;
+    }
+
+    if (strcmp(field, "stage") == 0) {
+        int stage = -1;
+        for (int i = 0; i < STAGE_COUNT; i++) {
+            if (strcmp(value, s_stage_names[i]) == 0) stage = i;
+        }
+        if (stage < 0) {
+            printf("stage: egg, baby, child, teen, adult or dead\n");
+            return 1;
+        }
+        leave_replay();
+        pet->stage = (pet_stage_t)stage;
+    } else if (strcmp(field, "age") == 0) {
+        if (!parse_minutes(value, UINT32_MAX, &v)) {
+            printf("age: minutes, or a number with m, h or d\n");
+            return 1;
+        }
+        // Stage left alone: it only steps up from the one before, so
+        // set it separately when jumping past a threshold
+        leave_replay();
+        pet->age_minutes = v;
+    } else if (strcmp(field, "sick") == 0 && parse_u32(value, 1, &v)) {
+        leave_replay();
+        pet->is_sick = v != 0;
+    } else if (strcmp(field, "poop") == 0 && parse_u32(value, UINT8_MAX, &v)) {
+        leave_replay();
+        pet->poop_count = (uint8_t)v;
+        pet->has_poop = v > 0;
+    } else if (strcmp(field, "sleep") == 0 && parse_u32(value, 1, &v)) {
+        leave_replay();
+        if (!(v ? pet_sleep() : pet_wake())) {
+            printf("The pet cannot %s now\n", v ? "sleep" : "wake");
+            return 1;
+        }
+    } else {
+        printf("fields: hunger happiness health energy discipline weight (0-100), "
+               "stage, age, sick 0|1, poop <count>, sleep 0|1\n");
+        return 1;
+    }
+    print_pet();
+    return 0;
+}
+
+static int cmd_warp(int argc, char **argv)
+{
+    if (argc == 1) {
+        if (s_warp.left) {
+            printf("Warping: %lu of %lu min done\n", (unsigned long)s_warp.done,
+                   (unsigned long)(s_warp.done + s_warp.left));
+        } else {
+            printf("No warp running\n");
+        }
+        return 0;
+    }
+    if (argc == 2 && strcmp(argv[1], "stop") == 0) {
+        if (s_warp.left) {
+            s_warp.left = 0;
+            print_warp_result("stopped");
+        }
+        return 0;
+    }
+
+    uint32_t minutes;
+    if (argc != 2 || !parse_minutes(argv[1], WARP_MAX_MIN, &minutes) || minutes == 0) {
+        printf("usage: warp <minutes|Nh|Nd> (up to 60 d) | stop\n");
+        return 1;
+    }
+    if (!pet_is_alive()) {
+        printf("The pet is dead; nothing to simulate\n");
+        return 1;
+    }
+
+    leave_replay();
+    s_warp.left = minutes;
+    s_warp.done = 0;
+    s_warp.busy_us = 0;
+    s_warp.start_us = esp_timer_get_time();
+    printf("Warping %lu min...\n", (unsigned long)minutes);
+    return 0;
+}
+
+static int cmd_away(int argc, char **argv)
+{
+    uint32_t minutes;
+    if (argc != 2 || !parse_minutes(argv[1], UINT32_MAX, &minutes)) {
+        printf("usage: away <minutes|Nh|Nd> (capped at 48 h like a real absence)\n");
+        return 1;
+    }
+
+    leave_replay();
+    pet_apply_time_away(minutes);
+    print_pet();
+    return 0;
+}
+
+static int cmd_save(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    esp_err_t ret = save_manager_save_state(pet_get_state());
+    printf("Save: %s\n", esp_err_to_name(ret));
+    return ret == ESP_OK ? 0 : 1;
+}
+
+static int cmd_load(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    leave_replay();
+    esp_err_t ret = save_manager_load();
+    printf("Load: %s\n", esp_err_to_name(ret));
+    if (ret != ESP_OK) return 1;
+    print_pet();
+    return 0;
+}
+
+static int cmd_perf(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    pet_snapshot_stats_t snap;
+    display_stats_t spi;
+
+    // Frame-time histograms go to the log; the window keeps running
+    telemetry_report(false);
+
+    pet_get_snapshot_stats(&snap);
+    display_get_stats(&spi);
+    printf("pet snapshots: %lu published, %lu read, %lu retries (max %lu)\n",
+           (unsigned long)snap.publishes, (unsigned long)snap.reads,
+           (unsigned long)snap.retries, (unsigned long)snap.max_retries);
+    printf("SPI since boot: %lu bytes, %lu transactions, %lu ms busy\n",
+           (unsigned long)spi.bytes, (unsigned long)spi.transactions,
+           (unsigned long)(spi.busy_us / 1000));
+    return 0;
+}
+
+static int cmd_render(int argc, char **argv)
+{
+    if (argc == 1) {
+        printf("Render mode: %s\n", s_render_names[display_get_render_mode()]);
+        return 0;
+    }
+    for (int mode = 0; mode < DISPLAY_RENDER_COUNT; mode++) {
+        if (argc == 2 && strcmp(argv[1], s_render_names[mode]) == 0) {
+            // Not stored: the settings screen value applies again at boot.
+            // Runs on the sim task, so the next frame switches.
+            esp_err_t ret = display_request_render_mode((display_render_mode_t)mode);
+            printf("Render mode %s: %s\n", s_render_names[mode], esp_err_to_name(ret));
+            return ret == ESP_OK ? 0 : 1;
+        }
+    }
+    printf("usage: render [immediate|framebuffer|banded]\n");
+    return 1;
+}
+
+static const console_cmd_t s_commands[] = {
+    { "help",   NULL,                        "List commands", cmd_help },
+    { "pet",    "[set <field> <value>]",     "Show the pet, or change one field", cmd_pet },
+    { "warp",   "<minutes|Nh|Nd> | stop",    "Simulate time as fast as the CPU allows", cmd_warp },
+    { "away",   "<minutes|Nh|Nd>",           "Apply offline time like a boot after an absence", cmd_away },
+    { "save",   NULL,                        "Save the pet to NVS now", cmd_save },
+    { "load",   NULL,                        "Load the pet from NVS", cmd_load },
+    { "perf",   NULL,                        "Dump frame-time telemetry and counters", cmd_perf },
+    { "render", "[immediate|framebuffer|banded]", "Show or switch the render mode", cmd_render },
+};
+
+#define COMMAND_COUNT   ((int)(sizeof(s_commands) / sizeof(s_commands[0])))
+
+static int cmd_help(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    for (int i = 0; i < COMMAND_COUNT; i++) {
+        const console_cmd_t *cmd = &s_commands[i];
+        printf("  %-6s %-32s %s\n", cmd->name, cmd->args ? cmd->args : "", cmd->help);
+    }
+    return 0;
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+void console_set_executor(console_executor_t executor)
+{
+    s_executor = executor;
+}
+
+int console_command_count(void)
+{
+    return COMMAND_COUNT;
+}
+
+const console_cmd_t *console_command(int index)
+{
+    return (index >= 0 && index < COMMAND_COUNT) ? &s_commands[index] : NULL;
+}
+
+int console_dispatch(int argc, char **argv)
+{
+    if (argc < 1) return 0;
+
+    for (int i = 0; i < COMMAND_COUNT; i++) {
+        if (strcmp(argv[0], s_commands[i].name) == 0) {
+            console_fn_t fn = s_commands[i].fn;
+            return s_executor ? s_executor(fn, argc, argv) : fn(argc, argv);
+        }
+    }
+    printf("Unknown command '%s', try help\n", argv[0]);
+    return -1;
+}
+
+int console_exec_line(char *line)
+{
+    char *argv[CONSOLE_MAX_ARGS];
+    int argc = 0;
+    char *save = NULL;
+
+    for (char *tok = strtok_r(line, " \t\r\n", &save); tok && argc < CONSOLE_MAX_ARGS;
+         tok = strtok_r(NULL, " \t\r\n", &save)) {
+        argv[argc++] = tok;
+    }
+    return argc ? console_dispatch(argc, argv) : 0;
+}
+
+bool console_warp_active(void)
+{
+    return s_warp.left > 0;
+}
+
+void console_warp_step(uint32_t budget_us)
+{
+    if (s_warp.left == 0) return;
+
+    int64_t start = esp_timer_get_time();
+    int64_t now = start;
+
+    while (s_warp.left > 0) {
+        sim_advance(WARP_TICKS_PER_MIN);
+        pet_update(WARP_MS_PER_MIN);
+        pet_history_update(WARP_MS_PER_MIN);
+        s_warp.left--;
+        s_warp.done++;
+
+        if (!pet_is_alive()) {
+            s_warp.left = 0;
+            break;
+        }
+        if ((s_warp.done % WARP_CHECK_MIN) == 0) {
+            now = esp_timer_get_time();
+            if (now - start >= budget_us) break;
+        }
+    }
+
+    s_warp.busy_us += esp_timer_get_time() - start;
+    if (s_warp.left == 0) {
+        print_warp_result(pet_is_alive() ? "done" : "ended, the pet died");
+    }
+}
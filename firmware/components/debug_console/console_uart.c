@@ -0,0 +1,127 @@
+/**
+ * @file console_uart.c
+ * @brief Debug console on UART0 through esp_console
+ *
+ * REQ-SW-054: Debug Console
+ * Lines are read by the console task into a static buffer (echo and
+ * backspace only, no history) and parsed by esp_console, which also
+ * lists the commands for its `help`-style hints.
+ */
+
+#include "console.h"
+
+#if CONSOLE_ENABLED
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/uart.h"
+#include "esp_console.h"
+#include "esp_vfs_dev.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+#include <stdio.h>
+
+static const char *TAG = "console";
+
+//=============================================================================
+// Configuration
+//=============================================================================
+
+#define CONSOLE_UART_NUM    CONFIG_ESP_CONSOLE_UART_NUM
+#define CONSOLE_RX_BUF      256
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+static char s_line[CONSOLE_LINE_MAX];
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+/**
+ * @brief Read one line with echo, blocking
+ * @return Length of the line in s_line
+ */
+static int read_line(void)
+{
+    int len = 0;
+    char c;
+
+    while (1) {
+        if (uart_read_bytes(CONSOLE_UART_NUM, &c, 1, portMAX_DELAY) != 1) continue;
+
+        if (c == '\r' || c == '\n') {
+            if (len == 0 && c == '\n') continue;    // Second half of CR LF
+            printf("\n");
+            s_line[len] = '\0';
+            return len;
+        }
+        if ((c == '\b' || c == 0x7f) && len > 0) {
+            len--;
+            printf("\b \b");
+        } else if (c >= ' ' && c < 0x7f && len < CONSOLE_LINE_MAX - 1) {
+            s_line[len++] = c;
+            putchar(c);
+        }
+        fflush(stdout);
+    }
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+esp_err_t console_init(void)
+{
+    esp_err_t ret = uart_driver_install(CONSOLE_UART_NUM, CONSOLE_RX_BUF, 0, 0, NULL, 0);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "UART driver install failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    // stdout through the driver too, so log lines and echo do not collide
+    esp_vfs_dev_uart_use_driver(CONSOLE_UART_NUM);
+
+    esp_console_config_t cfg = ESP_CONSOLE_CONFIG_DEFAULT();
+    cfg.max_cmdline_args = CONSOLE_MAX_ARGS;
+    cfg.max_cmdline_length = CONSOLE_LINE_MAX;
+    ret = esp_console_init(&cfg);
+
+    for (int i = 0; ret == ESP_OK && i < console_command_count(); i++) {
+        const console_cmd_t *cmd = console_command(i);
+        const esp_console_cmd_t def = {
+            .command = cmd->name,
+            .help = cmd->help,
+            .hint = cmd->args,
+            .func = console_dispatch,
+        };
+        ret = esp_console_cmd_register(&def);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Console setup failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    ESP_LOGI(TAG, "%d commands on UART%d, type help", console_command_count(), CONSOLE_UART_NUM);
+    return ESP_OK;
+}
+
+void console_task(void *param)
+{
+    while (1) {
+        printf(CONSOLE_PROMPT);
+        fflush(stdout);
+        if (read_line() == 0) continue;
+
+        int cmd_ret;
+        esp_err_t ret = esp_console_run(s_line, &cmd_ret);
+        if (ret == ESP_ERR_NOT_FOUND) {
+            printf("Unknown command, try help\n");
+        } else if (ret != ESP_OK && ret != ESP_ERR_INVALID_ARG) {
+            printf("Console error: %s\n", esp_err_to_name(ret));
+        }
+    }
+}
+
+#endif // CONSOLE_ENABLED
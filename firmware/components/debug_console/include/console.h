@@ -0,0 +1,122 @@
+/**
+ * @file console.h
+ * @brief Debug console for ESP32 Tamagotchi
+ *
+ * REQ-SW-054: Debug Console
+ * Commands to inspect and change the pet, warp the simulation clock,
+ * apply offline time, save and load, dump the performance counters and
+ * switch render modes. The command table and its handlers are portable:
+ * on the device they sit behind esp_console on UART0 (build with
+ * `idf.py -DCONSOLE=1`), in the host build behind a stdin/stdout loop.
+ *
+ * Handlers change game state, so the application can install an
+ * executor that runs them on the task owning that state (the simulation
+ * task); without one they run on the caller. A time warp is only started
+ * by its command; the owner then advances it with console_warp_step()
+ * in slices, so frames keep coming while weeks go by.
+ */
+
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifndef CONSOLE_ENABLED
+#define CONSOLE_ENABLED     0
+#endif
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define CONSOLE_MAX_ARGS    8
+#define CONSOLE_LINE_MAX    128
+#define CONSOLE_PROMPT      "tama> "
+
+//=============================================================================
+// Types
+//=============================================================================
+
+/**
+ * @brief Command handler
+ * @return 0 on success, non-zero on a usage or execution error
+ */
+typedef int (*console_fn_t)(int argc, char **argv);
+
+/**
+ * @brief One console command
+ */
+typedef struct {
+    const char *name;
+    const char *args;           // Argument synopsis, NULL if none
+    const char *help;
+    console_fn_t fn;
+} console_cmd_t;
+
+/**
+ * @brief Runs a handler on the task that owns game state
+ * @return The handler's result
+ */
+typedef int (*console_executor_t)(console_fn_t fn, int argc, char **argv);
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+/**
+ * @brief Install the executor for command handlers (NULL: run on the caller)
+ */
+void console_set_executor(console_executor_t executor);
+
+/**
+ * @brief Number of commands in the table
+ */
+int console_command_count(void);
+
+/**
+ * @brief Get a command of the table
+ */
+const console_cmd_t *console_command(int index);
+
+/**
+ * @brief Run the command named by argv[0] through the executor
+ * @return Handler result, -1 if there is no such command
+ */
+int console_dispatch(int argc, char **argv);
+
+/**
+ * @brief Split a line in place into arguments and dispatch it
+ * @return Handler result, 0 for an empty line, -1 for an unknown command
+ */
+int console_exec_line(char *line);
+
+/**
+ * @brief True while a time warp has minutes left
+ */
+bool console_warp_active(void);
+
+/**
+ * @brief Advance a running time warp (call from the state owner)
+ * @param budget_us Wall time this slice may take; the warp reports its
+ *        simulated minutes per second when it ends
+ */
+void console_warp_step(uint32_t budget_us);
+
+#if CONSOLE_ENABLED
+
+/**
+ * @brief Set up esp_console and its UART (call once before console_task runs)
+ * @return ESP_OK on success, or the driver error
+ */
+esp_err_t console_init(void);
+
+/**
+ * @brief Console task: reads command lines from UART0 and runs them
+ */
+void console_task(void *param);
+
+#endif // CONSOLE_ENABLED
+
+#endif // CONSOLE_H
@@ -3,16 +3,33 @@
  * @brief ST7789 LCD display driver implementation
  *
  * REQ-SW-030: Display Driver
+ * REQ-SW-018: Settings Screen (render modes)
  * Optimized for TTGO T-Display with 240x135 pixel ST7789 panel.
+ *
+ * Drawing functions open a window and stream pixels into it. In the
+ * immediate render mode those go straight to the panel; in the buffered
+ * modes they land in a RAM copy of the screen, and display_end_frame()
+ * sends what changed, so a frame's erase-then-draw is never visible.
+ *
+ * REQ-SW-039: Static Memory Budget
+ * The transfer buffer is static. The 63 KB screen copy would push static
+ * DRAM past what the ESP32 links, so display_init() takes it from the
+ * heap once, next to the SPI driver's own setup; switching render modes
+ * never allocates.
  */
 
 #include "display.h"
+#include "latency.h"
+#include "trace.h"
 #include "driver/spi_master.h"
 #include "driver/ledc.h"
 #include "driver/gpio.h"
+#include "esp_timer.h"
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include <stdatomic.h>
+#include <stdlib.h>
 #include <string.h>
 
 static const char *TAG = "display";
@@ -158,15 +175,57 @@ static const uint8_t s_font_6x8[] = {
 // Static variables
 static spi_device_handle_t s_spi = NULL;
 static uint8_t s_brightness = 200;
+static const uint8_t *s_font = s_font_6x8;
 
 // DMA-capable buffer for SPI transfers
-#define SPI_MAX_TRANSFER_SIZE   (LCD_WIDTH * 32 * 2)  // 32 rows at a time
+#define SPI_MAX_TRANSFER_SIZE   DISPLAY_SPI_BUFFER_BYTES
 static DRAM_ATTR uint8_t s_spi_buffer[SPI_MAX_TRANSFER_SIZE];
 
+_Static_assert(LCD_WIDTH == DISPLAY_WIDTH && LCD_HEIGHT == DISPLAY_HEIGHT,
+               "panel size does not match display.h");
+
+// Current address window (screen coordinates, inclusive)
+static int16_t s_win_x0, s_win_y0, s_win_x1, s_win_y1;
+
+// Bus traffic since boot (commands, parameters and pixels)
+static display_stats_t s_stats;
+
+// Buffered render modes: screen copy in panel byte order, and the changed
+// column span of each band of rows (x0 > x1: clean)
+#define FB_BAND_ROWS        9
+#define FB_BANDS            ((LCD_HEIGHT + FB_BAND_ROWS - 1) / FB_BAND_ROWS)
+
+typedef struct {
+    int16_t x0, x1;
+} fb_span_t;
+
+static display_render_mode_t s_render_mode = DISPLAY_RENDER_IMMEDIATE;
+static atomic_int s_mode_request = DISPLAY_RENDER_IMMEDIATE;  // Applied by display_start_frame()
+#if DISPLAY_FRAMEBUFFER
+static uint16_t *s_fb_mem = NULL;           // Screen copy, allocated once by display_init()
+_Static_assert(LCD_WIDTH * LCD_HEIGHT * sizeof(uint16_t) == DISPLAY_FRAMEBUFFER_BYTES,
+               "screen copy outside its budget");
+#endif
+static uint16_t *s_fb = NULL;               // s_fb_mem in the buffered modes
+static fb_span_t s_fb_dirty[FB_BANDS];
+static int16_t s_fb_x, s_fb_y;             // Write cursor inside the window
+
 //-----------------------------------------------------------------------------
 // Low-level SPI functions
 //-----------------------------------------------------------------------------
 
+/**
+ * @brief Run one blocking SPI transaction and count it
+ */
+static void lcd_transmit(spi_transaction_t *t, size_t bytes)
+{
+    int64_t start = esp_timer_get_time();
+    spi_device_polling_transmit(s_spi, t);
+    s_stats.busy_us += (uint32_t)(esp_timer_get_time() - start);
+    s_stats.bytes += bytes;
+    s_stats.transactions++;
+}
+
 static void lcd_cmd(uint8_t cmd)
 {
     gpio_set_level(LCD_PIN_DC, 0);  // Command mode
@@ -174,7 +233,7 @@ static void lcd_cmd(uint8_t cmd)
         .length = 8,
         .tx_buffer = &cmd,
     };
-    spi_device_polling_transmit(s_spi, &t);
+    lcd_transmit(&t, 1);
 }
 
 static void lcd_data(const uint8_t *data, size_t len)
@@ -185,7 +244,7 @@ static void lcd_data(const uint8_t *data, size_t len)
         .length = len * 8,
         .tx_buffer = data,
     };
-    spi_device_polling_transmit(s_spi, &t);
+    lcd_transmit(&t, len);
 }
 
 static void lcd_data_byte(uint8_t data)
@@ -195,6 +254,11 @@ static void lcd_data_byte(uint8_t data)
 
 static void lcd_set_window(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
 {
+    s_win_x0 = x0;
+    s_win_y0 = y0;
+    s_win_x1 = x1;
+    s_win_y1 = y1;
+
     // Apply ST7789 offset for 135x240 on 240x320 panel
     // The display is rotated, so we swap x/y offsets
     uint16_t xa = x0 + LCD_COL_OFFSET;
@@ -213,6 +277,121 @@ static void lcd_set_window(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
     lcd_cmd(ST7789_RAMWR);
 }
 
+/**
+ * @brief Send RGB565 pixels (already byte-swapped) into the current window
+ *
+ * Every pixel write goes through here so latency tracing sees the last
+ * transfer that touched each screen area.
+ */
+static void lcd_tx_pixels(const void *pixels, size_t count)
+{
+    TRACE_ZONE("spi_pixels");
+    gpio_set_level(LCD_PIN_DC, 1);  // Data mode
+    spi_transaction_t t = {
+        .length = count * 16,
+        .tx_buffer = pixels,
+    };
+    lcd_transmit(&t, count * 2);
+    latency_pixels(s_win_x0, s_win_y0, s_win_x1, s_win_y1);
+}
+
+//-----------------------------------------------------------------------------
+// Window output (panel or screen copy)
+//-----------------------------------------------------------------------------
+
+static void fb_clear_dirty(void)
+{
+    for (int b = 0; b < FB_BANDS; b++) {
+        s_fb_dirty[b].x0 = LCD_WIDTH;
+        s_fb_dirty[b].x1 = -1;
+    }
+}
+
+/**
+ * @brief Open a window for the following win_write() calls
+ */
+static void win_begin(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    if (s_fb == NULL) {
+        lcd_set_window(x0, y0, x1, y1);
+        return;
+    }
+
+    s_win_x0 = x0;
+    s_win_y0 = y0;
+    s_win_x1 = x1;
+    s_win_y1 = y1;
+    s_fb_x = x0;
+    s_fb_y = y0;
+
+    // Mark the on-screen part of the window as changed
+    int16_t cx0 = (x0 < 0) ? 0 : x0;
+    int16_t cx1 = (x1 >= LCD_WIDTH) ? LCD_WIDTH - 1 : x1;
+    int16_t cy0 = (y0 < 0) ? 0 : y0;
+    int16_t cy1 = (y1 >= LCD_HEIGHT) ? LCD_HEIGHT - 1 : y1;
+    if (cx0 > cx1 || cy0 > cy1) return;
+    for (int b = cy0 / FB_BAND_ROWS; b <= cy1 / FB_BAND_ROWS; b++) {
+        if (cx0 < s_fb_dirty[b].x0) s_fb_dirty[b].x0 = cx0;
+        if (cx1 > s_fb_dirty[b].x1) s_fb_dirty[b].x1 = cx1;
+    }
+}
+
+/**
+ * @brief Stream pixels (panel byte order) into the window, row by row
+ *
+ * Like the panel, the cursor wraps to the window start after its last
+ * pixel. Pixels off the screen are dropped.
+ */
+static void win_write(const void *pixels, size_t count)
+{
+    if (s_fb == NULL) {
+        lcd_tx_pixels(pixels, count);
+        return;
+    }
+
+    const uint16_t *src = pixels;
+    while (count > 0) {
+        int16_t n = s_win_x1 - s_fb_x + 1;
+        if ((size_t)n > count) n = (int16_t)count;
+
+        if (s_fb_y >= 0 && s_fb_y < LCD_HEIGHT) {
+            int16_t a = (s_fb_x < 0) ? 0 : s_fb_x;
+            int16_t b = (s_fb_x + n > LCD_WIDTH) ? LCD_WIDTH : s_fb_x + n;
+            if (a < b) {
+                memcpy(&s_fb[s_fb_y * LCD_WIDTH + a], &src[a - s_fb_x], (b - a) * sizeof(uint16_t));
+            }
+        }
+
+        src += n;
+        count -= n;
+        s_fb_x += n;
+        if (s_fb_x > s_win_x1) {
+            s_fb_x = s_win_x0;
+            s_fb_y = (s_fb_y >= s_win_y1) ? s_win_y0 : s_fb_y + 1;
+        }
+    }
+}
+
+/**
+ * @brief Send one rectangle of the screen copy to the panel
+ */
+static void fb_flush_rect(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    TRACE_ZONE("fb_flush");
+    int16_t w = x1 - x0 + 1;
+    int16_t rows_per_batch = (SPI_MAX_TRANSFER_SIZE / 2) / w;
+    uint16_t *buf16 = (uint16_t *)s_spi_buffer;
+
+    lcd_set_window(x0, y0, x1, y1);
+    for (int16_t y = y0; y <= y1; y += rows_per_batch) {
+        int16_t rows = (y1 - y + 1 < rows_per_batch) ? y1 - y + 1 : rows_per_batch;
+        for (int16_t r = 0; r < rows; r++) {
+            memcpy(&buf16[r * w], &s_fb[(y + r) * LCD_WIDTH + x0], w * sizeof(uint16_t));
+        }
+        lcd_tx_pixels(s_spi_buffer, (size_t)rows * w);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // Initialization
 //-----------------------------------------------------------------------------
@@ -266,6 +445,16 @@ esp_err_t display_init(void)
         return ret;
     }
 
+#if DISPLAY_FRAMEBUFFER
+    // Boot-time allocation (REQ-SW-039); without it only immediate mode works
+    if (s_fb_mem == NULL) {
+        s_fb_mem = calloc(LCD_WIDTH * LCD_HEIGHT, sizeof(uint16_t));
+        if (s_fb_mem == NULL) {
+            ESP_LOGW(TAG, "No memory for a screen buffer, immediate mode only");
+        }
+    }
+#endif
+
     // Initialize display with ST7789 commands
     lcd_cmd(ST7789_SWRESET);
     vTaskDelay(pdMS_TO_TICKS(150));
@@ -333,7 +522,7 @@ void display_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t colo
     if (x + w > LCD_WIDTH) w = LCD_WIDTH - x;
     if (y + h > LCD_HEIGHT) h = LCD_HEIGHT - y;
 
-    lcd_set_window(x, y, x + w - 1, y + h - 1);
+    win_begin(x, y, x + w - 1, y + h - 1);
 
     // Swap bytes for SPI (big-endian)
     uint16_t color_swapped = (color >> 8) | (color << 8);
@@ -349,16 +538,10 @@ void display_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t colo
         buf16[i] = color_swapped;
     }
 
-    gpio_set_level(LCD_PIN_DC, 1);  // Data mode
-
     size_t remaining = total_pixels;
     while (remaining > 0) {
         size_t batch = (remaining > pixels_per_batch) ? pixels_per_batch : remaining;
-        spi_transaction_t t = {
-            .length = batch * 16,
-            .tx_buffer = s_spi_buffer,
-        };
-        spi_device_polling_transmit(s_spi, &t);
+        win_write(s_spi_buffer, batch);
         remaining -= batch;
     }
 }
@@ -367,9 +550,9 @@ void display_draw_pixel(int16_t x, int16_t y, uint16_t color)
 {
     if (x < 0 || x >= LCD_WIDTH || y < 0 || y >= LCD_HEIGHT) return;
 
-    lcd_set_window(x, y, x, y);
+    win_begin(x, y, x, y);
     uint8_t data[] = {color >> 8, color & 0xFF};
-    lcd_data(data, 2);
+    win_write(data, 1);
 }
 
 void display_draw_hline(int16_t x, int16_t y, int16_t w, uint16_t color)
@@ -390,6 +573,30 @@ void display_draw_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t colo
     display_draw_vline(x + w - 1, y, h, color);
 }
 
+void display_draw_bitmap(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *data)
+{
+    win_begin(x, y, x + w - 1, y + h - 1);
+
+    // Prepare buffer with byte-swapped pixels for SPI
+    size_t total_pixels = w * h;
+    size_t pixels_per_batch = SPI_MAX_TRANSFER_SIZE / 2;
+    uint16_t *buf16 = (uint16_t *)s_spi_buffer;
+
+    size_t sent = 0;
+    while (sent < total_pixels) {
+        size_t batch = ((total_pixels - sent) > pixels_per_batch) ? pixels_per_batch : (total_pixels - sent);
+
+        // Byte-swap pixels into buffer
+        for (size_t i = 0; i < batch; i++) {
+            uint16_t pixel = data[sent + i];
+            buf16[i] = (pixel >> 8) | (pixel << 8);
+        }
+
+        win_write(s_spi_buffer, batch);
+        sent += batch;
+    }
+}
+
 void display_draw_sprite(int16_t x, int16_t y, int16_t w, int16_t h,
                          const uint16_t *data, uint16_t transparent)
 {
@@ -403,32 +610,7 @@ void display_draw_sprite(int16_t x, int16_t y, int16_t w, int16_t h,
 
     if (!has_transparency) {
         // Fast path: no transparency, send entire sprite in one transaction
-        lcd_set_window(x, y, x + w - 1, y + h - 1);
-
-        // Prepare buffer with byte-swapped pixels for SPI
-        size_t total_pixels = w * h;
-        size_t pixels_per_batch = SPI_MAX_TRANSFER_SIZE / 2;
-        uint16_t *buf16 = (uint16_t *)s_spi_buffer;
-
-        gpio_set_level(LCD_PIN_DC, 1);
-
-        size_t sent = 0;
-        while (sent < total_pixels) {
-            size_t batch = ((total_pixels - sent) > pixels_per_batch) ? pixels_per_batch : (total_pixels - sent);
-
-            // Byte-swap pixels into buffer
-            for (size_t i = 0; i < batch; i++) {
-                uint16_t pixel = data[sent + i];
-                buf16[i] = (pixel >> 8) | (pixel << 8);
-            }
-
-            spi_transaction_t t = {
-                .length = batch * 16,
-                .tx_buffer = s_spi_buffer,
-            };
-            spi_device_polling_transmit(s_spi, &t);
-            sent += batch;
-        }
+        display_draw_bitmap(x, y, w, h, data);
     } else {
         // Slow path: handle transparency by drawing row by row
         // This reduces SPI transactions compared to pixel-by-pixel
@@ -445,7 +627,7 @@ void display_draw_sprite(int16_t x, int16_t y, int16_t w, int16_t h,
                 } else if (!is_visible && run_start >= 0) {
                     // End of visible run - draw it
                     int16_t run_len = i - run_start;
-                    lcd_set_window(x + run_start, y + j, x + i - 1, y + j);
+                    win_begin(x + run_start, y + j, x + i - 1, y + j);
 
                     uint16_t *buf16 = (uint16_t *)s_spi_buffer;
                     for (int16_t k = 0; k < run_len; k++) {
@@ -453,12 +635,7 @@ void display_draw_sprite(int16_t x, int16_t y, int16_t w, int16_t h,
                         buf16[k] = (p >> 8) | (p << 8);
                     }
 
-                    gpio_set_level(LCD_PIN_DC, 1);
-                    spi_transaction_t t = {
-                        .length = run_len * 16,
-                        .tx_buffer = s_spi_buffer,
-                    };
-                    spi_device_polling_transmit(s_spi, &t);
+                    win_write(s_spi_buffer, run_len);
                     run_start = -1;
                 }
             }
@@ -482,7 +659,7 @@ void display_draw_sprite_scaled(int16_t x, int16_t y, int16_t w, int16_t h,
 void display_draw_char(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size)
 {
     if (c < 32 || c > 126) c = '?';
-    const uint8_t *glyph = &s_font_6x8[(c - 32) * 6];
+    const uint8_t *glyph = &s_font[(c - 32) * 6];
 
     // Swap bytes for SPI (big-endian)
     uint16_t color_swapped = (color >> 8) | (color << 8);
@@ -506,13 +683,8 @@ void display_draw_char(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg
         }
 
         // Send entire character in one SPI transaction
-        lcd_set_window(x, y, x + 5, y + 7);
-        gpio_set_level(LCD_PIN_DC, 1);
-        spi_transaction_t t = {
-            .length = 6 * 8 * 16,  // 48 pixels * 16 bits
-            .tx_buffer = char_buf,
-        };
-        spi_device_polling_transmit(s_spi, &t);
+        win_begin(x, y, x + 5, y + 7);
+        win_write(char_buf, 6 * 8);
     } else {
         // For scaled text, first fill background rectangle, then draw foreground
         int16_t char_w = 6 * size;
@@ -535,6 +707,11 @@ void display_draw_char(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg
     }
 }
 
+void display_set_font(const uint8_t *glyphs)
+{
+    s_font = glyphs ? glyphs : s_font_6x8;
+}
+
 void display_draw_string(int16_t x, int16_t y, const char *str, uint16_t color, uint16_t bg, uint8_t size)
 {
     while (*str) {
@@ -563,12 +740,102 @@ uint8_t display_get_brightness(void)
     return s_brightness;
 }
 
+esp_err_t display_set_render_mode(display_render_mode_t mode)
+{
+    if (mode >= DISPLAY_RENDER_COUNT) return ESP_ERR_INVALID_ARG;
+    if (mode == s_render_mode) return ESP_OK;
+
+    if (mode == DISPLAY_RENDER_IMMEDIATE) {
+        s_fb = NULL;
+    } else if (s_fb == NULL) {
+#if DISPLAY_FRAMEBUFFER
+        if (s_fb_mem == NULL) {
+            ESP_LOGW(TAG, "No screen buffer, staying in immediate mode");
+            return ESP_ERR_NO_MEM;
+        }
+        s_fb = s_fb_mem;
+        // Contents unknown until the next full repaint
+        fb_clear_dirty();
+#else
+        ESP_LOGW(TAG, "Built without a screen buffer, staying in immediate mode");
+        return ESP_ERR_NOT_SUPPORTED;
+#endif
+    }
+
+    ESP_LOGI(TAG, "Render mode %d", mode);
+    s_render_mode = mode;
+    atomic_store_explicit(&s_mode_request, mode, memory_order_relaxed);
+    return ESP_OK;
+}
+
+esp_err_t display_request_render_mode(display_render_mode_t mode)
+{
+    if (mode >= DISPLAY_RENDER_COUNT) return ESP_ERR_INVALID_ARG;
+#if DISPLAY_FRAMEBUFFER
+    // s_fb_mem is set before the tasks start, so any task may read it
+    if (mode != DISPLAY_RENDER_IMMEDIATE && s_fb_mem == NULL) {
+        ESP_LOGW(TAG, "No screen buffer, staying in immediate mode");
+        return ESP_ERR_NO_MEM;
+    }
+#else
+    if (mode != DISPLAY_RENDER_IMMEDIATE) {
+        ESP_LOGW(TAG, "Built without a screen buffer, staying in immediate mode");
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+#endif
+
+    atomic_store_explicit(&s_mode_request, mode, memory_order_relaxed);
+    return ESP_OK;
+}
+
+display_render_mode_t display_get_render_mode(void)
+{
+    return (display_render_mode_t)atomic_load_explicit(&s_mode_request, memory_order_relaxed);
+}
+
 void display_start_frame(void)
 {
-    // Placeholder for double buffering implementation
+    // A mode requested by another task swaps the screen copy between frames
+    display_render_mode_t mode = (display_render_mode_t)atomic_load_explicit(&s_mode_request,
+                                                                             memory_order_relaxed);
+    if (mode != s_render_mode && display_set_render_mode(mode) != ESP_OK) {
+        // Keep reporting the mode actually in use
+        atomic_store_explicit(&s_mode_request, s_render_mode, memory_order_relaxed);
+    }
+    // Buffered modes collect the frame in s_fb; nothing else to prepare
 }
 
 void display_end_frame(void)
 {
-    // Placeholder for double buffering implementation
+    if (s_fb == NULL) return;
+
+    if (s_render_mode == DISPLAY_RENDER_BANDED) {
+        // Changed span of each band: less traffic when changes are scattered
+        for (int b = 0; b < FB_BANDS; b++) {
+            if (s_fb_dirty[b].x0 > s_fb_dirty[b].x1) continue;
+            int16_t y1 = (b + 1) * FB_BAND_ROWS - 1;
+            if (y1 >= LCD_HEIGHT) y1 = LCD_HEIGHT - 1;
+            fb_flush_rect(s_fb_dirty[b].x0, b * FB_BAND_ROWS, s_fb_dirty[b].x1, y1);
+        }
+    } else {
+        // Bounding box of all changes: one window per frame
+        int16_t x0 = LCD_WIDTH, x1 = -1, y0 = -1, y1 = -1;
+        for (int b = 0; b < FB_BANDS; b++) {
+            if (s_fb_dirty[b].x0 > s_fb_dirty[b].x1) continue;
+            if (y0 < 0) y0 = b * FB_BAND_ROWS;
+            y1 = (b + 1) * FB_BAND_ROWS - 1;
+            if (s_fb_dirty[b].x0 < x0) x0 = s_fb_dirty[b].x0;
+            if (s_fb_dirty[b].x1 > x1) x1 = s_fb_dirty[b].x1;
+        }
+        if (y0 >= 0) {
+            if (y1 >= LCD_HEIGHT) y1 = LCD_HEIGHT - 1;
+            fb_flush_rect(x0, y0, x1, y1);
+        }
+    }
+    fb_clear_dirty();
+}
+
+void display_get_stats(display_stats_t *stats)
+{
+    if (stats) *stats = s_stats;
 }
@@ -17,6 +17,34 @@
 #define DISPLAY_WIDTH   240
 #define DISPLAY_HEIGHT  135
 
+// Buffers (REQ-SW-039): the SPI buffer is static, the screen copy is taken
+// from the heap once by display_init(); build with -DDISPLAY_FRAMEBUFFER=0
+// to drop it and the buffered render modes with it
+#ifndef DISPLAY_FRAMEBUFFER
+#define DISPLAY_FRAMEBUFFER         1
+#endif
+#define DISPLAY_SPI_BUFFER_BYTES    (DISPLAY_WIDTH * 32 * 2)    // 32 rows per transfer
+#define DISPLAY_FRAMEBUFFER_BYTES   (DISPLAY_FRAMEBUFFER ? DISPLAY_WIDTH * DISPLAY_HEIGHT * 2 : 0)
+
+/**
+ * @brief Where drawing goes (REQ-SW-018)
+ */
+typedef enum {
+    DISPLAY_RENDER_IMMEDIATE = 0,   // Straight to the panel, no RAM
+    DISPLAY_RENDER_FRAMEBUFFER,     // Screen copy in RAM, changed area sent per frame
+    DISPLAY_RENDER_BANDED,          // Screen copy in RAM, changed span of each band sent
+    DISPLAY_RENDER_COUNT
+} display_render_mode_t;
+
+/**
+ * @brief SPI bus traffic counters (cumulative since boot)
+ */
+typedef struct {
+    uint32_t bytes;             // Command, parameter and pixel bytes sent
+    uint32_t transactions;      // SPI transactions issued
+    uint32_t busy_us;           // Time spent in SPI transactions
+} display_stats_t;
+
 /**
  * @brief Initialize the display hardware
  * @return ESP_OK on success
@@ -87,6 +115,18 @@ void display_draw_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t colo
 void display_draw_sprite(int16_t x, int16_t y, int16_t w, int16_t h,
                          const uint16_t *data, uint16_t transparent);
 
+/**
+ * @brief Draw an opaque RGB565 bitmap in a single window
+ *
+ * No clipping: the rectangle must lie on screen.
+ * @param x Top-left X coordinate
+ * @param y Top-left Y coordinate
+ * @param w Bitmap width
+ * @param h Bitmap height
+ * @param data Pointer to w*h RGB565 pixels, row-major
+ */
+void display_draw_bitmap(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *data);
+
 /**
  * @brief Draw a sprite with scaling (2x)
  * @param x Top-left X coordinate
@@ -110,6 +150,13 @@ void display_draw_sprite_scaled(int16_t x, int16_t y, int16_t w, int16_t h,
  */
 void display_draw_char(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size);
 
+/**
+ * @brief Replace the 6x8 font used by the text functions
+ * @param glyphs 6 column bytes per glyph for ASCII 32-126 (must stay valid,
+ *               e.g. memory-mapped asset pack), NULL for the built-in font
+ */
+void display_set_font(const uint8_t *glyphs);
+
 /**
  * @brief Draw a string using built-in font
  * @param x Start X coordinate
@@ -145,15 +192,52 @@ void display_set_brightness(uint8_t brightness);
 uint8_t display_get_brightness(void);
 
 /**
- * @brief Start a frame buffer transaction (for double buffering)
+ * @brief Select the render mode, at once
+ *
+ * The buffered modes draw into the 64 KB screen copy allocated by
+ * display_init(); its contents are undefined until the next full repaint,
+ * so switch modes before one. Only from the task that draws, outside a
+ * frame (or before the tasks start); other tasks use
+ * display_request_render_mode().
+ * @return ESP_OK, ESP_ERR_NOT_SUPPORTED for a buffered mode in a build
+ *         without DISPLAY_FRAMEBUFFER, ESP_ERR_NO_MEM if display_init()
+ *         could not allocate the screen copy
+ */
+esp_err_t display_set_render_mode(display_render_mode_t mode);
+
+/**
+ * @brief Ask for a render mode from any task (REQ-SW-037)
+ *
+ * Takes effect at the next display_start_frame(), so a frame being drawn
+ * keeps its screen copy.
+ * @return ESP_OK, ESP_ERR_NOT_SUPPORTED for a buffered mode in a build
+ *         without DISPLAY_FRAMEBUFFER, ESP_ERR_NO_MEM without a screen copy
+ */
+esp_err_t display_request_render_mode(display_render_mode_t mode);
+
+/**
+ * @brief Get the render mode, including one requested but not yet applied
+ */
+display_render_mode_t display_get_render_mode(void);
+
+/**
+ * @brief Start a frame (call before drawing it); applies a requested mode
  */
 void display_start_frame(void);
 
 /**
- * @brief End frame buffer transaction and flush to display
+ * @brief End a frame: in the buffered modes, send what changed to the panel
  */
 void display_end_frame(void);
 
+/**
+ * @brief Read the SPI traffic counters
+ *
+ * Take two readings and subtract to measure a frame or a draw call.
+ * @param stats Output: counters
+ */
+void display_get_stats(display_stats_t *stats);
+
 /**
  * @brief Convert RGB values to RGB565 format
  * @param r Red (0-255)
@@ -0,0 +1,461 @@
+/**
+ * @file catch_game.c
+ * @brief "Catch the Fish" mini-game implementation
+ *
+ * REQ-SW-004: Play Mechanic
+ * REQ-SW-064: Mini-game Plugin Framework (registered as minigame_catch)
+ * REQ-SW-065: Mini-game Leaderboard (reaction time)
+ * Fish are tossed in from the top of the screen. Hold Left or Right to
+ * swim along the surface and catch them before they drop into the water.
+ * The session ends after CATCH_TOTAL fish or CATCH_MISSES_MAX misses.
+ *
+ * Physics runs in fixed MINIGAME_STEP_MS steps on Q8 positions. Each
+ * frame only the union of a moved object's old and new box is composed
+ * into a small buffer and sent as one bitmap.
+ */
+
+#include "minigame.h"
+#include "display.h"
+#include "sprites.h"
+#include "sprite_mask.h"
+#include "sim.h"
+#include "esp_log.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "catch_game";
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define SCREEN_W            240
+#define SCREEN_H            135
+
+#define HUD_H               14
+#define SURFACE_Y           100     // Water line: fish below it are missed
+#define DOLPHIN_Y           (SURFACE_Y - 16)
+#define DOLPHIN_SPRITE      SPRITE_ASSET_BABY_IDLE_1
+#define FISH_SPRITE         SPRITE_ASSET_MG_FISH
+
+#define CATCH_TOTAL         20      // Fish per session
+#define CATCH_MISSES_MAX    3       // Misses that end the session early
+#define CATCH_FISH_MAX      6       // Fish in the air at once
+#define SCORE_FISH          5
+
+// Physics in real units
+#define SWIM_SPEED_PX_S     150
+#define FALL_SPEED_PX_S     40      // First fish
+#define FALL_STEP_PX_S      3       // Added per fish tossed
+#define TOSS_INTERVAL_MS    1400    // First gap between fish
+#define TOSS_STEP_MS        40      // Gap shrinks per fish tossed
+#define TOSS_MIN_MS         500
+#define LEAD_IN_MS          750     // Before the first toss
+#define MAX_CATCHUP_MS      250
+
+#define FP(px)              ((int32_t)(px) * MINIGAME_FP_ONE)
+#define PX(q8)              ((q8) >> MINIGAME_FP_SHIFT)
+#define SPEED_Q8(px_s)      ((int32_t)(((px_s) * MINIGAME_STEP_MS * MINIGAME_FP_ONE + 500) / 1000))
+
+#define RESULT_DISPLAY_MS   1500
+#define COMPOSE_PIXELS      2048    // Compose buffer (4 KB)
+#define FRAME_BUDGET_US     8000
+
+// Colors
+#define COLOR_SKY           0x5D9F  // Light ocean
+#define COLOR_WATER         0x2B4D  // Dark ocean
+#define COLOR_HUD           0x1082
+#define COLOR_TEXT          0xFFFF
+#define COLOR_SUCCESS       0x07E0
+#define COLOR_FAIL          0xF800
+
+//=============================================================================
+// Types
+//=============================================================================
+
+typedef enum {
+    CATCH_STATE_PLAYING,
+    CATCH_STATE_DONE,           // Showing the result
+} catch_state_t;
+
+typedef struct {
+    int16_t x, y, w, h;         // w == 0: empty
+} cg_rect_t;
+
+typedef struct {
+    bool active;
+    int32_t x, y;               // Q8 top-left
+    int32_t vy;                 // Q8 pixels per step
+} cg_fish_t;
+
+typedef struct {
+    catch_state_t state;
+    uint8_t tossed;             // Fish thrown so far
+    uint8_t caught;
+    uint8_t misses;
+    uint16_t score;
+
+    int32_t dolphin_x;          // Q8 left edge
+    bool swim_left, swim_right; // Buttons held
+    cg_fish_t fish[CATCH_FISH_MAX];
+
+    uint32_t accum_ms;          // Time not yet simulated
+    uint32_t toss_ms;           // Time until the next toss
+    uint32_t steps;             // Physics steps this session
+
+    // Reaction: from a toss to the first swim press after it
+    bool toss_waiting;
+    uint32_t toss_step;
+    uint16_t best_reaction_ms;  // 0 = none
+    uint32_t result_time_ms;
+
+    // What is on screen (not published: owned by the render copy)
+    bool full;
+    catch_state_t drawn_state;
+    uint8_t drawn_caught, drawn_misses;
+    cg_rect_t drawn_dolphin;
+    cg_rect_t drawn_fish[CATCH_FISH_MAX];
+
+    uint16_t compose[COMPOSE_PIXELS];
+} catch_ctx_t;
+
+_Static_assert(sizeof(catch_ctx_t) <= MINIGAME_ARENA_SIZE, "catch game does not fit the arena");
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+static catch_ctx_t *s_catch;    // Arena state while the game runs (simulation task)
+static catch_ctx_t *s_draw;     // Published copy being drawn (render task)
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+static inline uint32_t get_ms(void)
+{
+    return sim_now_ms();  // Simulated time, see sim.h
+}
+
+static cg_rect_t rect_clip(int x, int y, int w, int h)
+{
+    cg_rect_t r = {0};
+    int x1 = x + w, y1 = y + h;
+    if (x < 0) x = 0;
+    if (y < HUD_H) y = HUD_H;
+    if (x1 > SCREEN_W) x1 = SCREEN_W;
+    if (y1 > SCREEN_H) y1 = SCREEN_H;
+    if (x1 > x && y1 > y) {
+        r.x = x; r.y = y; r.w = x1 - x; r.h = y1 - y;
+    }
+    return r;
+}
+
+static bool rect_overlaps(const cg_rect_t *a, const cg_rect_t *b)
+{
+    return a->w && b->w &&
+           a->x < b->x + b->w && b->x < a->x + a->w &&
+           a->y < b->y + b->h && b->y < a->y + a->h;
+}
+
+static cg_rect_t rect_union(const cg_rect_t *a, const cg_rect_t *b)
+{
+    if (!a->w) return *b;
+    if (!b->w) return *a;
+    int x0 = (a->x < b->x) ? a->x : b->x;
+    int y0 = (a->y < b->y) ? a->y : b->y;
+    int x1 = (a->x + a->w > b->x + b->w) ? a->x + a->w : b->x + b->w;
+    int y1 = (a->y + a->h > b->y + b->h) ? a->y + a->h : b->y + b->h;
+    return rect_clip(x0, y0, x1 - x0, y1 - y0);
+}
+
+static cg_rect_t dolphin_box(void)
+{
+    return rect_clip(PX(s_draw->dolphin_x), DOLPHIN_Y, DOLPHIN_BABY_W, DOLPHIN_BABY_H);
+}
+
+static cg_rect_t fish_box(int i)
+{
+    const cg_fish_t *f = &s_draw->fish[i];
+    if (!f->active) return (cg_rect_t){0};
+    return rect_clip(PX(f->x), PX(f->y), FOOD_FISH_W, FOOD_FISH_H);
+}
+
+static void finish(void)
+{
+    s_catch->state = CATCH_STATE_DONE;
+    s_catch->result_time_ms = get_ms();
+    ESP_LOGI(TAG, "Caught %d/%d, %d missed", s_catch->caught, s_catch->tossed, s_catch->misses);
+}
+
+static void toss_fish(void)
+{
+    for (int i = 0; i < CATCH_FISH_MAX; i++) {
+        cg_fish_t *f = &s_catch->fish[i];
+        if (f->active) continue;
+
+        f->active = true;
+        f->x = FP(sim_random() % (SCREEN_W - FOOD_FISH_W));
+        f->y = FP(HUD_H);
+        f->vy = SPEED_Q8(FALL_SPEED_PX_S + FALL_STEP_PX_S * s_catch->tossed);
+        s_catch->tossed++;
+        s_catch->toss_waiting = true;
+        s_catch->toss_step = s_catch->steps;
+
+        int interval = TOSS_INTERVAL_MS - TOSS_STEP_MS * s_catch->tossed;
+        s_catch->toss_ms = (interval < TOSS_MIN_MS) ? TOSS_MIN_MS : interval;
+        return;
+    }
+}
+
+/**
+ * @brief Advance physics by one fixed step
+ */
+static void physics_step(void)
+{
+    s_catch->steps++;
+
+    // Dolphin follows the held buttons
+    int dir = (int)s_catch->swim_right - (int)s_catch->swim_left;
+    s_catch->dolphin_x += dir * SPEED_Q8(SWIM_SPEED_PX_S);
+    if (s_catch->dolphin_x < 0) s_catch->dolphin_x = 0;
+    if (s_catch->dolphin_x > FP(SCREEN_W - DOLPHIN_BABY_W)) {
+        s_catch->dolphin_x = FP(SCREEN_W - DOLPHIN_BABY_W);
+    }
+
+    // Next toss
+    if (s_catch->tossed < CATCH_TOTAL) {
+        if (s_catch->toss_ms > MINIGAME_STEP_MS) {
+            s_catch->toss_ms -= MINIGAME_STEP_MS;
+        } else {
+            toss_fish();
+        }
+    }
+
+    // Falling fish: caught on touch, missed once in the water
+    const sprite_mask_t *dolphin = sprite_mask_get(DOLPHIN_SPRITE);
+    const sprite_mask_t *fish = sprite_mask_get(FISH_SPRITE);
+    bool airborne = false;
+
+    for (int i = 0; i < CATCH_FISH_MAX; i++) {
+        cg_fish_t *f = &s_catch->fish[i];
+        if (!f->active) continue;
+        f->y += f->vy;
+
+        if (sprite_mask_overlap(dolphin, PX(s_catch->dolphin_x), DOLPHIN_Y,
+                                fish, PX(f->x), PX(f->y))) {
+            f->active = false;
+            s_catch->caught++;
+            s_catch->score += SCORE_FISH;
+        } else if (PX(f->y) >= SURFACE_Y) {
+            f->active = false;
+            s_catch->misses++;
+        } else {
+            airborne = true;
+        }
+    }
+
+    if (s_catch->misses >= CATCH_MISSES_MAX ||
+        (s_catch->tossed >= CATCH_TOTAL && !airborne)) {
+        finish();
+    }
+}
+
+//=============================================================================
+// Rendering Functions
+//=============================================================================
+
+static void blit(const cg_rect_t *r, const uint16_t *sprite, int x, int y, int w, int h)
+{
+    int xa = (x > r->x) ? x : r->x;
+    int xb = (x + w < r->x + r->w) ? x + w : r->x + r->w;
+    int ya = (y > r->y) ? y : r->y;
+    int yb = (y + h < r->y + r->h) ? y + h : r->y + r->h;
+
+    for (int yy = ya; yy < yb; yy++) {
+        const uint16_t *src = &sprite[(yy - y) * w];
+        uint16_t *row = &s_draw->compose[(yy - r->y) * r->w];
+        for (int xx = xa; xx < xb; xx++) {
+            uint16_t pixel = src[xx - x];
+            if (pixel != SPRITE_TRANSPARENT) row[xx - r->x] = pixel;
+        }
+    }
+}
+
+/**
+ * @brief Compose sky, water, fish and dolphin inside r and send it
+ */
+static void compose_rect(const cg_rect_t *r)
+{
+    int rows = COMPOSE_PIXELS / r->w;
+    const uint16_t *dolphin = sprites_get(DOLPHIN_SPRITE, NULL, NULL);
+    const uint16_t *fish = sprites_get(FISH_SPRITE, NULL, NULL);
+
+    for (int y0 = r->y; y0 < r->y + r->h; y0 += rows) {
+        int n = (r->y + r->h - y0 < rows) ? r->y + r->h - y0 : rows;
+        cg_rect_t strip = { r->x, y0, r->w, n };
+
+        for (int y = y0; y < y0 + n; y++) {
+            uint16_t color = (y < SURFACE_Y) ? COLOR_SKY : COLOR_WATER;
+            uint16_t *row = &s_draw->compose[(y - y0) * r->w];
+            for (int i = 0; i < r->w; i++) row[i] = color;
+        }
+
+        cg_rect_t box = dolphin_box();
+        if (rect_overlaps(&box, &strip)) {
+            blit(&strip, dolphin, PX(s_draw->dolphin_x), DOLPHIN_Y, DOLPHIN_BABY_W, DOLPHIN_BABY_H);
+        }
+        for (int i = 0; i < CATCH_FISH_MAX; i++) {
+            box = fish_box(i);
+            if (rect_overlaps(&box, &strip)) {
+                blit(&strip, fish, PX(s_draw->fish[i].x), PX(s_draw->fish[i].y),
+                     FOOD_FISH_W, FOOD_FISH_H);
+            }
+        }
+
+        display_draw_bitmap(strip.x, strip.y, strip.w, strip.h, s_draw->compose);
+    }
+}
+
+static void draw_hud(void)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "Caught %2d/%d   Missed %d/%d",
+             s_draw->caught, CATCH_TOTAL, s_draw->misses, CATCH_MISSES_MAX);
+    display_draw_string(5, 3, buf, COLOR_TEXT, COLOR_HUD, 1);
+}
+
+static void render_full(void)
+{
+    display_fill_rect(0, 0, SCREEN_W, HUD_H, COLOR_HUD);
+    draw_hud();
+
+    cg_rect_t play = { 0, HUD_H, SCREEN_W, SCREEN_H - HUD_H };
+    compose_rect(&play);
+
+    if (s_draw->state == CATCH_STATE_DONE) {
+        bool won = s_draw->misses < CATCH_MISSES_MAX;
+        display_draw_string(70, 50, won ? "YUMMY!" : "OOPS!",
+                            won ? COLOR_SUCCESS : COLOR_FAIL, COLOR_SKY, 2);
+    } else {
+        display_draw_string(40, SCREEN_H - 15, "Hold L / R to swim", COLOR_TEXT, COLOR_WATER, 1);
+    }
+}
+
+static void render_incremental(void)
+{
+    cg_rect_t box = dolphin_box();
+    if (memcmp(&box, &s_draw->drawn_dolphin, sizeof(box)) != 0) {
+        cg_rect_t dirty = rect_union(&box, &s_draw->drawn_dolphin);
+        compose_rect(&dirty);
+    }
+
+    for (int i = 0; i < CATCH_FISH_MAX; i++) {
+        box = fish_box(i);
+        if (memcmp(&box, &s_draw->drawn_fish[i], sizeof(box)) != 0) {
+            cg_rect_t dirty = rect_union(&box, &s_draw->drawn_fish[i]);
+            if (dirty.w) compose_rect(&dirty);
+        }
+    }
+
+    if (s_draw->caught != s_draw->drawn_caught || s_draw->misses != s_draw->drawn_misses) {
+        draw_hud();
+    }
+}
+
+//=============================================================================
+// Lifecycle Handlers
+//=============================================================================
+
+static void catch_init(void *state)
+{
+    s_catch = state;
+    s_catch->state = CATCH_STATE_PLAYING;
+    s_catch->dolphin_x = FP((SCREEN_W - DOLPHIN_BABY_W) / 2);
+    s_catch->toss_ms = LEAD_IN_MS;
+    s_catch->full = true;
+}
+
+static bool catch_update(void *state, uint32_t delta_ms)
+{
+    s_catch = state;
+
+    if (s_catch->state == CATCH_STATE_DONE) {
+        return get_ms() - s_catch->result_time_ms <= RESULT_DISPLAY_MS;
+    }
+
+    s_catch->accum_ms += (delta_ms > MAX_CATCHUP_MS) ? MAX_CATCHUP_MS : delta_ms;
+    while (s_catch->accum_ms >= MINIGAME_STEP_MS && s_catch->state == CATCH_STATE_PLAYING) {
+        s_catch->accum_ms -= MINIGAME_STEP_MS;
+        physics_step();
+    }
+    return true;
+}
+
+static void catch_input(void *state, button_id_t button, button_event_t event)
+{
+    s_catch = state;
+
+    if (event != BUTTON_EVENT_PRESSED && event != BUTTON_EVENT_RELEASED) return;
+    bool held = (event == BUTTON_EVENT_PRESSED);
+    if (held && s_catch->toss_waiting && s_catch->state == CATCH_STATE_PLAYING &&
+        (button == BUTTON_LEFT || button == BUTTON_RIGHT)) {
+        // Input lands between steps: round up to the next one
+        uint16_t ms = (uint16_t)((s_catch->steps - s_catch->toss_step + 1) * MINIGAME_STEP_MS);
+        if (s_catch->best_reaction_ms == 0 || ms < s_catch->best_reaction_ms) {
+            s_catch->best_reaction_ms = ms;
+        }
+        s_catch->toss_waiting = false;
+    }
+
+    if (button == BUTTON_LEFT) {
+        s_catch->swim_left = held;
+    } else if (button == BUTTON_RIGHT) {
+        s_catch->swim_right = held;
+    }
+}
+
+static void catch_render(void *state)
+{
+    s_draw = state;
+
+    if (s_draw->full || s_draw->state != s_draw->drawn_state) {
+        render_full();
+    } else {
+        render_incremental();
+    }
+
+    s_draw->full = false;
+    s_draw->drawn_state = s_draw->state;
+    s_draw->drawn_caught = s_draw->caught;
+    s_draw->drawn_misses = s_draw->misses;
+    s_draw->drawn_dolphin = dolphin_box();
+    for (int i = 0; i < CATCH_FISH_MAX; i++) {
+        s_draw->drawn_fish[i] = fish_box(i);
+    }
+}
+
+static void catch_result(const void *state, minigame_result_t *result)
+{
+    const catch_ctx_t *ctx = state;
+    result->won = ctx->misses < CATCH_MISSES_MAX;
+    result->score = ctx->score;
+    result->reaction_ms = ctx->best_reaction_ms;
+}
+
+//=============================================================================
+// Registration
+//=============================================================================
+
+const minigame_vtable_t minigame_catch = {
+    .name = "CATCH",
+    .state_size = sizeof(catch_ctx_t),
+    .model_size = offsetof(catch_ctx_t, full),
+    .frame_budget_us = FRAME_BUDGET_US,
+    .init = catch_init,
+    .update = catch_update,
+    .render = catch_render,
+    .input = catch_input,
+    .result = catch_result,
+};
@@ -4,15 +4,40 @@
  *
  * REQ-SW-010: Main Display
  * REQ-SW-011: Menu System
+ * REQ-SW-017: Button Gestures
+ * REQ-SW-018: Settings Screen
+ * REQ-SW-035: Table-driven Screen States
+ * REQ-SW-036: UI Widgets (menus and stats screen)
+ * REQ-SW-065: Mini-game Leaderboard (results screen)
+ * REQ-SW-039: Static Memory Budget (pet background cache)
+ * REQ-SW-037: Multi-task Runtime (frame view)
+ * Every screen is a row in s_states: enter/exit/update/render/input
+ * handlers, a redraw policy and its gesture bindings. change_state() runs
+ * the exit and enter handlers and then the transition hooks. Update and
+ * render time is accumulated per state.
+ *
+ * Update and input handlers run on the simulation task. Render handlers
+ * run on the render task and read only s_frame, the view copied by
+ * game_publish_frame(), plus render-side caches (scene view, pet cache,
+ * widget screens), so the simulation keeps ticking while a frame is drawn.
  */
 
 #include "game.h"
 #include "minigame.h"
+#include "leaderboard.h"
+#include "settings.h"
+#include "ui.h"
+#include "replay.h"
 #include "display.h"
 #include "pet.h"
+#include "pet_history.h"
 #include "sprites.h"
+#include "latency.h"
+#include "trace.h"
+#include "sim.h"
 #include "esp_timer.h"
 #include "esp_log.h"
+#include <stdlib.h>
 #include <string.h>
 
 static const char *TAG = "game";
@@ -46,27 +71,171 @@ static const char *TAG = "game";
 
 #define PET_CENTER_X        (SCREEN_W / 2)
 #define PET_CENTER_Y        (SCREEN_H / 2 + 10)
+#define PET_SCALE           2
+#define SCENE_SPLIT_Y       (SCREEN_H / 2)  // Light ocean above, dark below
 
 #define MENU_X              10
 #define MENU_Y              25
 #define MENU_ITEM_H         18
 #define MENU_COLS           4
 #define MENU_ROWS           2
+#define MENU_PANEL_X        10
+#define MENU_PANEL_Y        35
+#define MENU_PANEL_W        (SCREEN_W - 20)
+#define MENU_PANEL_H        60
+
+#define FOOD_PANEL_W        100
+#define FOOD_PANEL_H        70
+#define FOOD_PANEL_X        ((SCREEN_W - FOOD_PANEL_W) / 2)
+#define FOOD_PANEL_Y        ((SCREEN_H - FOOD_PANEL_H) / 2)
+
+#define GAMES_PANEL_W       100
+#define GAMES_PANEL_H       (24 + (MINIGAME_COUNT + 1) * 16)
+#define GAMES_PANEL_X       ((SCREEN_W - GAMES_PANEL_W) / 2)
+#define GAMES_PANEL_Y       ((SCREEN_H - GAMES_PANEL_H) / 2)
+
+#define RESULTS_X           30
+#define RESULTS_Y           40
+#define RESULTS_LINE_H      14
+
+#define SETTINGS_X          20
+#define SETTINGS_Y          24
+#define SETTINGS_ROW_H      13
+#define SETTINGS_ROW_W      (SCREEN_W - 2 * SETTINGS_X + 8)
+#define SETTINGS_VALUE_X    130
+
+#define STATS_ROW_Y         40
+#define STATS_ROW_H         18
+#define STATS_BAR_X         78
+#define STATS_BAR_W         90
+#define STATS_VALUE_X       (STATS_BAR_X + STATS_BAR_W + 6)
+
+#define GRAPH_X             70
+#define GRAPH_Y             24
+#define GRAPH_W             PET_HISTORY_BUCKETS
+#define GRAPH_H             20
+#define GRAPH_SPACING       26
+#define GRAPH_24H_MIN       (24 * 60)
+#define GRAPH_7D_MIN        (7 * 24 * 60)
+
+
+//=============================================================================
+// Types
+//=============================================================================
+
+typedef enum {
+    REDRAW_EVERY_FRAME,         // render runs every frame and draws what changed
+    REDRAW_ON_CHANGE,           // render runs on entry and after handled input
+} redraw_policy_t;
+
+typedef struct {
+    const char *name;
+    redraw_policy_t redraw;
+    bool raw_input;             // input sees every event (presses, releases)
+    uint32_t gestures;          // Gesture shortcuts bound while active
+    void (*enter)(game_state_t from);
+    void (*exit)(game_state_t to);
+    void (*update)(uint32_t delta_ms);
+    void (*render)(void);
+    void (*input)(button_id_t button, button_event_t event);
+} state_desc_t;
+
+// What the main scene currently shows
+typedef struct {
+    uint8_t stats[4];           // Hunger, happiness, health, energy
+    bool attention;             // Flashing icon visible
+    bool poop;
+    uint8_t stage;
+    uint32_t age_days;
+    uint32_t frame;             // Animation frame
+} main_view_t;
+
+// Background behind the pet sprite, built on the frame entering the scene
+typedef struct {
+    uint16_t *bg;               // Sprite size x PET_SCALE (NULL: not built)
+    uint16_t *compose;          // Same size, follows bg in s_pet_cache_mem
+    int sprite_w, sprite_h;     // Unscaled sprite size it was built for
+    int x, y;
+} pet_cache_t;
+
+// Everything the render handlers draw, copied from the simulation side
+// when a frame is handed over
+typedef struct {
+    game_state_t state;
+    bool repaint;                   // Paint the whole screen
+    bool dirty;                     // Content of an on-change state changed
+    uint8_t menu_selection;
+    uint8_t food_selection;
+    uint8_t game_selection;
+    uint8_t settings_selection;
+    uint8_t stats_page;
+    uint32_t animation_frame;
+    bool attention_flash;
+    pet_state_t pet;
+    uint32_t history_generation;    // Stats graph pages: level drawn from
+    uint8_t history_columns;        // Columns the page's window spans
+    uint8_t history_count;          // Buckets copied, newest first
+    pet_history_bucket_t history[PET_HISTORY_STAT_COUNT][GRAPH_W];
+    minigame_id_t game;             // Last game started
+    minigame_result_t result;       // Results screen
+    uint8_t records;
+    leaderboard_entry_t entry;
+    char settings_values[SETTINGS_ITEM_COUNT][16];  // Settings screen
+} game_frame_t;
+_Static_assert(GRAPH_W <= UINT8_MAX, "history columns do not fit the frame");
+
+typedef struct {
+    uint32_t updates;
+    uint64_t update_us;
+    uint32_t renders;
+    uint64_t render_us;
+    uint32_t render_max_us;
+} state_profile_t;
 
 //=============================================================================
 // Static State
 //=============================================================================
 
+static const state_desc_t s_states[GAME_STATE_COUNT];
+
 static game_state_t s_state = GAME_STATE_SPLASH;
 static uint32_t s_state_time_ms = 0;
 static uint8_t s_menu_selection = 0;
 static uint8_t s_food_selection = 0;
+static uint8_t s_game_selection = MINIGAME_WAVE;    // MINIGAME_COUNT = back
+static uint8_t s_settings_selection = 0;            // SETTINGS_ITEM_COUNT = back
 static uint32_t s_animation_frame = 0;
 static uint32_t s_animation_timer = 0;
 static uint32_t s_last_update_ms = 0;
 static bool s_attention_flash = false;
 static uint32_t s_flash_timer = 0;
 
+// Redraw: s_repaint is set on entering a state (paint the whole screen),
+// s_dirty when the state's content changed; both move into the next frame
+static bool s_repaint = true;
+static bool s_dirty = false;
+static display_render_mode_t s_render_mode;     // Mode the screen was painted in
+
+// Stats screen: page 0 = current values, then one page per trend window
+static uint8_t s_stats_page = 0;
+static uint32_t s_stats_generation = 0;
+
+// Results screen: last finished session
+static minigame_result_t s_last_result;
+static uint8_t s_last_records = 0;              // LEADERBOARD_NEW_* flags
+
+// Render side
+static game_frame_t s_frame;
+static main_view_t s_main_view;
+static pet_cache_t s_pet_cache;
+
+#define PET_CACHE_PIXELS    (DOLPHIN_ADULT_W * PET_SCALE * DOLPHIN_ADULT_H * PET_SCALE)
+static uint16_t s_pet_cache_mem[2 * PET_CACHE_PIXELS];
+_Static_assert(sizeof(s_pet_cache_mem) == GAME_PET_CACHE_BYTES, "pet cache outside its budget");
+
+static state_profile_t s_profile[GAME_STATE_COUNT];
+static game_transition_hook_t s_hooks[GAME_TRANSITION_HOOKS_MAX];
+
 // Menu item labels
 static const char *s_menu_labels[] = {
     "FEED", "PLAY", "SLEEP", "CLEAN", "MED", "STATS", "SET"
@@ -76,20 +245,192 @@ static const char *s_food_labels[] = {
     "FISH", "SHRIMP", "BACK"
 };
 
+typedef struct {
+    const char *title;
+    uint32_t window_min;
+} stats_page_t;
+
+static const stats_page_t s_stats_pages[] = {
+    { "PET STATS",  0 },
+    { "TRENDS 24H", GRAPH_24H_MIN },
+    { "TRENDS 7D",  GRAPH_7D_MIN },
+};
+
+#define STATS_PAGE_COUNT    (sizeof(s_stats_pages) / sizeof(s_stats_pages[0]))
+
+static const char *s_history_labels[PET_HISTORY_STAT_COUNT] = {
+    "Hunger", "Happy", "Health", "Energy"
+};
+
+static const char *s_game_labels[MINIGAME_COUNT + 1];  // Filled by game_init()
+
+//=============================================================================
+// Widget Screens
+//=============================================================================
+
+enum { MENU_W_PANEL, MENU_W_GRID, MENU_W_HINT, MENU_W_COUNT };
+
+static const ui_widget_def_t s_menu_widgets[MENU_W_COUNT] = {
+    [MENU_W_PANEL] = {
+        .type = UI_PANEL, .x = MENU_PANEL_X, .y = MENU_PANEL_Y, .w = MENU_PANEL_W, .h = MENU_PANEL_H,
+        .fg = COLOR_WHITE, .bg = COLOR_MENU_BG,
+    },
+    [MENU_W_GRID] = {
+        .type = UI_GRID, .x = MENU_PANEL_X + 10, .y = MENU_PANEL_Y + 8,
+        .w = MENU_PANEL_W - 20, .h = MENU_ROWS * 24,
+        .fg = COLOR_WHITE, .bg = COLOR_MENU_BG, .sel_fg = COLOR_BLACK, .sel_bg = COLOR_MENU_SELECT,
+        .items = s_menu_labels, .count = MENU_COUNT, .cols = MENU_COLS,
+        .item_h = 24, .gap = 4, .pad_x = 4, .pad_y = 6,
+    },
+    [MENU_W_HINT] = {
+        .type = UI_LABEL, .x = MENU_PANEL_X + 5, .y = MENU_PANEL_Y + MENU_PANEL_H + 5,
+        .fg = COLOR_TEXT_DIM, .bg = COLOR_BG, .text = "L:Select  R:Confirm",
+    },
+};
+
+// Food and game pickers: titled list in a panel
+enum { PICKER_W_PANEL, PICKER_W_TITLE, PICKER_W_LIST, PICKER_W_COUNT };
+
+#define PICKER_WIDGETS(px, py, pw, ph, title, labels, n) { \
+    [PICKER_W_PANEL] = { \
+        .type = UI_PANEL, .x = (px), .y = (py), .w = (pw), .h = (ph), \
+        .fg = COLOR_WHITE, .bg = COLOR_MENU_BG, \
+    }, \
+    [PICKER_W_TITLE] = { \
+        .type = UI_LABEL, .x = (px) + 20, .y = (py) + 5, \
+        .fg = COLOR_WHITE, .bg = COLOR_MENU_BG, .text = (title), \
+    }, \
+    [PICKER_W_LIST] = { \
+        .type = UI_LIST, .x = (px) + 10, .y = (py) + 20, .w = (pw) - 18, .h = (n) * 16, \
+        .fg = COLOR_WHITE, .bg = COLOR_MENU_BG, .sel_fg = COLOR_BLACK, .sel_bg = COLOR_MENU_SELECT, \
+        .items = (labels), .count = (n), .item_h = 16, .gap = 2, .pad_x = 10, .pad_y = 3, \
+    }, \
+}
+
+static const ui_widget_def_t s_food_widgets[PICKER_W_COUNT] =
+    PICKER_WIDGETS(FOOD_PANEL_X, FOOD_PANEL_Y, FOOD_PANEL_W, FOOD_PANEL_H,
+                   "FEED", s_food_labels, FOOD_MENU_COUNT);
+
+static const ui_widget_def_t s_games_widgets[PICKER_W_COUNT] =
+    PICKER_WIDGETS(GAMES_PANEL_X, GAMES_PANEL_Y, GAMES_PANEL_W, GAMES_PANEL_H,
+                   "PLAY", s_game_labels, MINIGAME_COUNT + 1);
+
+// Stats screen frame (all pages) and the values page
+enum { STATS_W_PANEL, STATS_W_TITLE, STATS_W_RULE, STATS_W_HINT, STATS_W_FRAME_COUNT };
+
+static const ui_widget_def_t s_stats_frame_widgets[STATS_W_FRAME_COUNT] = {
+    [STATS_W_PANEL] = {
+        .type = UI_PANEL, .w = SCREEN_W, .h = SCREEN_H, .fg = COLOR_MENU_BG, .bg = COLOR_MENU_BG,
+    },
+    [STATS_W_TITLE] = {
+        .type = UI_LABEL, .x = 80, .y = 5, .fg = COLOR_WHITE, .bg = COLOR_MENU_BG,
+    },
+    [STATS_W_RULE] = {
+        .type = UI_PANEL, .x = 10, .y = 18, .w = SCREEN_W - 20, .h = 1,
+        .fg = COLOR_WHITE, .bg = COLOR_WHITE,
+    },
+    [STATS_W_HINT] = {
+        .type = UI_LABEL, .x = 60, .y = SCREEN_H - 12,
+        .fg = COLOR_TEXT_DIM, .bg = COLOR_MENU_BG, .text = "L:Next  R:Back",
+    },
+};
+
+enum {
+    STATS_W_STAGE,
+    STATS_W_AGE,
+    STATS_W_ICON,                                       // One per core stat
+    STATS_W_NAME = STATS_W_ICON + PET_HISTORY_STAT_COUNT,
+    STATS_W_BAR = STATS_W_NAME + PET_HISTORY_STAT_COUNT,
+    STATS_W_VALUE = STATS_W_BAR + PET_HISTORY_STAT_COUNT,
+    STATS_W_TOTALS = STATS_W_VALUE + PET_HISTORY_STAT_COUNT,
+    STATS_W_VALUES_COUNT
+};
+
+#define STATS_ROW(i, name) \
+    [STATS_W_ICON + (i)] = { \
+        .type = UI_ICON, .x = 10, .y = STATS_ROW_Y + (i) * STATS_ROW_H, \
+        .w = ICON_SIZE, .h = ICON_SIZE, .bg = COLOR_MENU_BG, \
+    }, \
+    [STATS_W_NAME + (i)] = { \
+        .type = UI_LABEL, .x = 30, .y = STATS_ROW_Y + (i) * STATS_ROW_H + 4, \
+        .fg = COLOR_WHITE, .bg = COLOR_MENU_BG, .text = (name), \
+    }, \
+    [STATS_W_BAR + (i)] = { \
+        .type = UI_BAR, .x = STATS_BAR_X, .y = STATS_ROW_Y + (i) * STATS_ROW_H + 5, \
+        .w = STATS_BAR_W, .h = 6, .fg = COLOR_GOOD, .bg = COLOR_BLACK, \
+    }, \
+    [STATS_W_VALUE + (i)] = { \
+        .type = UI_LABEL, .x = STATS_VALUE_X, .y = STATS_ROW_Y + (i) * STATS_ROW_H + 4, \
+        .w = 4 * UI_CHAR_W, .fg = COLOR_WHITE, .bg = COLOR_MENU_BG, \
+    }
+
+static const ui_widget_def_t s_stats_values_widgets[STATS_W_VALUES_COUNT] = {
+    [STATS_W_STAGE] = {
+        .type = UI_LABEL, .x = 10, .y = 24, .w = 100, .fg = COLOR_WHITE, .bg = COLOR_MENU_BG,
+    },
+    [STATS_W_AGE] = {
+        .type = UI_LABEL, .x = 130, .y = 24, .w = 100, .fg = COLOR_WHITE, .bg = COLOR_MENU_BG,
+    },
+    STATS_ROW(0, "Hunger"),
+    STATS_ROW(1, "Happy"),
+    STATS_ROW(2, "Health"),
+    STATS_ROW(3, "Energy"),
+    [STATS_W_TOTALS] = {
+        .type = UI_LABEL, .x = 10, .y = STATS_ROW_Y + PET_HISTORY_STAT_COUNT * STATS_ROW_H,
+        .w = SCREEN_W - 20, .fg = COLOR_WHITE, .bg = COLOR_MENU_BG,
+    },
+};
+
+_Static_assert(PET_HISTORY_STAT_COUNT == 4, "stats screen declares one row per core stat");
+
+static ui_screen_t s_menu_screen;
+static ui_screen_t s_food_screen;
+static ui_screen_t s_games_screen;
+static ui_screen_t s_stats_frame;
+static ui_screen_t s_stats_values;
+
+// Gesture shortcuts bound per state (unbound states keep single-click latency)
+#define GESTURE(g, b)       INPUT_GESTURE_BIT(INPUT_GESTURE_##g, BUTTON_##b)
+
 //=============================================================================
 // Helper Functions
 //=============================================================================
 
 static inline uint32_t get_ms(void)
 {
-    return (uint32_t)(esp_timer_get_time() / 1000);
+    return sim_now_ms();  // Simulated time, see sim.h
 }
 
 static void change_state(game_state_t new_state)
 {
-    ESP_LOGI(TAG, "State change: %d -> %d", s_state, new_state);
+    game_state_t old_state = s_state;
+    ESP_LOGI(TAG, "State change: %s -> %s", s_states[old_state].name, s_states[new_state].name);
+
+    if (s_states[old_state].exit) s_states[old_state].exit(new_state);
+
     s_state = new_state;
     s_state_time_ms = get_ms();
+    s_repaint = true;
+    input_set_gestures(s_states[new_state].gestures);
+    latency_mark_region(0, 0, SCREEN_W, SCREEN_H);
+
+    if (s_states[new_state].enter) s_states[new_state].enter(old_state);
+
+    for (int i = 0; i < GAME_TRANSITION_HOOKS_MAX && s_hooks[i]; i++) {
+        s_hooks[i](old_state, new_state);
+    }
+}
+
+static void start_play(minigame_id_t id)
+{
+    if (pet_play_start() && minigame_start(id)) {
+        change_state(GAME_STATE_PLAY);
+    }
+}
+
+static inline uint32_t frame_age_days(void)
+{
+    return s_frame.pet.age_minutes / (24 * 60);
 }
 
 //=============================================================================
@@ -98,7 +439,8 @@ static void change_state(game_state_t new_state)
 
 static void render_status_bar(void)
 {
-    const pet_state_t *pet = pet_get_state();
+    TRACE_ZONE("render_status_bar");
+    const pet_state_t *pet = &s_frame.pet;
 
     // Background bar
     display_fill_rect(0, 0, SCREEN_W, STATUS_BAR_H, COLOR_MENU_BG);
@@ -152,31 +494,32 @@ static void render_status_bar(void)
     display_fill_rect(bar_x, bar_y, fill, bar_h, energy_color);
 
     // Attention indicator (flashing exclamation)
-    if (pet->attention_needed && s_attention_flash) {
+    if (pet->attention_needed && s_frame.attention_flash) {
         display_draw_sprite(SCREEN_W - 20, y, ICON_SIZE, ICON_SIZE,
-                           icon_attention, SPRITE_TRANSPARENT);
+                           sprites_get(SPRITE_ASSET_ICON_ATTENTION, NULL, NULL),
+                           SPRITE_TRANSPARENT);
     }
 }
 
 static void render_pet(void)
 {
-    const pet_state_t *pet = pet_get_state();
+    TRACE_ZONE("render_pet");
     int w, h;
 
     const uint16_t *sprite = sprites_get_idle_frame(
-        pet->stage, s_animation_frame, &w, &h);
+        s_frame.pet.stage, s_frame.animation_frame, &w, &h);
 
     int x = PET_CENTER_X - w / 2;
     int y = PET_CENTER_Y - h / 2;
 
     // Scale up for better visibility
-    display_draw_sprite_scaled(x, y, w, h, sprite, SPRITE_TRANSPARENT, 2);
+    display_draw_sprite_scaled(x, y, w, h, sprite, SPRITE_TRANSPARENT, PET_SCALE);
 }
 
 static void render_poop_indicator(void)
 {
-    const pet_state_t *pet = pet_get_state();
-    if (pet->has_poop) {
+    TRACE_ZONE("render_poop_indicator");
+    if (s_frame.pet.has_poop) {
         // Draw poop icon in corner
         display_draw_string(SCREEN_W - 30, SCREEN_H - 20, "POO", COLOR_CRITICAL, COLOR_BG, 1);
     }
@@ -184,25 +527,37 @@ static void render_poop_indicator(void)
 
 static void render_age_display(void)
 {
+    TRACE_ZONE("render_age_display");
     char buf[16];
-    snprintf(buf, sizeof(buf), "%s %lud", pet_get_stage_name(), (unsigned long)pet_get_age_days());
+    snprintf(buf, sizeof(buf), "%s %lud", pet_stage_name(s_frame.pet.stage), (unsigned long)frame_age_days());
     display_draw_string(4, SCREEN_H - 12, buf, COLOR_TEXT_DIM, COLOR_BG, 1);
 }
 
 static void render_splash(void)
 {
+    TRACE_ZONE("render_splash");
     display_fill(COLOR_BG);
     display_draw_string(50, 40, "DOLPHIN PET", COLOR_WHITE, COLOR_BG, 2);
     display_draw_string(60, 80, "Press any button", COLOR_TEXT_DIM, COLOR_BG, 1);
 }
 
+/**
+ * @brief Fill part of the ocean background (light upper, dark lower half)
+ */
+static void fill_scene_rect(int x, int y, int w, int h)
+{
+    int split = y + h;
+    if (split > SCENE_SPLIT_Y) split = (y > SCENE_SPLIT_Y) ? y : SCENE_SPLIT_Y;
+    if (split > y) display_fill_rect(x, y, w, split - y, COLOR_BG_LIGHT);
+    if (y + h > split) display_fill_rect(x, split, w, y + h - split, COLOR_BG);
+}
+
 static void render_main(void)
 {
+    TRACE_ZONE("render_main");
     // Ocean gradient background - use two rectangles instead of line-by-line
     // This reduces SPI transactions and eliminates flickering
-    int mid_y = SCREEN_H / 2;
-    display_fill_rect(0, STATUS_BAR_H, SCREEN_W, mid_y - STATUS_BAR_H, COLOR_BG_LIGHT);
-    display_fill_rect(0, mid_y, SCREEN_W, SCREEN_H - mid_y, COLOR_BG);
+    fill_scene_rect(0, STATUS_BAR_H, SCREEN_W, SCREEN_H - STATUS_BAR_H);
 
     render_status_bar();
     render_pet();
@@ -210,133 +565,691 @@ static void render_main(void)
     render_age_display();
 }
 
-static void render_menu(void)
+static void pet_cache_free(void)
 {
-    // Darken background
-    render_main();
+    memset(&s_pet_cache, 0, sizeof(s_pet_cache));
+}
 
-    // Menu panel
-    int menu_w = SCREEN_W - 20;
-    int menu_h = 60;
-    int menu_x = 10;
-    int menu_y = 35;
+/**
+ * @brief Prebuild the background behind a pet sprite of the given size
+ *
+ * The cache holds the background and a compose buffer of the same size;
+ * it is rebuilt when the sprite size changes (new life stage).
+ */
+static void pet_cache_build(int w, int h)
+{
+    pet_cache_free();
 
-    display_fill_rect(menu_x, menu_y, menu_w, menu_h, COLOR_MENU_BG);
-    display_draw_rect(menu_x, menu_y, menu_w, menu_h, COLOR_WHITE);
+    int bw = w * PET_SCALE, bh = h * PET_SCALE;
+    if (bw * bh > PET_CACHE_PIXELS) {
+        ESP_LOGW(TAG, "Pet sprite %dx%d exceeds the background cache, drawing directly", w, h);
+        return;
+    }
+    uint16_t *buf = s_pet_cache_mem;
+
+    s_pet_cache.bg = buf;
+    s_pet_cache.compose = buf + bw * bh;
+    s_pet_cache.sprite_w = w;
+    s_pet_cache.sprite_h = h;
+    s_pet_cache.x = PET_CENTER_X - w / 2;
+    s_pet_cache.y = PET_CENTER_Y - h / 2;
+
+    for (int row = 0; row < bh; row++) {
+        uint16_t color = (s_pet_cache.y + row < SCENE_SPLIT_Y) ? COLOR_BG_LIGHT : COLOR_BG;
+        for (int col = 0; col < bw; col++) {
+            buf[row * bw + col] = color;
+        }
+    }
+}
 
-    // Draw menu items in grid
-    int item_w = (menu_w - 20) / MENU_COLS;
-    int item_h = 24;
+/**
+ * @brief Redraw the pet over its cached background as one bitmap
+ */
+static void render_pet_cached(void)
+{
+    TRACE_ZONE("render_pet_cached");
+    int w, h;
+    const uint16_t *sprite = sprites_get_idle_frame(s_frame.pet.stage, s_frame.animation_frame, &w, &h);
 
-    for (int i = 0; i < MENU_COUNT; i++) {
-        int row = i / MENU_COLS;
-        int col = i % MENU_COLS;
-        int x = menu_x + 10 + col * item_w;
-        int y = menu_y + 8 + row * item_h;
+    if (s_pet_cache.bg == NULL || w != s_pet_cache.sprite_w || h != s_pet_cache.sprite_h) {
+        pet_cache_build(w, h);
+    }
+    if (s_pet_cache.bg == NULL) {
+        // No cache: erase and redraw (flickers)
+        fill_scene_rect(PET_CENTER_X - w / 2, PET_CENTER_Y - h / 2, w * PET_SCALE, h * PET_SCALE);
+        render_pet();
+        return;
+    }
 
-        uint16_t bg = (i == s_menu_selection) ? COLOR_MENU_SELECT : COLOR_MENU_BG;
-        uint16_t fg = (i == s_menu_selection) ? COLOR_BLACK : COLOR_WHITE;
+    int bw = w * PET_SCALE, bh = h * PET_SCALE;
+    memcpy(s_pet_cache.compose, s_pet_cache.bg, (size_t)bw * bh * sizeof(uint16_t));
+    for (int y = 0; y < bh; y++) {
+        const uint16_t *src = &sprite[(y / PET_SCALE) * w];
+        uint16_t *dst = &s_pet_cache.compose[y * bw];
+        for (int x = 0; x < bw; x++) {
+            uint16_t pixel = src[x / PET_SCALE];
+            if (pixel != SPRITE_TRANSPARENT) dst[x] = pixel;
+        }
+    }
+    display_draw_bitmap(s_pet_cache.x, s_pet_cache.y, bw, bh, s_pet_cache.compose);
+}
 
-        display_fill_rect(x, y, item_w - 4, item_h - 4, bg);
-        display_draw_string(x + 4, y + 6, s_menu_labels[i], fg, bg, 1);
+/**
+ * @brief Bring the main scene up to date, redrawing only what changed
+ * @return true if the pet area was redrawn
+ */
+static bool render_main_scene(void)
+{
+    TRACE_ZONE("render_main_scene");
+    const pet_state_t *pet = &s_frame.pet;
+    main_view_t *view = &s_main_view;
+    main_view_t now = {
+        .stats = { pet->hunger, pet->happiness, pet->health, pet->energy },
+        .attention = pet->attention_needed && s_frame.attention_flash,
+        .poop = pet->has_poop,
+        .stage = pet->stage,
+        .age_days = frame_age_days(),
+        .frame = s_frame.animation_frame,
+    };
+    bool pet_drawn = false;
+
+    // Text and indicator changes are rare: repaint the scene for them
+    if (s_frame.repaint || now.poop != view->poop || now.stage != view->stage ||
+        now.age_days != view->age_days) {
+        render_main();
+        pet_drawn = true;
+    } else {
+        if (memcmp(now.stats, view->stats, sizeof(now.stats)) != 0 ||
+            now.attention != view->attention) {
+            render_status_bar();
+        }
+        if (now.frame != view->frame) {
+            render_pet_cached();
+            pet_drawn = true;
+        }
     }
 
-    // Instructions
-    display_draw_string(menu_x + 5, menu_y + menu_h + 5,
-                       "L:Select  R:Confirm", COLOR_TEXT_DIM, COLOR_BG, 1);
+    *view = now;
+    return pet_drawn;
+}
+
+static void render_menu(void)
+{
+    TRACE_ZONE("render_menu");
+    // Scene behind the panel is painted on entry only
+    if (s_frame.repaint) {
+        render_main();
+        ui_invalidate(&s_menu_screen);
+    }
+    ui_set_value(&s_menu_screen, MENU_W_GRID, s_frame.menu_selection);
+    ui_render(&s_menu_screen);
 }
 
 static void render_food_menu(void)
 {
-    render_main();
+    TRACE_ZONE("render_food_menu");
+    if (s_frame.repaint) {
+        render_main();
+        ui_invalidate(&s_food_screen);
+    }
+    ui_set_value(&s_food_screen, PICKER_W_LIST, s_frame.food_selection);
+    ui_render(&s_food_screen);
+}
 
-    int menu_w = 100;
-    int menu_h = 70;
-    int menu_x = (SCREEN_W - menu_w) / 2;
-    int menu_y = (SCREEN_H - menu_h) / 2;
+static void render_games_menu(void)
+{
+    TRACE_ZONE("render_games_menu");
+    if (s_frame.repaint) {
+        render_main();
+        ui_invalidate(&s_games_screen);
+    }
+    ui_set_value(&s_games_screen, PICKER_W_LIST, s_frame.game_selection);
+    ui_render(&s_games_screen);
+}
+
+static void update_stats_values(void)
+{
+    const pet_state_t *pet = &s_frame.pet;
+    const uint8_t current[PET_HISTORY_STAT_COUNT] = {
+        pet->hunger, pet->happiness, pet->health, pet->energy
+    };
+
+    ui_set_textf(&s_stats_values, STATS_W_STAGE, "Stage: %s", pet_stage_name(pet->stage));
+    ui_set_textf(&s_stats_values, STATS_W_AGE, "Age: %lu days", (unsigned long)frame_age_days());
+
+    for (int i = 0; i < PET_HISTORY_STAT_COUNT; i++) {
+        uint16_t color = (current[i] < 20) ? COLOR_CRITICAL : COLOR_GOOD;
+        ui_set_icon(&s_stats_values, STATS_W_ICON + i, sprites_get_stat_icon(i, current[i]));
+        ui_set_value(&s_stats_values, STATS_W_BAR + i, current[i]);
+        ui_set_color(&s_stats_values, STATS_W_BAR + i, color);
+        ui_set_textf(&s_stats_values, STATS_W_VALUE + i, "%d%%", current[i]);
+        ui_set_color(&s_stats_values, STATS_W_VALUE + i,
+                     (current[i] < 20) ? COLOR_CRITICAL : COLOR_WHITE);
+    }
+
+    ui_set_textf(&s_stats_values, STATS_W_TOTALS, "Wt %d  Won %d/%d  Fed %d",
+                 pet->weight, pet->games_won, pet->games_played, pet->times_fed);
+}
+
+/**
+ * @brief Draw one sparkline from the buckets copied into the frame
+ *
+ * Each bucket becomes one column (min..max band plus avg pixel), so the
+ * cost is O(GRAPH_W) regardless of how many samples the window covers.
+ */
+static void render_sparkline(int y, pet_history_stat_t stat)
+{
+    TRACE_ZONE("render_sparkline");
+    int columns = s_frame.history_columns;
+
+    display_fill_rect(GRAPH_X, y, GRAPH_W, GRAPH_H, COLOR_BLACK);
+
+    // Newest bucket on the right edge
+    for (int age = 0; age < s_frame.history_count; age++) {
+        const pet_history_bucket_t *b = &s_frame.history[stat][age];
+        int col = columns - 1 - age;
+        int x0 = GRAPH_X + (col * GRAPH_W) / columns;
+        int x1 = GRAPH_X + ((col + 1) * GRAPH_W) / columns;
+
+        int y_max = y + GRAPH_H - 1 - (b->max * (GRAPH_H - 1)) / 100;
+        int y_min = y + GRAPH_H - 1 - (b->min * (GRAPH_H - 1)) / 100;
+        int y_avg = y + GRAPH_H - 1 - (b->avg * (GRAPH_H - 1)) / 100;
+
+        display_fill_rect(x0, y_max, x1 - x0, y_min - y_max + 1, COLOR_BG);
+        display_fill_rect(x0, y_avg, x1 - x0, 1,
+                          b->avg < 20 ? COLOR_CRITICAL : COLOR_GOOD);
+    }
+}
 
-    display_fill_rect(menu_x, menu_y, menu_w, menu_h, COLOR_MENU_BG);
-    display_draw_rect(menu_x, menu_y, menu_w, menu_h, COLOR_WHITE);
+static void render_stats_trends(void)
+{
+    TRACE_ZONE("render_stats_trends");
+    const pet_state_t *pet = &s_frame.pet;
+    const uint8_t current[PET_HISTORY_STAT_COUNT] = {
+        pet->hunger, pet->happiness, pet->health, pet->energy
+    };
+    char buf[16];
 
-    display_draw_string(menu_x + 20, menu_y + 5, "FEED", COLOR_WHITE, COLOR_MENU_BG, 1);
+    for (int s = 0; s < PET_HISTORY_STAT_COUNT; s++) {
+        int y = GRAPH_Y + s * GRAPH_SPACING;
 
-    for (int i = 0; i < FOOD_MENU_COUNT; i++) {
-        int y = menu_y + 20 + i * 16;
-        uint16_t bg = (i == s_food_selection) ? COLOR_MENU_SELECT : COLOR_MENU_BG;
-        uint16_t fg = (i == s_food_selection) ? COLOR_BLACK : COLOR_WHITE;
+        snprintf(buf, sizeof(buf), "%-6s%3d", s_history_labels[s], current[s]);
+        display_draw_string(6, y + 6, buf,
+                            current[s] < 20 ? COLOR_CRITICAL : COLOR_WHITE, COLOR_MENU_BG, 1);
 
-        display_fill_rect(menu_x + 10, y, menu_w - 20, 14, bg);
-        display_draw_string(menu_x + 20, y + 3, s_food_labels[i], fg, bg, 1);
+        render_sparkline(y, (pet_history_stat_t)s);
     }
 }
 
 static void render_stats(void)
 {
-    display_fill(COLOR_MENU_BG);
+    TRACE_ZONE("render_stats");
+    const stats_page_t *page = &s_stats_pages[s_frame.stats_page];
+    bool repaint = s_frame.repaint || s_frame.dirty;
 
-    const pet_state_t *pet = pet_get_state();
-    char buf[32];
+    if (repaint) {
+        ui_invalidate(&s_stats_frame);
+        ui_invalidate(&s_stats_values);
+    }
+    ui_set_text(&s_stats_frame, STATS_W_TITLE, page->title);
 
-    display_draw_string(80, 5, "PET STATS", COLOR_WHITE, COLOR_MENU_BG, 1);
-    display_draw_hline(10, 18, SCREEN_W - 20, COLOR_WHITE);
+    if (page->window_min == 0) {
+        // Runs every frame; only the widgets whose value changed are drawn
+        update_stats_values();
+        ui_render(&s_stats_frame);
+        ui_render(&s_stats_values);
+        return;
+    }
 
-    int y = 25;
-    int spacing = 14;
+    // Graph pages redraw when the level they draw from gets a new bucket
+    uint32_t generation = s_frame.history_generation;
 
-    snprintf(buf, sizeof(buf), "Stage:  %s", pet_get_stage_name());
-    display_draw_string(10, y, buf, COLOR_WHITE, COLOR_MENU_BG, 1);
-    y += spacing;
+    if (!repaint && generation == s_stats_generation) {
+        return;
+    }
+    s_stats_generation = generation;
 
-    snprintf(buf, sizeof(buf), "Age:    %lu days", (unsigned long)pet_get_age_days());
-    display_draw_string(10, y, buf, COLOR_WHITE, COLOR_MENU_BG, 1);
-    y += spacing;
+    ui_render(&s_stats_frame);
+    render_stats_trends();
+}
+
+static void render_results(void)
+{
+    TRACE_ZONE("render_results");
+    minigame_id_t id = s_frame.game;
+    const leaderboard_entry_t *e = &s_frame.entry;
+    char buf[40];
+    int y = RESULTS_Y;
+
+    display_fill(COLOR_MENU_BG);
 
-    snprintf(buf, sizeof(buf), "Hunger: %d%%", pet->hunger);
-    display_draw_string(10, y, buf, pet->hunger < 20 ? COLOR_CRITICAL : COLOR_WHITE, COLOR_MENU_BG, 1);
-    y += spacing;
+    snprintf(buf, sizeof(buf), "%s %s", minigame_name(id), s_frame.result.won ? "WON" : "LOST");
+    display_draw_string(RESULTS_X, 10, buf, s_frame.result.won ? COLOR_GOOD : COLOR_CRITICAL,
+                        COLOR_MENU_BG, 2);
 
-    snprintf(buf, sizeof(buf), "Happy:  %d%%", pet->happiness);
-    display_draw_string(10, y, buf, pet->happiness < 20 ? COLOR_CRITICAL : COLOR_WHITE, COLOR_MENU_BG, 1);
-    y += spacing;
+    snprintf(buf, sizeof(buf), "Score:    %u", s_frame.result.score);
+    display_draw_string(RESULTS_X, y, buf, COLOR_TEXT, COLOR_MENU_BG, 1);
+    if (s_frame.records & LEADERBOARD_NEW_SCORE) {
+        display_draw_string(RESULTS_X + 110, y, "NEW BEST!", COLOR_GOOD, COLOR_MENU_BG, 1);
+    }
+    y += RESULTS_LINE_H;
+
+    snprintf(buf, sizeof(buf), "Best:     %u", e->best_score);
+    display_draw_string(RESULTS_X, y, buf, COLOR_TEXT, COLOR_MENU_BG, 1);
+    y += RESULTS_LINE_H;
+
+    snprintf(buf, sizeof(buf), "Streak:   %u (best %u)", e->streak, e->best_streak);
+    display_draw_string(RESULTS_X, y, buf, COLOR_TEXT, COLOR_MENU_BG, 1);
+    y += RESULTS_LINE_H;
 
-    snprintf(buf, sizeof(buf), "Health: %d%%", pet->health);
-    display_draw_string(10, y, buf, pet->health < 20 ? COLOR_CRITICAL : COLOR_WHITE, COLOR_MENU_BG, 1);
-    y += spacing;
+    snprintf(buf, sizeof(buf), "Won:      %u/%u", e->wins, e->plays);
+    display_draw_string(RESULTS_X, y, buf, COLOR_TEXT, COLOR_MENU_BG, 1);
+    y += RESULTS_LINE_H;
 
-    snprintf(buf, sizeof(buf), "Energy: %d%%", pet->energy);
-    display_draw_string(10, y, buf, pet->energy < 20 ? COLOR_CRITICAL : COLOR_WHITE, COLOR_MENU_BG, 1);
+    if (s_frame.result.reaction_ms) {
+        snprintf(buf, sizeof(buf), "Reaction: %u ms (best %u)",
+                 s_frame.result.reaction_ms, e->best_reaction_ms);
+    } else {
+        snprintf(buf, sizeof(buf), "Reaction: -");
+    }
+    display_draw_string(RESULTS_X, y, buf, COLOR_TEXT, COLOR_MENU_BG, 1);
+    if (s_frame.records & LEADERBOARD_NEW_REACTION) {
+        display_draw_string(RESULTS_X + 170, y, "NEW!", COLOR_GOOD, COLOR_MENU_BG, 1);
+    }
 
-    // Right column
-    y = 25;
-    snprintf(buf, sizeof(buf), "Weight: %d", pet->weight);
-    display_draw_string(130, y, buf, COLOR_WHITE, COLOR_MENU_BG, 1);
-    y += spacing;
+    display_draw_string(50, SCREEN_H - 12, "Press any button", COLOR_TEXT_DIM, COLOR_MENU_BG, 1);
+}
 
-    snprintf(buf, sizeof(buf), "Games:  %d/%d", pet->games_won, pet->games_played);
-    display_draw_string(130, y, buf, COLOR_WHITE, COLOR_MENU_BG, 1);
-    y += spacing;
+static void render_settings(void)
+{
+    TRACE_ZONE("render_settings");
 
-    snprintf(buf, sizeof(buf), "Fed:    %d", pet->times_fed);
-    display_draw_string(130, y, buf, COLOR_WHITE, COLOR_MENU_BG, 1);
+    if (s_frame.repaint) {
+        display_fill(COLOR_MENU_BG);
+        display_draw_string(SETTINGS_X, 4, "SETTINGS", COLOR_WHITE, COLOR_MENU_BG, 2);
+        display_draw_string(50, SCREEN_H - 12, "L:Next  R:Change", COLOR_TEXT_DIM, COLOR_MENU_BG, 1);
+    }
 
-    display_draw_string(80, SCREEN_H - 12, "Press any button", COLOR_TEXT_DIM, COLOR_MENU_BG, 1);
+    for (int i = 0; i <= SETTINGS_ITEM_COUNT; i++) {
+        int y = SETTINGS_Y + i * SETTINGS_ROW_H;
+        uint16_t bg = (i == s_frame.settings_selection) ? COLOR_MENU_SELECT : COLOR_MENU_BG;
+        uint16_t fg = (i == s_frame.settings_selection) ? COLOR_BLACK : COLOR_WHITE;
+
+        display_fill_rect(SETTINGS_X - 4, y, SETTINGS_ROW_W, SETTINGS_ROW_H - 1, bg);
+        if (i == SETTINGS_ITEM_COUNT) {
+            display_draw_string(SETTINGS_X, y + 2, "BACK", fg, bg, 1);
+            continue;
+        }
+        display_draw_string(SETTINGS_X, y + 2, settings_item_name((settings_item_t)i), fg, bg, 1);
+        display_draw_string(SETTINGS_VALUE_X, y + 2, s_frame.settings_values[i], fg, bg, 1);
+    }
 }
 
 static void render_death(void)
 {
+    TRACE_ZONE("render_death");
     display_fill(COLOR_BLACK);
 
     char buf[32];
 
     display_draw_string(60, 30, "GAME OVER", COLOR_CRITICAL, COLOR_BLACK, 2);
 
-    snprintf(buf, sizeof(buf), "Your dolphin lived %lu days", (unsigned long)pet_get_age_days());
+    snprintf(buf, sizeof(buf), "Your dolphin lived %lu days", (unsigned long)frame_age_days());
     display_draw_string(30, 70, buf, COLOR_WHITE, COLOR_BLACK, 1);
 
     display_draw_string(50, 100, "Press any button", COLOR_TEXT_DIM, COLOR_BLACK, 1);
     display_draw_string(60, 115, "for new pet", COLOR_TEXT_DIM, COLOR_BLACK, 1);
 }
 
+//=============================================================================
+// State Handlers
+//=============================================================================
+
+static void update_pet(uint32_t delta_ms)
+{
+    pet_update(delta_ms);
+    pet_history_update(delta_ms);
+    if (!pet_is_alive()) {
+        change_state(GAME_STATE_DEATH);
+    }
+}
+
+static void input_to_main(button_id_t button, button_event_t event)
+{
+    change_state(GAME_STATE_MAIN);
+}
+
+// Splash
+
+static void splash_input(button_id_t button, button_event_t event)
+{
+    // A pet restored from the save carries on; pet_init() leaves health 0
+    const pet_state_t *pet = pet_get_state();
+    if (pet_is_alive() && pet->health > 0) {
+        change_state(GAME_STATE_MAIN);
+    } else {
+        game_new();
+    }
+}
+
+// Main scene (also behind the sleep screen)
+
+/**
+ * @brief Build the pet cache on the frame entering the scene
+ *
+ * That frame repaints everything anyway, so the animation frames after
+ * it do not pay for the build.
+ */
+static void main_prepare_cache(void)
+{
+    int w, h;
+    sprites_get_idle_frame(s_frame.pet.stage, s_frame.animation_frame, &w, &h);
+    if (s_frame.repaint && s_pet_cache.bg == NULL) {
+        pet_cache_build(w, h);
+    }
+}
+
+static void main_render(void)
+{
+    TRACE_ZONE("main_render");
+    main_prepare_cache();
+    render_main_scene();
+}
+
+static void main_input(button_id_t button, button_event_t event)
+{
+    switch (event) {
+        case BUTTON_EVENT_DOUBLE_CLICK:
+            if (button == BUTTON_LEFT) {
+                pet_clean();
+                latency_mark_region(0, 0, SCREEN_W, SCREEN_H);
+            } else {
+                s_food_selection = 0;
+                change_state(GAME_STATE_FEED);
+            }
+            break;
+
+        case BUTTON_EVENT_CHORD:
+            s_stats_page = 0;
+            change_state(GAME_STATE_STATS);
+            break;
+
+        case BUTTON_EVENT_HOLD_CLICK:
+            start_play(minigame_current());     // Last game played
+            break;
+
+        default:
+            if (button == BUTTON_LEFT || button == BUTTON_RIGHT) {
+                change_state(GAME_STATE_MENU);
+                s_menu_selection = 0;
+            }
+            break;
+    }
+}
+
+// Menu
+
+static void menu_input(button_id_t button, button_event_t event)
+{
+    if (event == BUTTON_EVENT_CHORD) {
+        change_state(GAME_STATE_MAIN);
+        return;
+    }
+
+    if (button == BUTTON_LEFT) {
+        s_menu_selection = (s_menu_selection + 1) % MENU_COUNT;
+        latency_mark_region(MENU_PANEL_X, MENU_PANEL_Y, MENU_PANEL_W, MENU_PANEL_H);
+    } else if (button == BUTTON_RIGHT) {
+        // Execute menu action
+        switch (s_menu_selection) {
+            case MENU_FEED:
+                change_state(GAME_STATE_FEED);
+                s_food_selection = 0;
+                break;
+            case MENU_PLAY:
+                s_game_selection = minigame_current();
+                change_state(GAME_STATE_GAMES);
+                break;
+            case MENU_SLEEP:
+                pet_toggle_sleep();
+                change_state(pet_get_state()->is_sleeping ?
+                             GAME_STATE_SLEEP : GAME_STATE_MAIN);
+                break;
+            case MENU_CLEAN:
+                pet_clean();
+                change_state(GAME_STATE_MAIN);
+                break;
+            case MENU_MEDICINE:
+                pet_give_medicine();
+                change_state(GAME_STATE_MAIN);
+                break;
+            case MENU_STATS:
+                s_stats_page = 0;
+                change_state(GAME_STATE_STATS);
+                break;
+            case MENU_SETTINGS:
+                s_settings_selection = 0;
+                change_state(GAME_STATE_SETTINGS);
+                break;
+        }
+    }
+    if (event == BUTTON_EVENT_LONG_PRESS) {
+        change_state(GAME_STATE_MAIN);
+    }
+}
+
+// Food submenu
+
+static void feed_input(button_id_t button, button_event_t event)
+{
+    if (button == BUTTON_LEFT) {
+        s_food_selection = (s_food_selection + 1) % FOOD_MENU_COUNT;
+        latency_mark_region(FOOD_PANEL_X, FOOD_PANEL_Y, FOOD_PANEL_W, FOOD_PANEL_H);
+    } else if (button == BUTTON_RIGHT) {
+        switch (s_food_selection) {
+            case FOOD_MENU_FISH:
+                pet_feed(FOOD_FISH);
+                change_state(GAME_STATE_MAIN);
+                break;
+            case FOOD_MENU_SHRIMP:
+                pet_feed(FOOD_SHRIMP);
+                change_state(GAME_STATE_MAIN);
+                break;
+            case FOOD_MENU_BACK:
+                change_state(GAME_STATE_MENU);
+                break;
+        }
+    }
+}
+
+// Mini-game picker
+
+static void games_input(button_id_t button, button_event_t event)
+{
+    if (button == BUTTON_LEFT) {
+        s_game_selection = (s_game_selection + 1) % (MINIGAME_COUNT + 1);
+        latency_mark_region(GAMES_PANEL_X, GAMES_PANEL_Y, GAMES_PANEL_W, GAMES_PANEL_H);
+    } else if (button == BUTTON_RIGHT) {
+        if (s_game_selection == MINIGAME_COUNT) {
+            change_state(GAME_STATE_MENU);
+        } else {
+            start_play((minigame_id_t)s_game_selection);
+            if (s_state != GAME_STATE_PLAY) change_state(GAME_STATE_MAIN);
+        }
+    }
+}
+
+// Mini-game
+
+static void play_update(uint32_t delta_ms)
+{
+    if (minigame_update(delta_ms)) return;
+
+    // Game complete
+    minigame_get_result(&s_last_result);
+    pet_play_complete(s_last_result.won);
+    s_last_records = leaderboard_record(minigame_current(), &s_last_result);
+    // One flash write per session; playback must not touch flash
+    if (replay_get_mode() != REPLAY_PLAYING) {
+        leaderboard_flush();
+    }
+    change_state(GAME_STATE_RESULTS);
+}
+
+static void play_render(void)
+{
+    TRACE_ZONE("play_render");
+    minigame_render();
+}
+
+static void play_input(button_id_t button, button_event_t event)
+{
+    minigame_handle_input(button, event);
+}
+
+// Stats
+
+static void stats_input(button_id_t button, button_event_t event)
+{
+    if (button == BUTTON_LEFT) {
+        s_stats_page = (s_stats_page + 1) % STATS_PAGE_COUNT;
+        s_dirty = true;
+        latency_mark_region(0, 0, SCREEN_W, SCREEN_H);
+    } else {
+        change_state(GAME_STATE_MAIN);
+    }
+}
+
+// Settings
+
+static void settings_exit(game_state_t to)
+{
+    // One flash write per visit; playback must not touch flash
+    if (replay_get_mode() != REPLAY_PLAYING) {
+        settings_flush();
+    }
+}
+
+static void settings_input(button_id_t button, button_event_t event)
+{
+    if (event == BUTTON_EVENT_LONG_PRESS) {
+        change_state(GAME_STATE_MENU);
+        return;
+    }
+
+    if (button == BUTTON_LEFT) {
+        s_settings_selection = (s_settings_selection + 1) % (SETTINGS_ITEM_COUNT + 1);
+    } else if (button == BUTTON_RIGHT) {
+        if (s_settings_selection == SETTINGS_ITEM_COUNT) {
+            change_state(GAME_STATE_MENU);
+            return;
+        }
+        // Takes effect at once (backlight, frame cap, render mode)
+        settings_cycle((settings_item_t)s_settings_selection);
+        if (s_settings_selection == SETTINGS_ITEM_RENDER_MODE) {
+            s_repaint = true;   // A new screen copy starts out blank
+        }
+    }
+    latency_mark_region(0, SETTINGS_Y, SCREEN_W, (SETTINGS_ITEM_COUNT + 1) * SETTINGS_ROW_H);
+}
+
+// Sleep
+
+static void sleep_update(uint32_t delta_ms)
+{
+    pet_update(delta_ms);
+    pet_history_update(delta_ms);
+    if (!pet_get_state()->is_sleeping) {
+        change_state(GAME_STATE_MAIN);
+    }
+}
+
+static void sleep_render(void)
+{
+    TRACE_ZONE("sleep_render");
+    main_prepare_cache();
+    // The pet is drawn under the text
+    if (render_main_scene()) {
+        display_draw_string(100, 60, "Zzz...", COLOR_WHITE, COLOR_BG, 2);
+    }
+}
+
+static void sleep_input(button_id_t button, button_event_t event)
+{
+    if (button == BUTTON_RIGHT) {
+        pet_wake();
+        change_state(GAME_STATE_MAIN);
+    }
+}
+
+// Death
+
+static void death_input(button_id_t button, button_event_t event)
+{
+    game_new();
+}
+
+//=============================================================================
+// State Table
+//=============================================================================
+
+static const state_desc_t s_states[GAME_STATE_COUNT] = {
+    [GAME_STATE_SPLASH] = {
+        .name = "SPLASH", .redraw = REDRAW_ON_CHANGE,
+        .render = render_splash, .input = splash_input,
+    },
+    [GAME_STATE_MAIN] = {
+        .name = "MAIN", .redraw = REDRAW_EVERY_FRAME,
+        .gestures = GESTURE(DOUBLE_CLICK, LEFT) |       // Clean
+                    GESTURE(DOUBLE_CLICK, RIGHT) |      // Feed
+                    GESTURE(HOLD_CLICK, RIGHT) |        // Play
+                    INPUT_GESTURE_CHORD_ANY,            // Stats
+        .update = update_pet, .render = main_render, .input = main_input,
+    },
+    [GAME_STATE_MENU] = {
+        .name = "MENU", .redraw = REDRAW_ON_CHANGE,
+        .gestures = INPUT_GESTURE_CHORD_ANY,            // Back to main
+        .update = update_pet, .render = render_menu, .input = menu_input,
+    },
+    [GAME_STATE_FEED] = {
+        .name = "FEED", .redraw = REDRAW_ON_CHANGE,
+        .update = update_pet, .render = render_food_menu, .input = feed_input,
+    },
+    [GAME_STATE_GAMES] = {
+        .name = "GAMES", .redraw = REDRAW_ON_CHANGE,
+        .render = render_games_menu, .input = games_input,
+    },
+    [GAME_STATE_PLAY] = {
+        .name = "PLAY", .redraw = REDRAW_EVERY_FRAME, .raw_input = true,
+        .update = play_update, .render = play_render, .input = play_input,
+    },
+    [GAME_STATE_RESULTS] = {
+        .name = "RESULTS", .redraw = REDRAW_ON_CHANGE,
+        .render = render_results, .input = input_to_main,
+    },
+    [GAME_STATE_STATS] = {
+        .name = "STATS", .redraw = REDRAW_EVERY_FRAME,     // Follows history updates
+        .update = update_pet, .render = render_stats, .input = stats_input,
+    },
+    [GAME_STATE_SETTINGS] = {
+        .name = "SETTINGS", .redraw = REDRAW_ON_CHANGE,
+        .exit = settings_exit,
+        .render = render_settings, .input = settings_input,
+    },
+    [GAME_STATE_SLEEP] = {
+        .name = "SLEEP", .redraw = REDRAW_EVERY_FRAME,
+        .update = sleep_update, .render = sleep_render, .input = sleep_input,
+    },
+    [GAME_STATE_DEATH] = {
+        .name = "DEATH", .redraw = REDRAW_ON_CHANGE,
+        .render = render_death, .input = death_input,
+    },
+    [GAME_STATE_NEW_GAME] = {
+        .name = "NEW_GAME", .redraw = REDRAW_ON_CHANGE,
+        .render = render_main, .input = input_to_main,
+    },
+};
+
 //=============================================================================
 // Public Functions
 //=============================================================================
@@ -345,13 +1258,35 @@ esp_err_t game_init(void)
 {
     ESP_LOGI(TAG, "Initializing game");
 
+    // Release what the previous state held (re-init for replay playback)
+    if (s_states[s_state].exit) s_states[s_state].exit(GAME_STATE_SPLASH);
+
     s_state = GAME_STATE_SPLASH;
     s_state_time_ms = get_ms();
     s_menu_selection = 0;
     s_animation_frame = 0;
+    s_animation_timer = 0;
+    s_flash_timer = 0;
+    s_attention_flash = false;
     s_last_update_ms = get_ms();
+    s_repaint = true;
+    input_set_gestures(s_states[s_state].gestures);
 
     minigame_init();
+    leaderboard_load();
+    settings_load();
+
+    // Widget layouts are computed once and kept (no-op on re-init)
+    for (int i = 0; i < MINIGAME_COUNT; i++) {
+        s_game_labels[i] = minigame_name((minigame_id_t)i);
+    }
+    s_game_labels[MINIGAME_COUNT] = "BACK";
+    ui_screen_init(&s_menu_screen, s_menu_widgets, MENU_W_COUNT);
+    ui_screen_init(&s_food_screen, s_food_widgets, PICKER_W_COUNT);
+    ui_screen_init(&s_games_screen, s_games_widgets, PICKER_W_COUNT);
+    ui_screen_init(&s_stats_frame, s_stats_frame_widgets, STATS_W_FRAME_COUNT);
+    ui_screen_init(&s_stats_values, s_stats_values_widgets, STATS_W_VALUES_COUNT);
+    ui_report_memory();
 
     return ESP_OK;
 }
@@ -360,11 +1295,13 @@ void game_new(void)
 {
     ESP_LOGI(TAG, "Starting new game");
     pet_new();
+    pet_history_reset();
     change_state(GAME_STATE_MAIN);
 }
 
 void game_update(uint32_t delta_ms)
 {
+    TRACE_ZONE("game_update");
     uint32_t now = get_ms();
 
     // Animation timer
@@ -381,185 +1318,125 @@ void game_update(uint32_t delta_ms)
         s_attention_flash = !s_attention_flash;
     }
 
-    // State-specific updates
-    switch (s_state) {
-        case GAME_STATE_MAIN:
-        case GAME_STATE_MENU:
-        case GAME_STATE_FEED:
-        case GAME_STATE_STATS:
-            pet_update(delta_ms);
-            if (!pet_is_alive()) {
-                change_state(GAME_STATE_DEATH);
-            }
-            break;
-
-        case GAME_STATE_PLAY:
-            if (!minigame_update(delta_ms)) {
-                // Game complete
-                bool won = minigame_is_win();
-                pet_play_complete(won);
-                change_state(GAME_STATE_MAIN);
-            }
-            break;
-
-        case GAME_STATE_SLEEP:
-            pet_update(delta_ms);
-            if (!pet_get_state()->is_sleeping) {
-                change_state(GAME_STATE_MAIN);
-            }
-            break;
+    // Render mode switched outside the settings screen (debug console)
+    if (display_get_render_mode() != s_render_mode) {
+        s_render_mode = display_get_render_mode();
+        s_repaint = true;
+    }
 
-        default:
-            break;
+    // State-specific update, charged to the state it started in
+    game_state_t state = s_state;
+    if (s_states[state].update) {
+        int64_t start = esp_timer_get_time();
+        s_states[state].update(delta_ms);
+        s_profile[state].update_us += (uint64_t)(esp_timer_get_time() - start);
+        s_profile[state].updates++;
     }
 
     s_last_update_ms = now;
 }
 
-void game_render(void)
+/**
+ * @brief Copy the buckets a graph page draws; the sim task keeps appending
+ *        to the history while the frame is rendered
+ */
+static void publish_history(game_frame_t *f, uint32_t window_min)
 {
-    switch (s_state) {
-        case GAME_STATE_SPLASH:
-            render_splash();
-            break;
-
-        case GAME_STATE_MAIN:
-            render_main();
-            break;
-
-        case GAME_STATE_MENU:
-            render_menu();
-            break;
-
-        case GAME_STATE_FEED:
-            render_food_menu();
-            break;
-
-        case GAME_STATE_PLAY:
-            minigame_render();
-            break;
-
-        case GAME_STATE_STATS:
-            render_stats();
-            break;
-
-        case GAME_STATE_SLEEP:
-            render_main();
-            display_draw_string(100, 60, "Zzz...", COLOR_WHITE, COLOR_BG, 2);
-            break;
-
-        case GAME_STATE_DEATH:
-            render_death();
-            break;
-
-        default:
-            render_main();
-            break;
+    int level = pet_history_select_level(window_min, GRAPH_W);
+    uint32_t span = pet_history_span_minutes(level);
+    int columns = (int)((window_min + span - 1) / span);
+    if (columns > GRAPH_W) columns = GRAPH_W;
+
+    int available = pet_history_count(level);
+    if (available > columns) available = columns;
+
+    f->history_generation = pet_history_generation(level);
+    f->history_columns = (uint8_t)columns;
+    for (int s = 0; s < PET_HISTORY_STAT_COUNT; s++) {
+        for (int age = 0; age < available; age++) {
+            f->history[s][age] = *pet_history_get(level, (pet_history_stat_t)s, age);
+        }
     }
+    f->history_count = (uint8_t)available;
 }
 
-void game_handle_input(button_id_t button, button_event_t event)
+void game_publish_frame(void)
 {
-    if (event != BUTTON_EVENT_CLICK && event != BUTTON_EVENT_LONG_PRESS) {
-        return;
+    game_frame_t *f = &s_frame;
+
+    f->state = s_state;
+    f->repaint = s_repaint;
+    f->dirty = s_dirty;
+    f->menu_selection = s_menu_selection;
+    f->food_selection = s_food_selection;
+    f->game_selection = s_game_selection;
+    f->settings_selection = s_settings_selection;
+    f->stats_page = s_stats_page;
+    f->animation_frame = s_animation_frame;
+    f->attention_flash = s_attention_flash;
+    f->pet = *pet_get_state();
+    f->game = minigame_current();
+
+    // Screen-specific parts only while their screen is up
+    if (s_state == GAME_STATE_STATS && s_stats_pages[s_stats_page].window_min != 0) {
+        publish_history(f, s_stats_pages[s_stats_page].window_min);
+    } else if (s_state == GAME_STATE_RESULTS) {
+        f->result = s_last_result;
+        f->records = s_last_records;
+        f->entry = *leaderboard_get(f->game);
+    } else if (s_state == GAME_STATE_SETTINGS) {
+        for (int i = 0; i < SETTINGS_ITEM_COUNT; i++) {
+            settings_item_value((settings_item_t)i, f->settings_values[i], sizeof(f->settings_values[i]));
+        }
     }
+    minigame_publish();
 
-    switch (s_state) {
-        case GAME_STATE_SPLASH:
-            game_new();
-            break;
+    // Handed over with the frame
+    s_repaint = false;
+    s_dirty = false;
+}
 
-        case GAME_STATE_MAIN:
-            if (button == BUTTON_LEFT || button == BUTTON_RIGHT) {
-                change_state(GAME_STATE_MENU);
-                s_menu_selection = 0;
-            }
-            break;
+void game_render(void)
+{
+    game_state_t state = s_frame.state;
+    const state_desc_t *desc = &s_states[state];
 
-        case GAME_STATE_MENU:
-            if (button == BUTTON_LEFT) {
-                s_menu_selection = (s_menu_selection + 1) % MENU_COUNT;
-            } else if (button == BUTTON_RIGHT) {
-                // Execute menu action
-                switch (s_menu_selection) {
-                    case MENU_FEED:
-                        change_state(GAME_STATE_FEED);
-                        s_food_selection = 0;
-                        break;
-                    case MENU_PLAY:
-                        if (pet_play_start()) {
-                            minigame_start();
-                            change_state(GAME_STATE_PLAY);
-                        }
-                        break;
-                    case MENU_SLEEP:
-                        pet_toggle_sleep();
-                        change_state(pet_get_state()->is_sleeping ?
-                                     GAME_STATE_SLEEP : GAME_STATE_MAIN);
-                        break;
-                    case MENU_CLEAN:
-                        pet_clean();
-                        change_state(GAME_STATE_MAIN);
-                        break;
-                    case MENU_MEDICINE:
-                        pet_give_medicine();
-                        change_state(GAME_STATE_MAIN);
-                        break;
-                    case MENU_STATS:
-                        change_state(GAME_STATE_STATS);
-                        break;
-                    case MENU_SETTINGS:
-                        change_state(GAME_STATE_MAIN);
-                        break;
-                }
-            }
-            if (event == BUTTON_EVENT_LONG_PRESS) {
-                change_state(GAME_STATE_MAIN);
-            }
-            break;
+    if (desc->redraw == REDRAW_ON_CHANGE && !s_frame.repaint && !s_frame.dirty) {
+        return;
+    }
 
-        case GAME_STATE_FEED:
-            if (button == BUTTON_LEFT) {
-                s_food_selection = (s_food_selection + 1) % FOOD_MENU_COUNT;
-            } else if (button == BUTTON_RIGHT) {
-                switch (s_food_selection) {
-                    case FOOD_MENU_FISH:
-                        pet_feed(FOOD_FISH);
-                        change_state(GAME_STATE_MAIN);
-                        break;
-                    case FOOD_MENU_SHRIMP:
-                        pet_feed(FOOD_SHRIMP);
-                        change_state(GAME_STATE_MAIN);
-                        break;
-                    case FOOD_MENU_BACK:
-                        change_state(GAME_STATE_MENU);
-                        break;
-                }
-            }
-            break;
+    int64_t start = esp_timer_get_time();
+    desc->render();
+    uint32_t us = (uint32_t)(esp_timer_get_time() - start);
 
-        case GAME_STATE_PLAY:
-            minigame_handle_input(button, event);
-            break;
+    state_profile_t *prof = &s_profile[state];
+    prof->renders++;
+    prof->render_us += us;
+    if (us > prof->render_max_us) prof->render_max_us = us;
 
-        case GAME_STATE_STATS:
-            change_state(GAME_STATE_MAIN);
-            break;
+    s_frame.repaint = false;
+    s_frame.dirty = false;
+}
 
-        case GAME_STATE_SLEEP:
-            if (button == BUTTON_RIGHT) {
-                pet_wake();
-                change_state(GAME_STATE_MAIN);
-            }
-            break;
+void game_handle_input(button_id_t button, button_event_t event)
+{
+    game_state_t state = s_state;
+    const state_desc_t *desc = &s_states[state];
+
+    // Mini-games see every event (presses and releases included); other
+    // states get clicks, long presses and the gestures they bind
+    if (!desc->raw_input) {
+        bool gesture = (event == BUTTON_EVENT_DOUBLE_CLICK || event == BUTTON_EVENT_CHORD ||
+                        event == BUTTON_EVENT_HOLD_CLICK);
+        if (gesture && desc->gestures == 0) return;
+        if (!gesture && event != BUTTON_EVENT_CLICK && event != BUTTON_EVENT_LONG_PRESS) return;
+    }
 
-        case GAME_STATE_DEATH:
-            game_new();
-            break;
+    desc->input(button, event);
 
-        default:
-            change_state(GAME_STATE_MAIN);
-            break;
+    // Input that did not leave an on-change state changed what it shows
+    if (s_state == state && desc->redraw == REDRAW_ON_CHANGE) {
+        s_dirty = true;
     }
 }
 
@@ -572,3 +1449,46 @@ bool game_is_running(void)
 {
     return s_state == GAME_STATE_MAIN || s_state == GAME_STATE_SLEEP;
 }
+
+const char *game_state_name(game_state_t state)
+{
+    if (state >= GAME_STATE_COUNT) return "?";
+    return s_states[state].name;
+}
+
+esp_err_t game_add_transition_hook(game_transition_hook_t hook)
+{
+    for (int i = 0; i < GAME_TRANSITION_HOOKS_MAX; i++) {
+        if (s_hooks[i] == NULL || s_hooks[i] == hook) {
+            s_hooks[i] = hook;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NO_MEM;
+}
+
+void game_get_state_profile(game_state_t state, game_state_profile_t *profile)
+{
+    memset(profile, 0, sizeof(*profile));
+    if (state >= GAME_STATE_COUNT) return;
+
+    const state_profile_t *prof = &s_profile[state];
+    profile->updates = prof->updates;
+    profile->update_avg_us = prof->updates ? (uint32_t)(prof->update_us / prof->updates) : 0;
+    profile->renders = prof->renders;
+    profile->render_avg_us = prof->renders ? (uint32_t)(prof->render_us / prof->renders) : 0;
+    profile->render_max_us = prof->render_max_us;
+}
+
+void game_report_profile(void)
+{
+    for (int i = 0; i < GAME_STATE_COUNT; i++) {
+        game_state_profile_t p;
+        game_get_state_profile((game_state_t)i, &p);
+        if (p.updates == 0 && p.renders == 0) continue;
+        ESP_LOGI(TAG, "%-8s update n=%lu avg=%luus  render n=%lu avg=%luus max=%luus",
+                 s_states[i].name, (unsigned long)p.updates, (unsigned long)p.update_avg_us,
+                 (unsigned long)p.renders, (unsigned long)p.render_avg_us,
+                 (unsigned long)p.render_max_us);
+    }
+}
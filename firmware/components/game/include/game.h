@@ -4,6 +4,8 @@
  *
  * REQ-SW-010: Main Display
  * REQ-SW-011: Menu System
+ * REQ-SW-035: Table-driven Screen States
+ * REQ-SW-037: Multi-task Runtime
  * Manages game screens, menu navigation, and rendering.
  */
 
@@ -24,14 +26,39 @@ typedef enum {
     GAME_STATE_MAIN,        // Main pet view
     GAME_STATE_MENU,        // Menu overlay
     GAME_STATE_FEED,        // Food selection submenu
+    GAME_STATE_GAMES,       // Mini-game picker
     GAME_STATE_PLAY,        // Mini-game
+    GAME_STATE_RESULTS,     // Mini-game results and leaderboard
     GAME_STATE_STATS,       // Status details screen
     GAME_STATE_SETTINGS,    // Settings menu
     GAME_STATE_SLEEP,       // Sleep animation
     GAME_STATE_DEATH,       // Game over screen
     GAME_STATE_NEW_GAME,    // New game confirmation
+    GAME_STATE_COUNT
 } game_state_t;
 
+/**
+ * @brief Called after every state change (after the exit and enter handlers)
+ */
+typedef void (*game_transition_hook_t)(game_state_t from, game_state_t to);
+
+#define GAME_TRANSITION_HOOKS_MAX   4
+
+// Static background cache behind the pet (REQ-SW-039): background and
+// compose buffer for the largest sprite (adult, 56x40) at 2x scale
+#define GAME_PET_CACHE_BYTES        (2 * 112 * 80 * 2)
+
+/**
+ * @brief CPU time spent in one state since boot
+ */
+typedef struct {
+    uint32_t updates;           // Sim ticks
+    uint32_t update_avg_us;
+    uint32_t renders;           // Frames actually drawn
+    uint32_t render_avg_us;
+    uint32_t render_max_us;
+} game_state_profile_t;
+
 //=============================================================================
 // Menu Items
 //=============================================================================
@@ -76,7 +103,16 @@ void game_new(void);
 void game_update(uint32_t delta_ms);
 
 /**
- * @brief Render current game state to display
+ * @brief Hand the current state to the renderer (simulation task)
+ *
+ * Copies what the screens draw into the frame view, along with the
+ * pending repaint, and publishes the running mini-game. Call only while
+ * no frame is being rendered.
+ */
+void game_publish_frame(void);
+
+/**
+ * @brief Render the last published frame to display (render task)
  */
 void game_render(void);
 
@@ -99,4 +135,25 @@ game_state_t game_get_state(void);
  */
 bool game_is_running(void);
 
+/**
+ * @brief Get the name of a state (logs, console)
+ */
+const char *game_state_name(game_state_t state);
+
+/**
+ * @brief Register a function called on every state change
+ * @return ESP_OK, or ESP_ERR_NO_MEM if all GAME_TRANSITION_HOOKS_MAX slots are taken
+ */
+esp_err_t game_add_transition_hook(game_transition_hook_t hook);
+
+/**
+ * @brief Get the CPU time profile of one state
+ */
+void game_get_state_profile(game_state_t state, game_state_profile_t *profile);
+
+/**
+ * @brief Log update and render time of every state visited (UART console)
+ */
+void game_report_profile(void);
+
 #endif // GAME_H
@@ -0,0 +1,100 @@
+/**
+ * @file leaderboard.h
+ * @brief Per-minigame high scores and statistics for ESP32 Tamagotchi
+ *
+ * REQ-SW-065: Mini-game Leaderboard
+ * Keeps best score, win streaks and fastest reaction for every mini-game
+ * in one fixed-size record. The record lives in RAM and is stored as its
+ * own NVS blob, so recording a session never rewrites the pet save. The
+ * leaderboard belongs to the device and survives a new pet.
+ */
+
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "minigame.h"
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define LEADERBOARD_MAGIC   0x424C      // "LB"
+#define LEADERBOARD_VERSION 1
+#define LEADERBOARD_SLOTS   4           // Games the record has room for
+#define LEADERBOARD_NVS_KEY "leaderboard"
+
+// leaderboard_record() flags
+#define LEADERBOARD_NEW_SCORE       (1 << 0)
+#define LEADERBOARD_NEW_STREAK      (1 << 1)
+#define LEADERBOARD_NEW_REACTION    (1 << 2)
+
+_Static_assert(MINIGAME_COUNT <= LEADERBOARD_SLOTS, "leaderboard record has no slot for every game");
+
+//=============================================================================
+// Types
+//=============================================================================
+
+/**
+ * @brief Statistics of one mini-game (12 bytes)
+ */
+typedef struct __attribute__((packed)) {
+    uint16_t best_score;
+    uint16_t plays;
+    uint16_t wins;
+    uint8_t streak;             // Current win streak
+    uint8_t best_streak;
+    uint16_t best_reaction_ms;  // Fastest reaction, 0 = none yet
+    uint16_t last_score;
+} leaderboard_entry_t;
+
+/**
+ * @brief Stored record (52 bytes)
+ *
+ * Slots are indexed by minigame_id_t. Spare slots keep the size fixed
+ * when games are added.
+ */
+typedef struct __attribute__((packed)) {
+    uint16_t magic;             // LEADERBOARD_MAGIC
+    uint8_t version;            // LEADERBOARD_VERSION
+    uint8_t reserved;
+    leaderboard_entry_t entries[LEADERBOARD_SLOTS];
+} leaderboard_record_t;
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+/**
+ * @brief Load the record from NVS (call after save_manager_init())
+ *
+ * A missing or unreadable record starts an empty leaderboard.
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if nothing was stored
+ */
+esp_err_t leaderboard_load(void);
+
+/**
+ * @brief Fold a finished session into the game's entry (RAM only, O(1))
+ * @param id Game that was played
+ * @param result Its result
+ * @return LEADERBOARD_NEW_* flags for the records this session broke
+ */
+uint8_t leaderboard_record(minigame_id_t id, const minigame_result_t *result);
+
+/**
+ * @brief Write the record to NVS if it changed since the last flush
+ *
+ * Called once per session, so a session costs at most one flash write.
+ * @return ESP_OK on success or when there was nothing to write
+ */
+esp_err_t leaderboard_flush(void);
+
+/**
+ * @brief Get the statistics of one game
+ * @return Entry, or NULL for an invalid ID
+ */
+const leaderboard_entry_t *leaderboard_get(minigame_id_t id);
+
+#endif // LEADERBOARD_H
@@ -1,9 +1,19 @@
 /**
  * @file minigame.h
- * @brief "Jump the Wave" mini-game for ESP32 Tamagotchi
+ * @brief Mini-game framework for ESP32 Tamagotchi
  *
  * REQ-SW-004: Play Mechanic
- * Simple reaction-based game where the dolphin jumps over waves.
+ * REQ-SW-064: Mini-game Plugin Framework
+ * Each mini-game registers a vtable of lifecycle handlers. Only one game
+ * runs at a time, so its state is carved from one shared static arena
+ * when it starts: adding a game costs flash, not permanent RAM. Every
+ * frame (updates plus render) is timed against the game's declared budget.
+ *
+ * REQ-SW-037: Multi-task Runtime
+ * Render runs on its own task while the simulation goes on. It draws from
+ * a second arena: minigame_publish() copies the game's model (the leading
+ * model_size bytes of its state) into it, and the rest of the state there
+ * (what is on screen, compose buffers) belongs to render alone.
  */
 
 #ifndef MINIGAME_H
@@ -11,91 +21,142 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "input.h"
 
 //=============================================================================
-// Mini-game State
+// Physics (shared by all games)
 //=============================================================================
 
+#define MINIGAME_STEP_MS    8       // Fixed physics timestep (125 Hz)
+#define MINIGAME_FP_SHIFT   8       // Q8: 1/256 pixel
+#define MINIGAME_FP_ONE     (1 << MINIGAME_FP_SHIFT)
+
+//=============================================================================
+// Registry
+//=============================================================================
+
+#define MINIGAME_ARENA_SIZE 8192    // Bytes shared by all games
+#define MINIGAME_RAM_BYTES  (2 * MINIGAME_ARENA_SIZE)   // Simulation and render arenas (REQ-SW-039)
+
 typedef enum {
-    MINIGAME_STATE_READY,       // Waiting to start
-    MINIGAME_STATE_PLAYING,     // Game in progress
-    MINIGAME_STATE_SUCCESS,     // Successful jump
-    MINIGAME_STATE_FAIL,        // Missed the wave
-    MINIGAME_STATE_RESULTS,     // Showing results
-} minigame_state_t;
+    MINIGAME_WAVE = 0,          // Jump the Wave
+    MINIGAME_CATCH,             // Catch the Fish
+    MINIGAME_COUNT
+} minigame_id_t;
+
+/**
+ * @brief Outcome of a finished session
+ */
+typedef struct {
+    bool won;
+    uint16_t score;
+    uint16_t reaction_ms;       // Fastest reaction this session, 0 = none
+} minigame_result_t;
+
+/**
+ * @brief Lifecycle handlers of one mini-game
+ *
+ * Every handler gets the game's arena state. The state is zeroed before
+ * init and is gone once the session ends. init, update, input and result
+ * run on the simulation task and may only write the model; render gets
+ * the render copy, with the model as of the last minigame_publish().
+ */
+typedef struct {
+    const char *name;           // Shown in the game picker
+    size_t state_size;          // Arena bytes for the game's state
+    size_t model_size;          // Leading bytes written by update and input
+    uint32_t frame_budget_us;   // Updates + render per frame
+    void (*init)(void *state);
+    bool (*update)(void *state, uint32_t delta_ms);    // false once finished
+    void (*render)(void *state);
+    void (*input)(void *state, button_id_t button, button_event_t event);
+    void (*result)(const void *state, minigame_result_t *result);
+} minigame_vtable_t;
+
+extern const minigame_vtable_t minigame_wave;
+extern const minigame_vtable_t minigame_catch;
 
+/**
+ * @brief Frame time statistics of one game (all sessions since boot)
+ */
 typedef struct {
-    minigame_state_t state;
-    uint8_t round;              // Current round (1-3)
-    uint8_t max_rounds;         // Total rounds
-    uint8_t successes;          // Successful jumps
-    uint8_t failures;           // Missed jumps
-
-    // Wave timing
-    uint32_t wave_x;            // Wave X position (moves left)
-    uint32_t wave_speed;        // Pixels per update
-    bool wave_active;           // Wave is on screen
-
-    // Dolphin state
-    int32_t dolphin_y;          // Dolphin Y position
-    int32_t dolphin_vy;         // Dolphin vertical velocity
-    bool is_jumping;            // Currently in jump
-
-    // Timing
-    uint32_t start_time_ms;     // Round start time
-    uint32_t result_time_ms;    // Time showing result
-} minigame_t;
+    uint32_t frames;
+    uint32_t avg_us;
+    uint32_t max_us;
+    uint32_t over_budget;       // Frames slower than frame_budget_us
+    uint32_t budget_us;
+} minigame_stats_t;
 
 //=============================================================================
 // Public Functions
 //=============================================================================
 
 /**
- * @brief Initialize mini-game state
+ * @brief Initialize the mini-game framework
  */
 void minigame_init(void);
 
 /**
- * @brief Start a new mini-game session
+ * @brief Get a game's display name
  */
-void minigame_start(void);
+const char *minigame_name(minigame_id_t id);
 
 /**
- * @brief Update mini-game state
+ * @brief Start a session of a game
+ * @return false if the ID is invalid or its state does not fit the arena
+ */
+bool minigame_start(minigame_id_t id);
+
+/**
+ * @brief Update the running game
  * @param delta_ms Time since last update
- * @return true if game is still running, false if complete
+ * @return true if the game is still running, false once it has finished
  */
 bool minigame_update(uint32_t delta_ms);
 
 /**
- * @brief Handle input during mini-game
+ * @brief Handle input during the running game
  * @param button Which button
  * @param event What event
  */
 void minigame_handle_input(button_id_t button, button_event_t event);
 
 /**
- * @brief Render mini-game to display
+ * @brief Hand the running game's model to the render copy
+ *
+ * Simulation task, only while no frame is being drawn. The first publish
+ * of a session copies the whole state as init left it.
+ */
+void minigame_publish(void);
+
+/**
+ * @brief Render the game as last published and close its frame timing
  */
 void minigame_render(void);
 
 /**
- * @brief Check if game is complete
- * @return true if all rounds finished
+ * @brief Get the result of the last session
  */
-bool minigame_is_complete(void);
+void minigame_get_result(minigame_result_t *result);
 
 /**
- * @brief Check if player won overall
- * @return true if more successes than failures
+ * @brief Get the game that is running (or ran last)
+ */
+minigame_id_t minigame_current(void);
+
+/**
+ * @brief Allocate extra state for the running game
+ *
+ * Only valid from the game's init handler; freed when the session ends.
+ * Not mirrored to the render copy: for update and input only.
+ * @return 8-byte aligned, zeroed memory, NULL if the arena is full
  */
-bool minigame_is_win(void);
+void *minigame_arena_alloc(size_t size);
 
 /**
- * @brief Get current mini-game state
- * @return Pointer to state structure
+ * @brief Get a game's frame time statistics
  */
-const minigame_t *minigame_get_state(void);
+void minigame_get_stats(minigame_id_t id, minigame_stats_t *stats);
 
 #endif // MINIGAME_H
@@ -0,0 +1,133 @@
+/**
+ * @file obstacles.h
+ * @brief Mini-game obstacle pool and pattern spawner
+ *
+ * REQ-SW-062: Mini-game Obstacle Pool
+ * Waves, rocks and fish pickups live in a fixed struct-of-arrays pool
+ * kept sorted by X, so collision and render culling only visit the
+ * objects inside an X range. A spawner emits obstacle patterns whose
+ * choice and spacing scale with the difficulty level.
+ *
+ * No ESP-IDF dependencies: also built on the host for benchmarks.
+ */
+
+#ifndef OBSTACLES_H
+#define OBSTACLES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//=============================================================================
+// Pool
+//=============================================================================
+
+#define OBSTACLE_MAX        64      // Pool capacity
+#define OBSTACLE_MAX_W      32      // Widest kind (bounds the sorted sweep)
+#define OBSTACLE_FP_SHIFT   8       // Positions are Q8, like the physics
+
+typedef enum {
+    OBSTACLE_WAVE = 0,
+    OBSTACLE_ROCK,
+    OBSTACLE_FISH,              // Pickup
+    OBSTACLE_KIND_COUNT
+} obstacle_kind_t;
+
+typedef struct {
+    int16_t w, h;               // Pixels
+    bool harmful;               // Hit ends the round; otherwise a pickup
+} obstacle_kind_info_t;
+
+extern const obstacle_kind_info_t obstacle_kinds[OBSTACLE_KIND_COUNT];
+
+/**
+ * @brief Live obstacles, packed in [0, count) and sorted by x
+ */
+typedef struct {
+    uint16_t count;
+    uint8_t next_id;
+    int32_t x[OBSTACLE_MAX];        // Q8 left edge
+    int32_t x_prev[OBSTACLE_MAX];   // Q8 left edge at previous step
+    int32_t vx[OBSTACLE_MAX];       // Q8 pixels per step, leftwards
+    int16_t y[OBSTACLE_MAX];        // Top edge, pixels
+    uint8_t kind[OBSTACLE_MAX];     // obstacle_kind_t
+    uint8_t id[OBSTACLE_MAX];       // Stable while alive (for render tracking)
+} obstacle_pool_t;
+
+//=============================================================================
+// Spawner
+//=============================================================================
+
+typedef struct {
+    uint8_t level;              // Difficulty, 0 = easiest
+    uint8_t patterns_left;      // Patterns still to spawn
+    uint16_t cooldown;          // Steps until the next pattern
+    int16_t ground_y;           // Bottom edge of obstacles on the surface
+    int32_t speed;              // Q8 pixels per step
+    uint32_t (*rng)(void);      // Random source (sim_random on target)
+} obstacle_spawner_t;
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+/**
+ * @brief Remove all obstacles
+ */
+void obstacles_reset(obstacle_pool_t *pool);
+
+/**
+ * @brief Add an obstacle, keeping the pool sorted
+ * @param x Q8 left edge
+ * @param y Top edge in pixels
+ * @param vx Q8 pixels per step, leftwards
+ * @return Index of the new obstacle, -1 if the pool is full
+ */
+int obstacles_spawn(obstacle_pool_t *pool, obstacle_kind_t kind, int32_t x, int16_t y, int32_t vx);
+
+/**
+ * @brief Remove one obstacle (order of the rest is kept)
+ */
+void obstacles_remove(obstacle_pool_t *pool, int index);
+
+/**
+ * @brief Advance all obstacles by one step
+ *
+ * Obstacles whose right edge is left of cull_x are dropped.
+ * @param cull_x Pixels
+ */
+void obstacles_step(obstacle_pool_t *pool, int16_t cull_x);
+
+/**
+ * @brief Find obstacles overlapping the X range [x0, x1)
+ * @param out Output: indices, ascending
+ * @param max Capacity of out
+ * @return Number of indices written
+ */
+int obstacles_query(const obstacle_pool_t *pool, int16_t x0, int16_t x1, uint8_t *out, int max);
+
+/**
+ * @brief Start a round of patterns
+ * @param level Difficulty: unlocks patterns and tightens spacing
+ * @param patterns Patterns to spawn before the spawner is done
+ * @param ground_y Bottom edge of obstacles on the surface, pixels
+ * @param speed Q8 pixels per step for everything spawned
+ * @param rng Random source
+ */
+void obstacles_spawner_init(obstacle_spawner_t *spawner, uint8_t level, uint8_t patterns,
+                            int16_t ground_y, int32_t speed, uint32_t (*rng)(void));
+
+/**
+ * @brief Advance the spawner one step, spawning at spawn_x when due
+ * @param spawn_x Pixels (just off the right edge of the screen)
+ */
+void obstacles_spawner_step(obstacle_spawner_t *spawner, obstacle_pool_t *pool, int16_t spawn_x);
+
+/**
+ * @brief Check whether all patterns have been spawned
+ */
+static inline bool obstacles_spawner_done(const obstacle_spawner_t *spawner)
+{
+    return spawner->patterns_left == 0;
+}
+
+#endif // OBSTACLES_H
@@ -0,0 +1,154 @@
+/**
+ * @file replay.h
+ * @brief Input recording and deterministic replay for ESP32 Tamagotchi
+ *
+ * REQ-SW-051: Input Recording and Replay
+ * A recording holds the sim clock/PRNG state and pet state at its start,
+ * followed by every dispatched button event tagged with the sim tick it
+ * was handled on. Replaying restores the start state and feeds the events
+ * back on the same ticks, so the session plays out identically, at any
+ * speed, on the device or in a host build.
+ *
+ * The recording image (replay_get_data()) is a plain byte blob, so it can
+ * be stored in NVS, dumped over UART or loaded from a file.
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "input.h"
+#include "pet.h"
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define REPLAY_MAGIC        0x59504C52  // "RLPY"
+#define REPLAY_VERSION      1
+#define REPLAY_MAX_EVENTS   512
+
+//=============================================================================
+// Types
+//=============================================================================
+
+typedef enum {
+    REPLAY_IDLE = 0,
+    REPLAY_RECORDING,
+    REPLAY_PLAYING,
+} replay_mode_t;
+
+/**
+ * @brief Recording header
+ *
+ * The pet snapshot is stored as the in-memory struct, so a recording is
+ * only valid for the firmware build that made it (checked via pet_size).
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t magic;             // REPLAY_MAGIC
+    uint16_t version;           // REPLAY_VERSION
+    uint16_t tick_ms;           // SIM_TICK_MS of the recording build
+    uint32_t start_tick;        // Sim tick at recording start
+    uint32_t rng_state;         // PRNG state at recording start (seed)
+    uint32_t end_tick;          // Last tick covered by the recording
+    uint16_t event_count;
+    uint16_t pet_size;          // sizeof(pet_state_t)
+    pet_state_t pet;            // Pet at recording start
+} replay_header_t;
+
+/**
+ * @brief One recorded button event (8 bytes)
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t tick;              // Sim tick the event was dispatched on
+    uint8_t button;             // button_id_t
+    uint8_t event;              // button_event_t
+    uint16_t reserved;
+} replay_event_t;
+
+// Largest recording image (header + REPLAY_MAX_EVENTS), for static buffers
+#define REPLAY_MAX_SIZE     (sizeof(replay_header_t) + REPLAY_MAX_EVENTS * sizeof(replay_event_t))
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+/**
+ * @brief Start a new recording from the current sim and pet state
+ *
+ * Recordings start with the game on the splash screen (right after
+ * game_init()), which is the state replay_play_start() recreates.
+ */
+void replay_record_start(void);
+
+/**
+ * @brief Append a dispatched event (no-op unless recording)
+ * @param button Button
+ * @param event Event type
+ */
+void replay_record_event(button_id_t button, button_event_t event);
+
+/**
+ * @brief Stop recording or playback
+ */
+void replay_stop(void);
+
+/**
+ * @brief Restore the recording's start state and begin playback
+ *
+ * Restores the sim clock, PRNG and pet. Call game_init() afterwards so
+ * the game starts from the splash screen at the restored time.
+ * @return ESP_OK, or ESP_ERR_INVALID_STATE if no valid recording is loaded
+ */
+esp_err_t replay_play_start(void);
+
+/**
+ * @brief Get the next recorded event due on the current sim tick
+ * @param button Output: button
+ * @param event Output: event type
+ * @return true if an event was returned
+ */
+bool replay_next_event(button_id_t *button, button_event_t *event);
+
+/**
+ * @brief Check whether playback has reached the end of the recording
+ */
+bool replay_is_finished(void);
+
+/**
+ * @brief Get current mode
+ */
+replay_mode_t replay_get_mode(void);
+
+/**
+ * @brief Get the number of events in the recording (or loaded image)
+ *
+ * Only grows while recording and stops at REPLAY_MAX_EVENTS, so an
+ * unchanged count means an unchanged recording apart from its end tick.
+ */
+uint16_t replay_event_count(void);
+
+/**
+ * @brief Get the recording image
+ * @param len Output: image size in bytes
+ * @return Pointer to the image (valid until the next record/load call)
+ */
+const void *replay_get_data(size_t *len);
+
+/**
+ * @brief Get the maximum recording image size
+ */
+size_t replay_max_size(void);
+
+/**
+ * @brief Load a recording image (e.g. from NVS or a file)
+ * @param data Image from replay_get_data()
+ * @param len Image size
+ * @return ESP_OK, ESP_ERR_INVALID_SIZE or ESP_ERR_INVALID_VERSION
+ */
+esp_err_t replay_load_data(const void *data, size_t len);
+
+#endif // REPLAY_H
@@ -0,0 +1,126 @@
+/**
+ * @file settings.h
+ * @brief User settings for ESP32 Tamagotchi
+ *
+ * REQ-SW-018: Settings Screen
+ * Backlight, frame-rate cap, render mode, sound and power saver in one
+ * 8-byte record stored as its own NVS blob. Every change takes effect
+ * immediately; the record is written once when the settings screen is
+ * left. Like the leaderboard, settings belong to the device and survive
+ * a new pet.
+ */
+
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "display.h"
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define SETTINGS_MAGIC          0x5354      // "ST"
+#define SETTINGS_VERSION        1
+#define SETTINGS_NVS_KEY        "settings"
+
+// Defaults (config.h BRIGHTNESS_NORMAL, DIM_TIMEOUT_MS, ANIMATION_FPS_ACTIVE)
+#define SETTINGS_DEFAULT_BRIGHTNESS     200
+#define SETTINGS_DEFAULT_DIM_S          30
+#define SETTINGS_DEFAULT_FPS            30
+
+#define SETTINGS_BRIGHTNESS_DIM 50          // Backlight after the dim timeout
+#define SETTINGS_SAVER_FPS      10          // Frame cap outside mini-games
+#define SETTINGS_SAVER_DIM_S    10          // Dim timeout cap
+#define SETTINGS_SAVER_BRIGHTNESS 120       // Backlight cap
+
+// settings_t flags
+#define SETTINGS_FLAG_SOUND         (1 << 0)
+#define SETTINGS_FLAG_POWER_SAVER   (1 << 1)
+
+//=============================================================================
+// Types
+//=============================================================================
+
+/**
+ * @brief Stored record (8 bytes)
+ */
+typedef struct __attribute__((packed)) {
+    uint16_t magic;             // SETTINGS_MAGIC
+    uint8_t version;            // SETTINGS_VERSION
+    uint8_t brightness;         // Backlight duty, 0-255
+    uint8_t dim_timeout_s;      // Idle time before dimming, 0 = never
+    uint8_t fps_cap;            // Rendered frames per second
+    uint8_t render_mode;        // display_render_mode_t
+    uint8_t flags;              // SETTINGS_FLAG_*
+} settings_t;
+
+/**
+ * @brief Settings screen rows
+ */
+typedef enum {
+    SETTINGS_ITEM_BRIGHTNESS = 0,
+    SETTINGS_ITEM_DIM_TIMEOUT,
+    SETTINGS_ITEM_FPS_CAP,
+    SETTINGS_ITEM_RENDER_MODE,
+    SETTINGS_ITEM_SOUND,
+    SETTINGS_ITEM_POWER_SAVER,
+    SETTINGS_ITEM_COUNT
+} settings_item_t;
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+/**
+ * @brief Load the record from NVS and apply it (call after save_manager_init())
+ *
+ * A missing or unreadable record falls back to the defaults.
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if nothing was stored
+ */
+esp_err_t settings_load(void);
+
+/**
+ * @brief Get the current settings
+ */
+const settings_t *settings_get(void);
+
+/**
+ * @brief Step one setting to its next value and apply it
+ * @return ESP_OK, or the display error if the next render mode could not
+ *         be selected (the current one stays)
+ */
+esp_err_t settings_cycle(settings_item_t item);
+
+/**
+ * @brief Get a setting's label for the settings screen
+ */
+const char *settings_item_name(settings_item_t item);
+
+/**
+ * @brief Format a setting's current value for the settings screen
+ */
+void settings_item_value(settings_item_t item, char *buf, size_t len);
+
+/**
+ * @brief Write the record to NVS if it changed since the last flush
+ * @return ESP_OK on success or when there was nothing to write
+ */
+esp_err_t settings_flush(void);
+
+/**
+ * @brief Minimum time between rendered frames
+ * @param in_minigame A mini-game is running (power saver leaves it alone)
+ */
+uint32_t settings_frame_interval_ms(bool in_minigame);
+
+/**
+ * @brief Dim or restore the backlight (call every frame)
+ * @param idle_ms Time since the last button event
+ */
+void settings_update_backlight(uint32_t idle_ms);
+
+#endif // SETTINGS_H
@@ -0,0 +1,131 @@
+/**
+ * @file ui.h
+ * @brief Retained-mode widget layer for ESP32 Tamagotchi screens
+ *
+ * REQ-SW-036: UI Widgets
+ * A screen is declared as a const array of widget definitions (panel,
+ * label, progress bar, icon, grid menu, list). ui_screen_init() lays it
+ * out once into a slice of a fixed node pool; afterwards the screen code
+ * only sets values, and ui_render() draws the widgets whose value changed
+ * (for menus: just the old and new selected cell). Widgets draw in
+ * declaration order, so later widgets sit on top of earlier ones.
+ */
+
+#ifndef UI_H
+#define UI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define UI_MAX_NODES        48      // Widgets across all screens
+#define UI_TEXT_MAX         32      // Label text incl. terminator
+
+// Node pool (REQ-SW-039): per node 16 bytes of fields, the icon sprite
+// pointer and the label text
+#define UI_RAM_BYTES        (UI_MAX_NODES * (16 + sizeof(void *) + UI_TEXT_MAX))
+
+#define UI_CHAR_W           6       // Built-in font cell
+#define UI_CHAR_H           8
+
+//=============================================================================
+// Types
+//=============================================================================
+
+typedef enum {
+    UI_PANEL,       // Filled box, border in fg (fg == bg: no border)
+    UI_LABEL,       // Text; w = minimum width cleared on change (0: text only)
+    UI_BAR,         // Horizontal bar, value 0-100 filled in fg over bg
+    UI_ICON,        // Sprite w x h at scale, drawn over bg
+    UI_GRID,        // Menu of items in cols columns, value = selected item
+    UI_LIST,        // Grid with one column
+} ui_widget_type_t;
+
+/**
+ * @brief Widget declaration (const, part of a screen table)
+ */
+typedef struct {
+    ui_widget_type_t type;
+    int16_t x, y, w, h;             // Grid/list: whole item area
+    uint16_t fg, bg;                // Grid/list: unselected item colours
+    uint8_t scale;                  // Label text / icon scale (0 = 1)
+    const char *text;               // Label: initial text
+    // Grid and list
+    const char *const *items;       // Item labels
+    uint8_t count;
+    uint8_t cols;                   // Grid columns
+    int16_t item_h;                 // Row pitch
+    uint8_t gap;                    // Space between cells (right and below)
+    uint8_t pad_x, pad_y;           // Text offset inside a cell
+    uint16_t sel_fg, sel_bg;        // Selected item colours
+} ui_widget_def_t;
+
+typedef struct ui_node ui_node_t;
+
+/**
+ * @brief A laid-out screen (slice of the node pool)
+ */
+typedef struct {
+    const ui_widget_def_t *defs;
+    ui_node_t *nodes;               // NULL until ui_screen_init()
+    uint8_t count;
+} ui_screen_t;
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+/**
+ * @brief Lay out a screen into the node pool (no-op if already laid out)
+ * @return ESP_OK, ESP_ERR_NO_MEM if UI_MAX_NODES would be exceeded
+ */
+esp_err_t ui_screen_init(ui_screen_t *screen, const ui_widget_def_t *defs, uint8_t count);
+
+/**
+ * @brief Mark every widget of a screen for redraw (after something else
+ *        painted over it)
+ */
+void ui_invalidate(ui_screen_t *screen);
+
+/**
+ * @brief Draw the widgets that changed since the last ui_render()
+ * @return Number of widgets drawn
+ */
+int ui_render(ui_screen_t *screen);
+
+/**
+ * @brief Set a label's text (no redraw if unchanged)
+ */
+void ui_set_text(ui_screen_t *screen, uint8_t id, const char *text);
+
+/**
+ * @brief Set a label's text from a format string
+ */
+void ui_set_textf(ui_screen_t *screen, uint8_t id, const char *fmt, ...)
+    __attribute__((format(printf, 3, 4)));
+
+/**
+ * @brief Set a bar's level or a grid/list selection
+ */
+void ui_set_value(ui_screen_t *screen, uint8_t id, int16_t value);
+
+/**
+ * @brief Set a label's or bar's foreground colour
+ */
+void ui_set_color(ui_screen_t *screen, uint8_t id, uint16_t fg);
+
+/**
+ * @brief Set an icon's sprite (RGB565, SPRITE_TRANSPARENT keyed)
+ */
+void ui_set_icon(ui_screen_t *screen, uint8_t id, const uint16_t *pixels);
+
+/**
+ * @brief Log node pool usage (fixed at compile time)
+ */
+void ui_report_memory(void);
+
+#endif // UI_H
@@ -0,0 +1,74 @@
+/**
+ * @file wave_game.h
+ * @brief "Jump the Wave" mini-game for ESP32 Tamagotchi
+ *
+ * REQ-SW-004: Play Mechanic
+ * REQ-SW-060: Fixed-Timestep Mini-game Physics
+ * REQ-SW-062: Mini-game Obstacle Pool
+ * Reaction game: the dolphin jumps over waves and rocks and catches fish.
+ * Each round spawns more obstacle patterns, faster and closer together.
+ * Physics runs in fixed MINIGAME_STEP_MS steps on Q8 fixed-point
+ * positions; rendering interpolates between the last two steps.
+ *
+ * Runs through the mini-game framework (minigame_wave in minigame.h).
+ */
+
+#ifndef WAVE_GAME_H
+#define WAVE_GAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "minigame.h"
+#include "obstacles.h"
+
+//=============================================================================
+// Game State
+//=============================================================================
+
+typedef enum {
+    WAVE_STATE_READY,           // Waiting to start
+    WAVE_STATE_PLAYING,         // Game in progress
+    WAVE_STATE_SUCCESS,         // Round survived
+    WAVE_STATE_FAIL,            // Hit an obstacle
+    WAVE_STATE_RESULTS,         // Showing results
+} wave_state_t;
+
+typedef struct {
+    wave_state_t state;
+    uint8_t round;              // Current round (1-3)
+    uint8_t max_rounds;         // Total rounds
+    uint8_t successes;          // Rounds survived
+    uint8_t failures;           // Rounds ended by a hit
+    uint8_t fish;               // Fish caught
+    uint16_t score;             // Points for rounds survived and fish
+
+    // Obstacles (Q8 fixed point)
+    obstacle_pool_t obstacles;
+    obstacle_spawner_t spawner;
+
+    // Dolphin (Q8 fixed point)
+    int32_t dolphin_y;          // Dolphin Y position
+    int32_t dolphin_y_prev;     // Dolphin Y at previous step
+    int32_t dolphin_vy;         // Q8 pixels per step
+    bool is_jumping;            // Currently in jump
+
+    // Fixed timestep
+    uint32_t accum_ms;          // Time not yet simulated (< MINIGAME_STEP_MS)
+    uint32_t steps;             // Physics steps this session
+
+    // Reaction: from a hazard becoming the next one on screen to the jump
+    // that clears it
+    bool next_valid;
+    uint8_t next_id;            // Next hazard ahead of the dolphin
+    uint32_t next_step;         // Step it became the next hazard
+    bool jump_pending;          // Jump made, its hazard not yet passed
+    uint8_t jump_id;
+    uint16_t jump_ms;
+    uint16_t best_reaction_ms;  // Fastest cleared hazard, 0 = none
+
+    // Timing
+    uint32_t start_time_ms;     // Round start time
+    uint32_t result_time_ms;    // Time showing result
+} wave_game_t;
+
+#endif // WAVE_GAME_H
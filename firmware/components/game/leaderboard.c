@@ -0,0 +1,117 @@
+/**
+ * @file leaderboard.c
+ * @brief Per-minigame high scores and statistics implementation
+ *
+ * REQ-SW-065: Mini-game Leaderboard
+ */
+
+#include "leaderboard.h"
+#include "save_manager.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char *TAG = "leaderboard";
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+static leaderboard_record_t s_record;
+static bool s_dirty = false;    // Changed since the last flush
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+static void reset_record(void)
+{
+    memset(&s_record, 0, sizeof(s_record));
+    s_record.magic = LEADERBOARD_MAGIC;
+    s_record.version = LEADERBOARD_VERSION;
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+esp_err_t leaderboard_load(void)
+{
+    size_t len = sizeof(s_record);
+    esp_err_t ret = save_manager_read_blob(LEADERBOARD_NVS_KEY, &s_record, &len);
+    s_dirty = false;
+
+    if (ret == ESP_ERR_NOT_FOUND) {
+        ESP_LOGI(TAG, "No leaderboard stored, starting empty");
+        reset_record();
+        return ret;
+    }
+    if (ret != ESP_OK || len != sizeof(s_record) ||
+        s_record.magic != LEADERBOARD_MAGIC || s_record.version != LEADERBOARD_VERSION) {
+        ESP_LOGW(TAG, "Stored leaderboard unusable (%s, %u bytes), starting empty",
+                 esp_err_to_name(ret), (unsigned)len);
+        reset_record();
+        return (ret != ESP_OK) ? ret : ESP_ERR_INVALID_VERSION;
+    }
+
+    for (int i = 0; i < MINIGAME_COUNT; i++) {
+        const leaderboard_entry_t *e = &s_record.entries[i];
+        ESP_LOGI(TAG, "%s: best %u, won %u/%u, best streak %u",
+                 minigame_name((minigame_id_t)i), e->best_score, e->wins, e->plays, e->best_streak);
+    }
+    return ESP_OK;
+}
+
+uint8_t leaderboard_record(minigame_id_t id, const minigame_result_t *result)
+{
+    if (id >= MINIGAME_COUNT) return 0;
+
+    leaderboard_entry_t *e = &s_record.entries[id];
+    uint8_t flags = 0;
+
+    if (e->plays < UINT16_MAX) e->plays++;
+    e->last_score = result->score;
+
+    if (result->won) {
+        if (e->wins < UINT16_MAX) e->wins++;
+        if (e->streak < UINT8_MAX) e->streak++;
+        if (e->streak > e->best_streak) {
+            e->best_streak = e->streak;
+            flags |= LEADERBOARD_NEW_STREAK;
+        }
+    } else {
+        e->streak = 0;
+    }
+
+    if (result->score > e->best_score) {
+        e->best_score = result->score;
+        flags |= LEADERBOARD_NEW_SCORE;
+    }
+
+    if (result->reaction_ms != 0 &&
+        (e->best_reaction_ms == 0 || result->reaction_ms < e->best_reaction_ms)) {
+        e->best_reaction_ms = result->reaction_ms;
+        flags |= LEADERBOARD_NEW_REACTION;
+    }
+
+    s_dirty = true;
+    return flags;
+}
+
+esp_err_t leaderboard_flush(void)
+{
+    if (!s_dirty) return ESP_OK;
+
+    esp_err_t ret = save_manager_write_blob(LEADERBOARD_NVS_KEY, &s_record, sizeof(s_record));
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to store leaderboard: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    s_dirty = false;
+    return ESP_OK;
+}
+
+const leaderboard_entry_t *leaderboard_get(minigame_id_t id)
+{
+    if (id >= MINIGAME_COUNT) return NULL;
+    return &s_record.entries[id];
+}
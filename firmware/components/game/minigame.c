@@ -1,17 +1,22 @@
 /**
  * @file minigame.c
- * @brief "Jump the Wave" mini-game implementation
+ * @brief Mini-game framework implementation
  *
  * REQ-SW-004: Play Mechanic
- * A wave scrolls across the screen. Press the button at the right time
- * to make the dolphin jump over it.
+ * REQ-SW-064: Mini-game Plugin Framework
+ * Games are looked up in a static registry. Starting one resets the
+ * shared arena and carves the game's state from it, so the largest game
+ * sets the RAM cost. Frame time is the wall time of the updates since the
+ * last render plus the render itself.
+ *
+ * REQ-SW-037: Multi-task Runtime
+ * s_arena belongs to the simulation task, s_render_arena to the render
+ * task. A publish happens between frames only (the runtime hands frames
+ * over with a sequence counter), so neither arena needs a lock.
  */
 
 #include "minigame.h"
-#include "display.h"
-#include "sprites.h"
 #include "esp_timer.h"
-#include "esp_random.h"
 #include "esp_log.h"
 #include <string.h>
 
@@ -21,87 +26,67 @@ static const char *TAG = "minigame";
 // Constants
 //=============================================================================
 
-#define SCREEN_W            240
-#define SCREEN_H            135
+#define ARENA_ALIGN         8
 
-#define DOLPHIN_X           60
-#define DOLPHIN_GROUND_Y    90
-#define DOLPHIN_W           32
-#define DOLPHIN_H           24
+//=============================================================================
+// Static State
+//=============================================================================
 
-#define WAVE_START_X        (SCREEN_W + 20)
-#define WAVE_GROUND_Y       95
-#define WAVE_W              32
-#define WAVE_H              16
+static const minigame_vtable_t *const s_games[MINIGAME_COUNT] = {
+    [MINIGAME_WAVE] = &minigame_wave,
+    [MINIGAME_CATCH] = &minigame_catch,
+};
 
-#define JUMP_VELOCITY       -8
-#define GRAVITY             1
-#define WAVE_SPEED_MIN      3
-#define WAVE_SPEED_MAX      5
+static uint8_t s_arena[MINIGAME_ARENA_SIZE] __attribute__((aligned(ARENA_ALIGN)));
+static size_t s_arena_used = 0;
 
-#define JUMP_ZONE_START     (DOLPHIN_X - 10)
-#define JUMP_ZONE_END       (DOLPHIN_X + DOLPHIN_W + 10)
+static minigame_id_t s_current = MINIGAME_WAVE;
+static void *s_state = NULL;                    // NULL: no session running
+static minigame_result_t s_result = {0};
+static uint32_t s_session = 0;                  // Sessions started since boot
 
-#define RESULT_DISPLAY_MS   1500
-#define MAX_ROUNDS          3
+// Render side: the running game as last published
+static uint8_t s_render_arena[MINIGAME_ARENA_SIZE] __attribute__((aligned(ARENA_ALIGN)));
+static minigame_id_t s_render_game = MINIGAME_WAVE;
+static void *s_render_state = NULL;             // NULL: nothing to draw
+static uint32_t s_render_session = 0;           // Session copied in whole
+static uint32_t s_render_update_us = 0;         // Update time of the published frame
 
-// Colors
-#define COLOR_BG            0x5D9F  // Light ocean
-#define COLOR_BG_DARK       0x2B4D  // Dark ocean
-#define COLOR_WAVE          0xFFFF  // White foam
-#define COLOR_WAVE_DARK     0x07FF  // Cyan water
-#define COLOR_TEXT          0xFFFF
-#define COLOR_SUCCESS       0x07E0
-#define COLOR_FAIL          0xF800
+_Static_assert(sizeof(s_arena) + sizeof(s_render_arena) == MINIGAME_RAM_BYTES,
+               "mini-game arenas outside their budget");
 
-//=============================================================================
-// Static State
-//=============================================================================
+// Frame timing
+typedef struct {
+    uint32_t frames;
+    uint64_t total_us;
+    uint32_t max_us;
+    uint32_t over_budget;
+} frame_stats_t;
 
-static minigame_t s_game = {0};
+static frame_stats_t s_stats[MINIGAME_COUNT];
+static uint32_t s_frame_us = 0;                 // Update time since the last publish
 
 //=============================================================================
 // Helper Functions
 //=============================================================================
 
-static inline uint32_t get_ms(void)
-{
-    return (uint32_t)(esp_timer_get_time() / 1000);
-}
-
-static void start_round(void)
+static void record_frame(minigame_id_t id, uint32_t us)
 {
-    s_game.state = MINIGAME_STATE_PLAYING;
-    s_game.wave_x = WAVE_START_X;
-    s_game.wave_speed = WAVE_SPEED_MIN + (esp_random() % (WAVE_SPEED_MAX - WAVE_SPEED_MIN + 1));
-    s_game.wave_active = true;
-    s_game.dolphin_y = DOLPHIN_GROUND_Y;
-    s_game.dolphin_vy = 0;
-    s_game.is_jumping = false;
-    s_game.start_time_ms = get_ms();
-
-    ESP_LOGI(TAG, "Round %d started, wave speed: %lu",
-             s_game.round, (unsigned long)s_game.wave_speed);
+    frame_stats_t *st = &s_stats[id];
+    st->frames++;
+    st->total_us += us;
+    if (us > st->max_us) st->max_us = us;
+    if (us > s_games[id]->frame_budget_us) st->over_budget++;
 }
 
-static bool check_collision(void)
+static void log_stats(minigame_id_t id)
 {
-    // Simple box collision between dolphin and wave
-    int dolphin_left = DOLPHIN_X;
-    int dolphin_right = DOLPHIN_X + DOLPHIN_W;
-    int dolphin_bottom = s_game.dolphin_y + DOLPHIN_H;
-
-    int wave_left = s_game.wave_x;
-    int wave_right = s_game.wave_x + WAVE_W;
-    int wave_top = WAVE_GROUND_Y - WAVE_H;
-
-    // Check overlap
-    if (dolphin_right > wave_left && dolphin_left < wave_right) {
-        if (dolphin_bottom > wave_top) {
-            return true;  // Collision!
-        }
-    }
-    return false;
+    minigame_stats_t st;
+    minigame_get_stats(id, &st);
+    ESP_LOGI(TAG, "%s: %lu frames, avg %lu us, max %lu us, %lu over the %lu us budget",
+             s_games[id]->name, (unsigned long)st.frames, (unsigned long)st.avg_us,
+             (unsigned long)st.max_us, (unsigned long)st.over_budget,
+             (unsigned long)st.budget_us);
 }
 
 //=============================================================================
@@ -110,160 +95,136 @@ static bool check_collision(void)
 
 void minigame_init(void)
 {
-    memset(&s_game, 0, sizeof(s_game));
-    s_game.state = MINIGAME_STATE_READY;
-    s_game.max_rounds = MAX_ROUNDS;
+    s_state = NULL;
+    s_current = MINIGAME_WAVE;
+    s_arena_used = 0;
+    s_render_state = NULL;
+    s_render_session = s_session;
+    memset(&s_result, 0, sizeof(s_result));
+    memset(s_stats, 0, sizeof(s_stats));
+
+    size_t largest = 0;
+    for (int i = 0; i < MINIGAME_COUNT; i++) {
+        if (s_games[i]->state_size > largest) largest = s_games[i]->state_size;
+    }
+    ESP_LOGI(TAG, "%d games, arena %d bytes (largest state %u)",
+             MINIGAME_COUNT, MINIGAME_ARENA_SIZE, (unsigned)largest);
 }
 
-void minigame_start(void)
+const char *minigame_name(minigame_id_t id)
 {
-    ESP_LOGI(TAG, "Starting mini-game");
-    memset(&s_game, 0, sizeof(s_game));
-    s_game.state = MINIGAME_STATE_READY;
-    s_game.round = 1;
-    s_game.max_rounds = MAX_ROUNDS;
-    start_round();
+    if (id >= MINIGAME_COUNT) return "?";
+    return s_games[id]->name;
 }
 
-bool minigame_update(uint32_t delta_ms)
+bool minigame_start(minigame_id_t id)
 {
-    if (s_game.state == MINIGAME_STATE_RESULTS) {
-        // Check if result display time is over
-        if (get_ms() - s_game.result_time_ms > RESULT_DISPLAY_MS) {
-            if (s_game.round >= s_game.max_rounds) {
-                // Game over
-                return false;
-            }
-            // Start next round
-            s_game.round++;
-            start_round();
-        }
-        return true;
+    if (id >= MINIGAME_COUNT) return false;
+
+    // Previous session's state is dropped with the arena
+    s_state = NULL;
+    s_arena_used = 0;
+    s_current = id;
+
+    void *state = minigame_arena_alloc(s_games[id]->state_size);
+    if (state == NULL) {
+        ESP_LOGE(TAG, "%s needs %u bytes, arena has %d",
+                 s_games[id]->name, (unsigned)s_games[id]->state_size, MINIGAME_ARENA_SIZE);
+        return false;
     }
 
-    if (s_game.state != MINIGAME_STATE_PLAYING) {
-        return true;
-    }
+    s_state = state;
+    s_frame_us = 0;
+    s_session++;
+    memset(&s_result, 0, sizeof(s_result));
+    ESP_LOGI(TAG, "Starting %s", s_games[id]->name);
+    s_games[id]->init(s_state);
+    return true;
+}
 
-    // Update dolphin physics
-    if (s_game.is_jumping) {
-        s_game.dolphin_vy += GRAVITY;
-        s_game.dolphin_y += s_game.dolphin_vy;
-
-        // Land on ground
-        if (s_game.dolphin_y >= DOLPHIN_GROUND_Y) {
-            s_game.dolphin_y = DOLPHIN_GROUND_Y;
-            s_game.dolphin_vy = 0;
-            s_game.is_jumping = false;
-        }
-    }
+bool minigame_update(uint32_t delta_ms)
+{
+    if (s_state == NULL) return false;
 
-    // Update wave position
-    if (s_game.wave_active) {
-        s_game.wave_x -= s_game.wave_speed;
-
-        // Check if wave hit dolphin
-        if (check_collision()) {
-            // Fail!
-            s_game.state = MINIGAME_STATE_FAIL;
-            s_game.failures++;
-            s_game.result_time_ms = get_ms();
-            ESP_LOGI(TAG, "Round %d: FAIL", s_game.round);
-            return true;
-        }
-
-        // Check if wave passed
-        if (s_game.wave_x + WAVE_W < DOLPHIN_X) {
-            // Success!
-            s_game.state = MINIGAME_STATE_SUCCESS;
-            s_game.successes++;
-            s_game.result_time_ms = get_ms();
-            ESP_LOGI(TAG, "Round %d: SUCCESS", s_game.round);
-            return true;
-        }
-    }
+    int64_t start = esp_timer_get_time();
+    bool running = s_games[s_current]->update(s_state, delta_ms);
+    s_frame_us += (uint32_t)(esp_timer_get_time() - start);
 
-    return true;
+    if (!running) {
+        s_games[s_current]->result(s_state, &s_result);
+        s_state = NULL;
+    }
+    return running;
 }
 
 void minigame_handle_input(button_id_t button, button_event_t event)
 {
-    if (event != BUTTON_EVENT_CLICK) return;
-
-    if (s_game.state == MINIGAME_STATE_PLAYING) {
-        if (!s_game.is_jumping) {
-            // Jump!
-            s_game.is_jumping = true;
-            s_game.dolphin_vy = JUMP_VELOCITY;
-            ESP_LOGD(TAG, "Jump!");
-        }
-    }
+    if (s_state == NULL) return;
+    s_games[s_current]->input(s_state, button, event);
 }
 
-void minigame_render(void)
+void minigame_publish(void)
 {
-    // Ocean background gradient
-    for (int y = 0; y < SCREEN_H; y++) {
-        uint16_t color = (y < SCREEN_H / 2) ? COLOR_BG : COLOR_BG_DARK;
-        display_draw_hline(0, y, SCREEN_W, color);
+    if (s_state == NULL) {
+        // Session over: render is idle, so its frame stats are settled
+        if (s_render_state != NULL) log_stats(s_render_game);
+        s_render_state = NULL;
+        return;
     }
 
-    // Water line
-    display_draw_hline(0, WAVE_GROUND_Y + 5, SCREEN_W, COLOR_WAVE_DARK);
-
-    // Round indicator
-    char buf[16];
-    snprintf(buf, sizeof(buf), "Round %d/%d", s_game.round, s_game.max_rounds);
-    display_draw_string(5, 5, buf, COLOR_TEXT, COLOR_BG, 1);
-
-    // Score
-    snprintf(buf, sizeof(buf), "Score: %d", s_game.successes);
-    display_draw_string(SCREEN_W - 70, 5, buf, COLOR_TEXT, COLOR_BG, 1);
-
-    // Draw wave
-    if (s_game.wave_active && s_game.wave_x < SCREEN_W && s_game.wave_x + WAVE_W > 0) {
-        // Simple wave shape
-        int wx = s_game.wave_x;
-        int wy = WAVE_GROUND_Y - WAVE_H;
-
-        // Wave body
-        display_fill_rect(wx, wy + 8, WAVE_W, WAVE_H - 8, COLOR_WAVE_DARK);
-        // Foam crest
-        display_fill_rect(wx + 4, wy, WAVE_W - 8, 10, COLOR_WAVE);
-        display_fill_rect(wx + 8, wy - 4, WAVE_W - 16, 6, COLOR_WAVE);
+    // States are the first allocation, so both copies start the arena
+    const minigame_vtable_t *game = s_games[s_current];
+    if (s_render_session != s_session) {
+        memcpy(s_render_arena, s_state, game->state_size);
+        s_render_session = s_session;
+    } else {
+        memcpy(s_render_arena, s_state, game->model_size);
     }
+    s_render_game = s_current;
+    s_render_state = s_render_arena;
+    s_render_update_us = s_frame_us;
+    s_frame_us = 0;
+}
 
-    // Draw dolphin
-    int w, h;
-    const uint16_t *sprite = sprites_get_idle_frame(1, 0, &w, &h);  // Baby frame
-    display_draw_sprite_scaled(DOLPHIN_X, s_game.dolphin_y, w, h, sprite, SPRITE_TRANSPARENT, 2);
+void minigame_render(void)
+{
+    if (s_render_state == NULL) return;
 
-    // Draw result overlay
-    if (s_game.state == MINIGAME_STATE_SUCCESS) {
-        display_draw_string(80, 50, "NICE!", COLOR_SUCCESS, COLOR_BG, 2);
-    } else if (s_game.state == MINIGAME_STATE_FAIL) {
-        display_draw_string(80, 50, "OOPS!", COLOR_FAIL, COLOR_BG, 2);
-    }
+    int64_t start = esp_timer_get_time();
+    s_games[s_render_game]->render(s_render_state);
+    record_frame(s_render_game, s_render_update_us + (uint32_t)(esp_timer_get_time() - start));
+    s_render_update_us = 0;
+}
 
-    // Instructions
-    if (s_game.state == MINIGAME_STATE_PLAYING) {
-        display_draw_string(60, SCREEN_H - 15, "Press to JUMP!", COLOR_TEXT, COLOR_BG_DARK, 1);
-    }
+void minigame_get_result(minigame_result_t *result)
+{
+    *result = s_result;
 }
 
-bool minigame_is_complete(void)
+minigame_id_t minigame_current(void)
 {
-    return s_game.round >= s_game.max_rounds &&
-           (s_game.state == MINIGAME_STATE_SUCCESS ||
-            s_game.state == MINIGAME_STATE_FAIL);
+    return s_current;
 }
 
-bool minigame_is_win(void)
+void *minigame_arena_alloc(size_t size)
 {
-    return s_game.successes > s_game.failures;
+    size_t offset = (s_arena_used + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    if (offset > MINIGAME_ARENA_SIZE || size > MINIGAME_ARENA_SIZE - offset) return NULL;
+
+    s_arena_used = offset + size;
+    memset(&s_arena[offset], 0, size);
+    return &s_arena[offset];
 }
 
-const minigame_t *minigame_get_state(void)
+void minigame_get_stats(minigame_id_t id, minigame_stats_t *stats)
 {
-    return &s_game;
+    memset(stats, 0, sizeof(*stats));
+    if (id >= MINIGAME_COUNT) return;
+
+    const frame_stats_t *st = &s_stats[id];
+    stats->frames = st->frames;
+    stats->avg_us = st->frames ? (uint32_t)(st->total_us / st->frames) : 0;
+    stats->max_us = st->max_us;
+    stats->over_budget = st->over_budget;
+    stats->budget_us = s_games[id]->frame_budget_us;
 }
@@ -0,0 +1,234 @@
+/**
+ * @file obstacles.c
+ * @brief Mini-game obstacle pool and pattern spawner
+ *
+ * REQ-SW-062: Mini-game Obstacle Pool
+ * All obstacles scroll left at nearly the same speed, so the pool stays
+ * almost sorted between steps; one insertion-sort pass per step restores
+ * the order in O(n). Queries binary-search the first candidate and stop at
+ * the first obstacle starting past the range.
+ */
+
+#include "obstacles.h"
+#include "sprites.h"
+#include <string.h>
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define PX(q8)              ((q8) >> OBSTACLE_FP_SHIFT)
+
+#define PATTERN_GAP_PX      150     // Free water after a pattern at level 0
+#define PATTERN_GAP_STEP_PX 15      // Gap shrinks this much per level
+#define PATTERN_GAP_MIN_PX  90
+#define PATTERN_JITTER_PX   40      // Random extra gap
+#define PATTERN_ITEMS_MAX   4
+
+const obstacle_kind_info_t obstacle_kinds[OBSTACLE_KIND_COUNT] = {
+    [OBSTACLE_WAVE] = { WAVE_W, WAVE_H, true },
+    [OBSTACLE_ROCK] = { ROCK_W, ROCK_H, true },
+    [OBSTACLE_FISH] = { FOOD_FISH_W, FOOD_FISH_H, false },
+};
+
+typedef struct {
+    uint8_t kind;
+    int16_t dx;                 // From the pattern start, pixels
+    int16_t lift;               // Bottom edge above ground, pixels
+} spawn_item_t;
+
+typedef struct {
+    uint8_t min_level;
+    uint8_t count;
+    spawn_item_t items[PATTERN_ITEMS_MAX];
+} spawn_pattern_t;
+
+// Hazards in one pattern are at least a jump and a landing apart
+static const spawn_pattern_t s_patterns[] = {
+    { 0, 1, { { OBSTACLE_WAVE, 0, 0 } } },
+    { 0, 1, { { OBSTACLE_ROCK, 0, 0 } } },
+    { 0, 2, { { OBSTACLE_WAVE, 0, 0 }, { OBSTACLE_FISH, 8, 34 } } },
+    { 0, 1, { { OBSTACLE_FISH, 0, 24 } } },
+    { 1, 3, { { OBSTACLE_ROCK, 0, 0 }, { OBSTACLE_FISH, 4, 30 }, { OBSTACLE_WAVE, 200, 0 } } },
+    { 1, 3, { { OBSTACLE_FISH, 0, 20 }, { OBSTACLE_FISH, 22, 34 }, { OBSTACLE_FISH, 44, 20 } } },
+    { 2, 3, { { OBSTACLE_WAVE, 0, 0 }, { OBSTACLE_ROCK, 200, 0 }, { OBSTACLE_FISH, 204, 30 } } },
+    { 2, 3, { { OBSTACLE_WAVE, 0, 0 }, { OBSTACLE_WAVE, 200, 0 }, { OBSTACLE_WAVE, 400, 0 } } },
+};
+
+#define PATTERN_COUNT       (sizeof(s_patterns) / sizeof(s_patterns[0]))
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+static void move_entry(obstacle_pool_t *pool, int to, int from)
+{
+    pool->x[to] = pool->x[from];
+    pool->x_prev[to] = pool->x_prev[from];
+    pool->vx[to] = pool->vx[from];
+    pool->y[to] = pool->y[from];
+    pool->kind[to] = pool->kind[from];
+    pool->id[to] = pool->id[from];
+}
+
+/**
+ * @brief Move entry i left until the pool is sorted again
+ * @return Final index of the entry
+ */
+static int sift_down(obstacle_pool_t *pool, int i)
+{
+    if (i == 0 || pool->x[i - 1] <= pool->x[i]) return i;
+
+    int32_t x = pool->x[i], x_prev = pool->x_prev[i], vx = pool->vx[i];
+    int16_t y = pool->y[i];
+    uint8_t kind = pool->kind[i], id = pool->id[i];
+
+    while (i > 0 && pool->x[i - 1] > x) {
+        move_entry(pool, i, i - 1);
+        i--;
+    }
+
+    pool->x[i] = x;
+    pool->x_prev[i] = x_prev;
+    pool->vx[i] = vx;
+    pool->y[i] = y;
+    pool->kind[i] = kind;
+    pool->id[i] = id;
+    return i;
+}
+
+static int pattern_width(const spawn_pattern_t *pattern)
+{
+    int width = 0;
+    for (int i = 0; i < pattern->count; i++) {
+        int right = pattern->items[i].dx + obstacle_kinds[pattern->items[i].kind].w;
+        if (right > width) width = right;
+    }
+    return width;
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+void obstacles_reset(obstacle_pool_t *pool)
+{
+    memset(pool, 0, sizeof(*pool));
+}
+
+int obstacles_spawn(obstacle_pool_t *pool, obstacle_kind_t kind, int32_t x, int16_t y, int32_t vx)
+{
+    if (pool->count >= OBSTACLE_MAX) return -1;
+
+    int i = pool->count++;
+    pool->x[i] = x;
+    pool->x_prev[i] = x;
+    pool->vx[i] = vx;
+    pool->y[i] = y;
+    pool->kind[i] = kind;
+    pool->id[i] = pool->next_id++;
+    return sift_down(pool, i);
+}
+
+void obstacles_remove(obstacle_pool_t *pool, int index)
+{
+    if (index < 0 || index >= pool->count) return;
+    for (int i = index + 1; i < pool->count; i++) {
+        move_entry(pool, i - 1, i);
+    }
+    pool->count--;
+}
+
+void obstacles_step(obstacle_pool_t *pool, int16_t cull_x)
+{
+    int out = 0;
+    for (int i = 0; i < pool->count; i++) {
+        pool->x_prev[i] = pool->x[i];
+        pool->x[i] -= pool->vx[i];
+
+        // Drop what has scrolled off (stable compaction)
+        if (PX(pool->x[i]) + obstacle_kinds[pool->kind[i]].w < cull_x) continue;
+        if (out != i) move_entry(pool, out, i);
+        out++;
+    }
+    pool->count = out;
+
+    // Speeds differ slightly, so at most a few neighbours swap
+    for (int i = 1; i < pool->count; i++) {
+        sift_down(pool, i);
+    }
+}
+
+int obstacles_query(const obstacle_pool_t *pool, int16_t x0, int16_t x1, uint8_t *out, int max)
+{
+    // First entry whose left edge could still reach x0
+    int32_t from = (int32_t)(x0 - OBSTACLE_MAX_W) << OBSTACLE_FP_SHIFT;
+    int lo = 0, hi = pool->count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (pool->x[mid] < from) lo = mid + 1;
+        else hi = mid;
+    }
+
+    int n = 0;
+    for (int i = lo; i < pool->count && n < max; i++) {
+        int left = PX(pool->x[i]);
+        if (left >= x1) break;
+        if (left + obstacle_kinds[pool->kind[i]].w > x0) {
+            out[n++] = (uint8_t)i;
+        }
+    }
+    return n;
+}
+
+void obstacles_spawner_init(obstacle_spawner_t *spawner, uint8_t level, uint8_t patterns,
+                            int16_t ground_y, int32_t speed, uint32_t (*rng)(void))
+{
+    spawner->level = level;
+    spawner->patterns_left = patterns;
+    spawner->cooldown = 0;
+    spawner->ground_y = ground_y;
+    spawner->speed = speed;
+    spawner->rng = rng;
+}
+
+void obstacles_spawner_step(obstacle_spawner_t *spawner, obstacle_pool_t *pool, int16_t spawn_x)
+{
+    if (spawner->patterns_left == 0) return;
+    if (spawner->cooldown > 0) {
+        spawner->cooldown--;
+        return;
+    }
+
+    // Pick among the patterns unlocked at this level
+    int unlocked = 0;
+    for (size_t i = 0; i < PATTERN_COUNT; i++) {
+        if (s_patterns[i].min_level <= spawner->level) unlocked++;
+    }
+    int pick = spawner->rng() % unlocked;
+    const spawn_pattern_t *pattern = s_patterns;
+    for (size_t i = 0; i < PATTERN_COUNT; i++) {
+        if (s_patterns[i].min_level > spawner->level) continue;
+        if (pick-- == 0) {
+            pattern = &s_patterns[i];
+            break;
+        }
+    }
+
+    for (int i = 0; i < pattern->count; i++) {
+        const spawn_item_t *item = &pattern->items[i];
+        const obstacle_kind_info_t *info = &obstacle_kinds[item->kind];
+        int32_t vx = spawner->speed;
+        if (item->kind == OBSTACLE_FISH) vx += spawner->speed / 16;  // Fish swim a little
+        obstacles_spawn(pool, item->kind, (int32_t)(spawn_x + item->dx) << OBSTACLE_FP_SHIFT,
+                        spawner->ground_y - item->lift - info->h, vx);
+    }
+    spawner->patterns_left--;
+
+    // Wait until the pattern and the gap behind it have scrolled in
+    int gap = PATTERN_GAP_PX - PATTERN_GAP_STEP_PX * spawner->level;
+    if (gap < PATTERN_GAP_MIN_PX) gap = PATTERN_GAP_MIN_PX;
+    gap += spawner->rng() % (PATTERN_JITTER_PX + 1);
+    int32_t distance = (int32_t)(pattern_width(pattern) + gap) << OBSTACLE_FP_SHIFT;
+    spawner->cooldown = (uint16_t)(distance / spawner->speed);
+}
@@ -0,0 +1,174 @@
+/**
+ * @file replay.c
+ * @brief Input recording and deterministic replay implementation
+ *
+ * REQ-SW-051: Input Recording and Replay
+ */
+
+#include "replay.h"
+#include "sim.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char *TAG = "replay";
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+// Header and events back to back, so the image is one contiguous blob
+static struct __attribute__((packed)) {
+    replay_header_t header;
+    replay_event_t events[REPLAY_MAX_EVENTS];
+} s_image;
+
+_Static_assert(sizeof(s_image) == REPLAY_MAX_SIZE, "recording image size");
+
+static replay_mode_t s_mode = REPLAY_IDLE;
+static uint16_t s_cursor = 0;   // Next event to play
+static bool s_full_warned = false;
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+void replay_record_start(void)
+{
+    memset(&s_image.header, 0, sizeof(s_image.header));
+    s_image.header.magic = REPLAY_MAGIC;
+    s_image.header.version = REPLAY_VERSION;
+    s_image.header.tick_ms = SIM_TICK_MS;
+    s_image.header.start_tick = sim_get_tick();
+    s_image.header.rng_state = sim_get_rng_state();
+    s_image.header.end_tick = sim_get_tick();
+    s_image.header.pet_size = sizeof(pet_state_t);
+    s_image.header.pet = *pet_get_state();
+
+    s_mode = REPLAY_RECORDING;
+    s_full_warned = false;
+    ESP_LOGI(TAG, "Recording (tick %lu, seed 0x%08lx)",
+             (unsigned long)s_image.header.start_tick,
+             (unsigned long)s_image.header.rng_state);
+}
+
+void replay_record_event(button_id_t button, button_event_t event)
+{
+    if (s_mode != REPLAY_RECORDING) return;
+
+    replay_header_t *hdr = &s_image.header;
+    if (hdr->event_count >= REPLAY_MAX_EVENTS) {
+        if (!s_full_warned) {
+            ESP_LOGW(TAG, "Recording full at %d events", REPLAY_MAX_EVENTS);
+            s_full_warned = true;
+        }
+        return;
+    }
+
+    replay_event_t *ev = &s_image.events[hdr->event_count++];
+    ev->tick = sim_get_tick();
+    ev->button = (uint8_t)button;
+    ev->event = (uint8_t)event;
+    ev->reserved = 0;
+    hdr->end_tick = ev->tick;
+}
+
+void replay_stop(void)
+{
+    if (s_mode == REPLAY_RECORDING) {
+        // Cover the idle time after the last event too
+        if (s_image.header.event_count < REPLAY_MAX_EVENTS) {
+            s_image.header.end_tick = sim_get_tick();
+        }
+        ESP_LOGI(TAG, "Recorded %u events over %lu ticks",
+                 s_image.header.event_count,
+                 (unsigned long)(s_image.header.end_tick - s_image.header.start_tick));
+    }
+    s_mode = REPLAY_IDLE;
+}
+
+esp_err_t replay_play_start(void)
+{
+    const replay_header_t *hdr = &s_image.header;
+    if (hdr->magic != REPLAY_MAGIC || hdr->event_count == 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    sim_restore(hdr->start_tick, hdr->rng_state);
+    *pet_get_state_mutable() = hdr->pet;
+    s_cursor = 0;
+    s_mode = REPLAY_PLAYING;
+
+    ESP_LOGI(TAG, "Playing %u events over %lu ticks",
+             hdr->event_count, (unsigned long)(hdr->end_tick - hdr->start_tick));
+    return ESP_OK;
+}
+
+bool replay_next_event(button_id_t *button, button_event_t *event)
+{
+    if (s_mode != REPLAY_PLAYING || s_cursor >= s_image.header.event_count) {
+        return false;
+    }
+
+    const replay_event_t *ev = &s_image.events[s_cursor];
+    if (ev->tick != sim_get_tick()) {
+        return false;
+    }
+
+    *button = (button_id_t)ev->button;
+    *event = (button_event_t)ev->event;
+    s_cursor++;
+    return true;
+}
+
+bool replay_is_finished(void)
+{
+    return s_mode == REPLAY_PLAYING &&
+           s_cursor >= s_image.header.event_count &&
+           sim_get_tick() >= s_image.header.end_tick;
+}
+
+replay_mode_t replay_get_mode(void)
+{
+    return s_mode;
+}
+
+uint16_t replay_event_count(void)
+{
+    return s_image.header.event_count;
+}
+
+const void *replay_get_data(size_t *len)
+{
+    if (s_mode == REPLAY_RECORDING && s_image.header.event_count < REPLAY_MAX_EVENTS) {
+        s_image.header.end_tick = sim_get_tick();
+    }
+    *len = sizeof(s_image.header) + s_image.header.event_count * sizeof(replay_event_t);
+    return &s_image;
+}
+
+size_t replay_max_size(void)
+{
+    return sizeof(s_image);
+}
+
+esp_err_t replay_load_data(const void *data, size_t len)
+{
+    if (len < sizeof(replay_header_t) || len > sizeof(s_image)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    replay_header_t hdr;
+    memcpy(&hdr, data, sizeof(hdr));
+    if (hdr.magic != REPLAY_MAGIC || hdr.version != REPLAY_VERSION ||
+        hdr.tick_ms != SIM_TICK_MS || hdr.pet_size != sizeof(pet_state_t)) {
+        ESP_LOGW(TAG, "Recording from a different build, ignored");
+        return ESP_ERR_INVALID_VERSION;
+    }
+    if (len != sizeof(hdr) + hdr.event_count * sizeof(replay_event_t)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    s_mode = REPLAY_IDLE;
+    memcpy(&s_image, data, len);
+    return ESP_OK;
+}
@@ -0,0 +1,250 @@
+/**
+ * @file settings.c
+ * @brief User settings implementation
+ *
+ * REQ-SW-018: Settings Screen
+ */
+
+#include "settings.h"
+#include "save_manager.h"
+#include "esp_log.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "settings";
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+static settings_t s_settings;
+static bool s_dirty = false;    // Changed since the last flush
+static bool s_dimmed = false;   // Backlight currently at the dim level
+
+// Values each setting steps through
+static const uint8_t s_brightness_steps[] = {50, 100, 150, 200, 255};
+static const uint8_t s_dim_steps[] = {0, 10, 30, 60, 120};
+static const uint8_t s_fps_steps[] = {10, 15, 20, 30};
+
+#define STEP_COUNT(a)       (sizeof(a) / sizeof((a)[0]))
+
+static const char *s_item_names[SETTINGS_ITEM_COUNT] = {
+    "Brightness", "Auto-dim", "Frame cap", "Render", "Sound", "Power saver"
+};
+
+static const char *s_render_names[DISPLAY_RENDER_COUNT] = {
+    "Immediate", "Framebuffer", "Banded"
+};
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+static void reset_settings(void)
+{
+    memset(&s_settings, 0, sizeof(s_settings));
+    s_settings.magic = SETTINGS_MAGIC;
+    s_settings.version = SETTINGS_VERSION;
+    s_settings.brightness = SETTINGS_DEFAULT_BRIGHTNESS;
+    s_settings.dim_timeout_s = SETTINGS_DEFAULT_DIM_S;
+    s_settings.fps_cap = SETTINGS_DEFAULT_FPS;
+    s_settings.render_mode = DISPLAY_RENDER_IMMEDIATE;
+    s_settings.flags = SETTINGS_FLAG_SOUND;
+}
+
+/**
+ * @brief Next value in a step table (first one if the current value is not in it)
+ */
+static uint8_t next_step(const uint8_t *steps, size_t count, uint8_t value)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (steps[i] == value) return steps[(i + 1) % count];
+    }
+    return steps[0];
+}
+
+static bool power_saver(void)
+{
+    return (s_settings.flags & SETTINGS_FLAG_POWER_SAVER) != 0;
+}
+
+static uint8_t full_brightness(void)
+{
+    if (power_saver() && s_settings.brightness > SETTINGS_SAVER_BRIGHTNESS) {
+        return SETTINGS_SAVER_BRIGHTNESS;
+    }
+    return s_settings.brightness;
+}
+
+static uint8_t dim_brightness(void)
+{
+    uint8_t full = full_brightness();
+    return (full < SETTINGS_BRIGHTNESS_DIM) ? full : SETTINGS_BRIGHTNESS_DIM;
+}
+
+static uint32_t dim_timeout_ms(void)
+{
+    uint32_t s = s_settings.dim_timeout_s;
+    if (power_saver() && (s == 0 || s > SETTINGS_SAVER_DIM_S)) {
+        s = SETTINGS_SAVER_DIM_S;
+    }
+    return s * 1000;
+}
+
+/**
+ * @brief Push backlight and render mode to the display
+ */
+static void apply(void)
+{
+    s_dimmed = false;
+    display_set_brightness(full_brightness());
+
+    if (display_request_render_mode((display_render_mode_t)s_settings.render_mode) != ESP_OK) {
+        s_settings.render_mode = display_get_render_mode();
+    }
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+esp_err_t settings_load(void)
+{
+    size_t len = sizeof(s_settings);
+    esp_err_t ret = save_manager_read_blob(SETTINGS_NVS_KEY, &s_settings, &len);
+    s_dirty = false;
+
+    if (ret == ESP_ERR_NOT_FOUND) {
+        ESP_LOGI(TAG, "No settings stored, using defaults");
+        reset_settings();
+    } else if (ret != ESP_OK || len != sizeof(s_settings) ||
+               s_settings.magic != SETTINGS_MAGIC || s_settings.version != SETTINGS_VERSION ||
+               s_settings.render_mode >= DISPLAY_RENDER_COUNT || s_settings.fps_cap == 0) {
+        ESP_LOGW(TAG, "Stored settings unusable (%s, %u bytes), using defaults",
+                 esp_err_to_name(ret), (unsigned)len);
+        reset_settings();
+        if (ret == ESP_OK) ret = ESP_ERR_INVALID_VERSION;
+    } else {
+        ESP_LOGI(TAG, "Brightness %u, dim after %us, %u FPS, render %s, sound %s, saver %s",
+                 s_settings.brightness, s_settings.dim_timeout_s, s_settings.fps_cap,
+                 s_render_names[s_settings.render_mode],
+                 (s_settings.flags & SETTINGS_FLAG_SOUND) ? "on" : "off",
+                 power_saver() ? "on" : "off");
+    }
+
+    apply();
+    return ret;
+}
+
+const settings_t *settings_get(void)
+{
+    return &s_settings;
+}
+
+esp_err_t settings_cycle(settings_item_t item)
+{
+    esp_err_t ret = ESP_OK;
+
+    switch (item) {
+        case SETTINGS_ITEM_BRIGHTNESS:
+            s_settings.brightness = next_step(s_brightness_steps, STEP_COUNT(s_brightness_steps),
+                                              s_settings.brightness);
+            break;
+        case SETTINGS_ITEM_DIM_TIMEOUT:
+            s_settings.dim_timeout_s = next_step(s_dim_steps, STEP_COUNT(s_dim_steps),
+                                                 s_settings.dim_timeout_s);
+            break;
+        case SETTINGS_ITEM_FPS_CAP:
+            s_settings.fps_cap = next_step(s_fps_steps, STEP_COUNT(s_fps_steps), s_settings.fps_cap);
+            break;
+        case SETTINGS_ITEM_RENDER_MODE: {
+            display_render_mode_t mode = (s_settings.render_mode + 1) % DISPLAY_RENDER_COUNT;
+            ret = display_request_render_mode(mode);
+            if (ret != ESP_OK) return ret;
+            s_settings.render_mode = mode;
+            break;
+        }
+        case SETTINGS_ITEM_SOUND:
+            s_settings.flags ^= SETTINGS_FLAG_SOUND;
+            break;
+        case SETTINGS_ITEM_POWER_SAVER:
+            s_settings.flags ^= SETTINGS_FLAG_POWER_SAVER;
+            break;
+        default:
+            return ESP_ERR_INVALID_ARG;
+    }
+
+    s_dirty = true;
+    apply();
+    return ret;
+}
+
+const char *settings_item_name(settings_item_t item)
+{
+    if (item >= SETTINGS_ITEM_COUNT) return "?";
+    return s_item_names[item];
+}
+
+void settings_item_value(settings_item_t item, char *buf, size_t len)
+{
+    switch (item) {
+        case SETTINGS_ITEM_BRIGHTNESS:
+            snprintf(buf, len, "%u%%", (s_settings.brightness * 100 + 127) / 255);
+            break;
+        case SETTINGS_ITEM_DIM_TIMEOUT:
+            if (s_settings.dim_timeout_s == 0) {
+                snprintf(buf, len, "Never");
+            } else {
+                snprintf(buf, len, "%us", s_settings.dim_timeout_s);
+            }
+            break;
+        case SETTINGS_ITEM_FPS_CAP:
+            snprintf(buf, len, "%u FPS", s_settings.fps_cap);
+            break;
+        case SETTINGS_ITEM_RENDER_MODE:
+            snprintf(buf, len, "%s", s_render_names[s_settings.render_mode]);
+            break;
+        case SETTINGS_ITEM_SOUND:
+            snprintf(buf, len, "%s", (s_settings.flags & SETTINGS_FLAG_SOUND) ? "On" : "Off");
+            break;
+        case SETTINGS_ITEM_POWER_SAVER:
+            snprintf(buf, len, "%s", power_saver() ? "On" : "Off");
+            break;
+        default:
+            snprintf(buf, len, "?");
+            break;
+    }
+}
+
+esp_err_t settings_flush(void)
+{
+    if (!s_dirty) return ESP_OK;
+
+    esp_err_t ret = save_manager_write_blob(SETTINGS_NVS_KEY, &s_settings, sizeof(s_settings));
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to store settings: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    s_dirty = false;
+    return ESP_OK;
+}
+
+uint32_t settings_frame_interval_ms(bool in_minigame)
+{
+    uint8_t fps = s_settings.fps_cap;
+    if (power_saver() && !in_minigame && fps > SETTINGS_SAVER_FPS) {
+        fps = SETTINGS_SAVER_FPS;
+    }
+    return 1000 / fps;
+}
+
+void settings_update_backlight(uint32_t idle_ms)
+{
+    uint32_t timeout = dim_timeout_ms();
+    bool dim = (timeout != 0 && idle_ms >= timeout);
+
+    if (dim != s_dimmed) {
+        display_set_brightness(dim ? dim_brightness() : full_brightness());
+        s_dimmed = dim;
+    }
+}
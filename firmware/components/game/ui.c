@@ -0,0 +1,283 @@
+/**
+ * @file ui.c
+ * @brief Retained-mode widget layer implementation
+ *
+ * REQ-SW-036: UI Widgets
+ */
+
+#include "ui.h"
+#include "display.h"
+#include "sprites.h"
+#include "esp_log.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "ui";
+
+//=============================================================================
+// Types
+//=============================================================================
+
+#define NODE_DIRTY          (1 << 0)    // Redraw the whole widget
+
+struct ui_node {
+    int16_t cell_w, cell_h;             // Grid/list cell pitch
+    int16_t value;                      // Bar level or selected item
+    int16_t drawn_value;                // Value currently on screen
+    int16_t drawn_w;                    // Label: width currently on screen
+    uint16_t fg;                        // Label/bar colour
+    uint8_t flags;
+    const uint16_t *pixels;             // Icon sprite
+    char text[UI_TEXT_MAX];             // Label text
+};
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+static ui_node_t s_pool[UI_MAX_NODES];
+static uint8_t s_pool_used = 0;
+static uint8_t s_screens = 0;
+
+_Static_assert(sizeof(s_pool) == UI_RAM_BYTES, "UI node pool outside its budget");
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+static inline uint8_t def_scale(const ui_widget_def_t *def)
+{
+    return def->scale ? def->scale : 1;
+}
+
+static void layout_node(const ui_widget_def_t *def, ui_node_t *node)
+{
+    memset(node, 0, sizeof(*node));
+    node->fg = def->fg;
+    node->flags = NODE_DIRTY;
+
+    switch (def->type) {
+        case UI_LABEL:
+            if (def->text) {
+                strncpy(node->text, def->text, UI_TEXT_MAX - 1);
+            }
+            break;
+        case UI_GRID:
+        case UI_LIST: {
+            uint8_t cols = (def->type == UI_LIST || def->cols == 0) ? 1 : def->cols;
+            node->cell_w = def->w / cols;
+            node->cell_h = def->item_h;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static void draw_cell(const ui_widget_def_t *def, const ui_node_t *node, int i)
+{
+    uint8_t cols = (def->type == UI_LIST || def->cols == 0) ? 1 : def->cols;
+    int x = def->x + (i % cols) * node->cell_w;
+    int y = def->y + (i / cols) * node->cell_h;
+    bool selected = (i == node->value);
+    uint16_t fg = selected ? def->sel_fg : def->fg;
+    uint16_t bg = selected ? def->sel_bg : def->bg;
+
+    display_fill_rect(x, y, node->cell_w - def->gap, node->cell_h - def->gap, bg);
+    display_draw_string(x + def->pad_x, y + def->pad_y, def->items[i], fg, bg, 1);
+}
+
+static void draw_bar_span(const ui_widget_def_t *def, int from, int to, uint16_t color)
+{
+    if (to > from) {
+        display_fill_rect(def->x + from, def->y, to - from, def->h, color);
+    }
+}
+
+static inline int bar_fill(const ui_widget_def_t *def, int16_t value)
+{
+    if (value < 0) value = 0;
+    if (value > 100) value = 100;
+    return (value * def->w) / 100;
+}
+
+static void draw_node(const ui_widget_def_t *def, ui_node_t *node)
+{
+    bool full = (node->flags & NODE_DIRTY) != 0;
+
+    switch (def->type) {
+        case UI_PANEL:
+            display_fill_rect(def->x, def->y, def->w, def->h, def->bg);
+            if (def->fg != def->bg) {
+                display_draw_rect(def->x, def->y, def->w, def->h, def->fg);
+            }
+            break;
+
+        case UI_LABEL: {
+            uint8_t scale = def_scale(def);
+            int16_t w = (int16_t)(strlen(node->text) * UI_CHAR_W * scale);
+            display_draw_string(def->x, def->y, node->text, node->fg, def->bg, scale);
+            // Clear what the previous, longer text left behind
+            int16_t clear_to = (node->drawn_w > def->w) ? node->drawn_w : def->w;
+            if (clear_to > w) {
+                display_fill_rect(def->x + w, def->y, clear_to - w, UI_CHAR_H * scale, def->bg);
+            }
+            node->drawn_w = w;
+            break;
+        }
+
+        case UI_BAR: {
+            int now = bar_fill(def, node->value);
+            if (full) {
+                draw_bar_span(def, 0, now, node->fg);
+                draw_bar_span(def, now, def->w, def->bg);
+            } else {
+                // Only the part between the old and new level changes
+                int was = bar_fill(def, node->drawn_value);
+                draw_bar_span(def, was, now, node->fg);
+                draw_bar_span(def, now, was, def->bg);
+            }
+            break;
+        }
+
+        case UI_ICON: {
+            uint8_t scale = def_scale(def);
+            display_fill_rect(def->x, def->y, def->w * scale, def->h * scale, def->bg);
+            if (node->pixels) {
+                display_draw_sprite_scaled(def->x, def->y, def->w, def->h, node->pixels,
+                                           SPRITE_TRANSPARENT, scale);
+            }
+            break;
+        }
+
+        case UI_GRID:
+        case UI_LIST:
+            if (full) {
+                for (int i = 0; i < def->count; i++) {
+                    draw_cell(def, node, i);
+                }
+            } else {
+                // Selection moved: the two cells involved
+                if (node->drawn_value >= 0 && node->drawn_value < def->count) {
+                    draw_cell(def, node, node->drawn_value);
+                }
+                draw_cell(def, node, node->value);
+            }
+            break;
+    }
+
+    node->drawn_value = node->value;
+    node->flags &= ~NODE_DIRTY;
+}
+
+static inline bool node_changed(const ui_node_t *node)
+{
+    return (node->flags & NODE_DIRTY) || node->value != node->drawn_value;
+}
+
+static ui_node_t *get_node(ui_screen_t *screen, uint8_t id)
+{
+    if (screen->nodes == NULL || id >= screen->count) return NULL;
+    return &screen->nodes[id];
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+esp_err_t ui_screen_init(ui_screen_t *screen, const ui_widget_def_t *defs, uint8_t count)
+{
+    if (screen->nodes != NULL) return ESP_OK;
+
+    if (s_pool_used + count > UI_MAX_NODES) {
+        ESP_LOGE(TAG, "Node pool full (%u + %u > %u)", s_pool_used, count, UI_MAX_NODES);
+        return ESP_ERR_NO_MEM;
+    }
+
+    screen->defs = defs;
+    screen->nodes = &s_pool[s_pool_used];
+    screen->count = count;
+    s_pool_used += count;
+    s_screens++;
+
+    for (int i = 0; i < count; i++) {
+        layout_node(&defs[i], &screen->nodes[i]);
+    }
+    return ESP_OK;
+}
+
+void ui_invalidate(ui_screen_t *screen)
+{
+    for (int i = 0; i < screen->count; i++) {
+        screen->nodes[i].flags |= NODE_DIRTY;
+    }
+}
+
+int ui_render(ui_screen_t *screen)
+{
+    int drawn = 0;
+    bool covered = false;   // A panel was painted over the widgets after it
+
+    for (int i = 0; i < screen->count; i++) {
+        ui_node_t *node = &screen->nodes[i];
+        if (covered) node->flags |= NODE_DIRTY;
+        if (!node_changed(node)) continue;
+
+        draw_node(&screen->defs[i], node);
+        drawn++;
+        if (screen->defs[i].type == UI_PANEL) covered = true;
+    }
+    return drawn;
+}
+
+void ui_set_text(ui_screen_t *screen, uint8_t id, const char *text)
+{
+    ui_node_t *node = get_node(screen, id);
+    if (node == NULL || strncmp(node->text, text, UI_TEXT_MAX - 1) == 0) return;
+
+    strncpy(node->text, text, UI_TEXT_MAX - 1);
+    node->text[UI_TEXT_MAX - 1] = '\0';
+    node->flags |= NODE_DIRTY;
+}
+
+void ui_set_textf(ui_screen_t *screen, uint8_t id, const char *fmt, ...)
+{
+    char buf[UI_TEXT_MAX];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    ui_set_text(screen, id, buf);
+}
+
+void ui_set_value(ui_screen_t *screen, uint8_t id, int16_t value)
+{
+    ui_node_t *node = get_node(screen, id);
+    if (node) node->value = value;
+}
+
+void ui_set_color(ui_screen_t *screen, uint8_t id, uint16_t fg)
+{
+    ui_node_t *node = get_node(screen, id);
+    if (node && node->fg != fg) {
+        node->fg = fg;
+        node->flags |= NODE_DIRTY;
+    }
+}
+
+void ui_set_icon(ui_screen_t *screen, uint8_t id, const uint16_t *pixels)
+{
+    ui_node_t *node = get_node(screen, id);
+    if (node && node->pixels != pixels) {
+        node->pixels = pixels;
+        node->flags |= NODE_DIRTY;
+    }
+}
+
+void ui_report_memory(void)
+{
+    ESP_LOGI(TAG, "Widgets: %u/%u nodes in %u screens, %u bytes (%u per node)",
+             s_pool_used, UI_MAX_NODES, s_screens,
+             (unsigned)sizeof(s_pool), (unsigned)sizeof(ui_node_t));
+}
@@ -0,0 +1,751 @@
+/**
+ * @file wave_game.c
+ * @brief "Jump the Wave" mini-game implementation
+ *
+ * REQ-SW-004: Play Mechanic
+ * REQ-SW-064: Mini-game Plugin Framework (registered as minigame_wave)
+ * REQ-SW-060: Fixed-Timestep Mini-game Physics
+ * REQ-SW-061: Incremental Mini-game Rendering
+ * REQ-SW-062: Mini-game Obstacle Pool
+ * REQ-SW-063: Pixel-accurate Mini-game Collision
+ * REQ-SW-065: Mini-game Leaderboard (reaction time)
+ * Waves, rocks and fish scroll across the screen. Press the button at the
+ * right time to make the dolphin jump over the hazards and catch the fish.
+ * A round is survived once all of its obstacle patterns have passed.
+ *
+ * The screen is repainted only when the game state changes. In between,
+ * the boxes the obstacles and dolphin covered last frame are tracked; each
+ * frame the union of a moved object's old and new box is composed
+ * (background bands, obstacles, dolphin) into a strip buffer and sent as
+ * one opaque bitmap, so there is no erase-then-draw flicker.
+ */
+
+#include "wave_game.h"
+#include "display.h"
+#include "sprites.h"
+#include "sprite_mask.h"
+#include "latency.h"
+#include "sim.h"
+#include "esp_log.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "wave_game";
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define SCREEN_W            240
+#define SCREEN_H            135
+
+#define DOLPHIN_X           60
+#define DOLPHIN_GROUND_Y    78
+#define DOLPHIN_W           32
+#define DOLPHIN_H           24
+#define DOLPHIN_SPRITE      SPRITE_ASSET_BABY_IDLE_1
+
+#define WAVE_GROUND_Y       95      // Bottom edge of surface obstacles
+#define SPAWN_X             (SCREEN_W + 8)
+
+// Physics in real units (jump apex ~62 px, airtime ~1.1 s: the dolphin
+// stays above a wave for ~0.85 s, long enough to pass one at any level)
+#define JUMP_SPEED_PX_S     223
+#define GRAVITY_PX_S2       400
+#define OBSTACLE_SPEED_PX_S 100     // Level 0
+#define OBSTACLE_LEVEL_PX_S 10      // Added per level
+#define OBSTACLE_JITTER_PX_S 10     // Random extra per round
+#define MAX_CATCHUP_MS      250     // Longer gaps are dropped, not simulated
+
+// Conversion to Q8 per-step units (rounded)
+#define FP(px)              ((int32_t)(px) * MINIGAME_FP_ONE)
+#define SPEED_Q8(px_s)      ((int32_t)(((px_s) * MINIGAME_STEP_MS * MINIGAME_FP_ONE + 500) / 1000))
+#define ACCEL_Q8(px_s2)     ((int32_t)(((px_s2) * MINIGAME_STEP_MS * MINIGAME_STEP_MS * MINIGAME_FP_ONE + 500000) / 1000000))
+
+#define JUMP_VELOCITY       (-SPEED_Q8(JUMP_SPEED_PX_S))
+#define GRAVITY             ACCEL_Q8(GRAVITY_PX_S2)
+
+#define PATTERNS_BASE       2       // Round r spawns this + r patterns
+#define SCORE_ROUND         10
+#define SCORE_FISH          5
+
+#define RESULT_DISPLAY_MS   1500
+#define MAX_ROUNDS          3
+
+// Rendering
+#define WAVE_INCREMENTAL 1      // 0: repaint every frame (for comparison)
+#define DOLPHIN_SCALE       1
+#define STRIP_PIXELS        (8 * SCREEN_W)  // Compose buffer: 8 full rows (3.75 KB)
+#define DIRTY_MAX           (OBSTACLE_MAX * 2 + 1)
+#define STEP_MAX_PX         4       // Obstacles move less than this per step
+#define FRAME_BUDGET_US     12000   // Update + render, incremental frames
+
+#define SCORE_X             (SCREEN_W - 70)
+#define HINT_X              60
+#define HINT_Y              (SCREEN_H - 15)
+#define HINT_TEXT           "Press to JUMP!"
+
+// Colors
+#define COLOR_BG            0x5D9F  // Light ocean
+#define COLOR_BG_DARK       0x2B4D  // Dark ocean
+#define COLOR_WAVE_DARK     0x07FF  // Cyan water
+#define COLOR_TEXT          0xFFFF
+#define COLOR_SUCCESS       0x07E0
+#define COLOR_FAIL          0xF800
+
+_Static_assert(OBSTACLE_FP_SHIFT == MINIGAME_FP_SHIFT, "obstacles and physics share Q8");
+_Static_assert(DOLPHIN_SCALE == 1, "collision masks are unscaled");
+
+//=============================================================================
+// Types
+//=============================================================================
+
+typedef struct {
+    int16_t x, y, w, h;         // w == 0: empty
+} mg_rect_t;
+
+// Background as horizontal bands of solid color, top to bottom
+typedef struct {
+    int16_t y0, y1;             // Rows [y0, y1)
+    uint16_t color;
+} bg_band_t;
+
+static const bg_band_t s_bg_bands[] = {
+    { 0,                  SCREEN_H / 2,       COLOR_BG },
+    { SCREEN_H / 2,       WAVE_GROUND_Y + 5,  COLOR_BG_DARK },
+    { WAVE_GROUND_Y + 5,  WAVE_GROUND_Y + 6,  COLOR_WAVE_DARK },   // Water line
+    { WAVE_GROUND_Y + 6,  SCREEN_H,           COLOR_BG_DARK },
+};
+
+static const sprite_asset_t s_kind_sprites[OBSTACLE_KIND_COUNT] = {
+    [OBSTACLE_WAVE] = SPRITE_ASSET_MG_WAVE,
+    [OBSTACLE_ROCK] = SPRITE_ASSET_MG_ROCK,
+    [OBSTACLE_FISH] = SPRITE_ASSET_MG_FISH,
+};
+
+// Something drawn this frame
+typedef struct {
+    const uint16_t *sprite;
+    mg_rect_t box;              // Unclipped, scaled size
+    uint8_t scale;
+    uint8_t id;                 // Obstacle ID (unused for the dolphin)
+} mg_object_t;
+
+// What is currently on screen
+typedef struct {
+    bool full;                  // Next render repaints everything
+    wave_state_t state;     // State the screen was painted for
+    uint16_t score;             // Score shown in the HUD
+    mg_rect_t dolphin;          // Clipped boxes drawn last frame
+    uint8_t obstacle_count;
+    uint8_t obstacle_ids[OBSTACLE_MAX];
+    mg_rect_t obstacle_boxes[OBSTACLE_MAX];
+    uint32_t full_bytes;        // SPI bytes of the last full repaint
+    uint32_t inc_bytes;         // SPI bytes of all incremental frames
+    uint32_t inc_frames;
+} wave_view_t;
+
+// Everything the game needs while it runs, carved from the mini-game arena.
+// game is the model (published to the render copy each frame); the rest
+// belongs to whichever task owns the copy.
+typedef struct {
+    wave_game_t game;
+    wave_view_t view;
+    mg_rect_t dirty[DIRTY_MAX]; // Boxes to repaint this frame
+    mg_object_t objects[OBSTACLE_MAX + 1];
+    uint16_t strip[STRIP_PIXELS];
+} wave_ctx_t;
+
+_Static_assert(sizeof(wave_ctx_t) <= MINIGAME_ARENA_SIZE,
+               "wave game state, view, dirty list and strip must fit the arena");
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+static wave_ctx_t *s_wave;      // Arena state while the game runs (simulation task)
+static wave_ctx_t *s_draw;      // Published copy being drawn (render task)
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+static inline uint32_t get_ms(void)
+{
+    return sim_now_ms();  // Simulated time, see sim.h
+}
+
+static void start_round(void)
+{
+    uint8_t level = s_wave->game.round - 1;
+    int32_t speed = SPEED_Q8(OBSTACLE_SPEED_PX_S + OBSTACLE_LEVEL_PX_S * level +
+                             sim_random() % (OBSTACLE_JITTER_PX_S + 1));
+
+    s_wave->game.state = WAVE_STATE_PLAYING;
+    obstacles_reset(&s_wave->game.obstacles);
+    obstacles_spawner_init(&s_wave->game.spawner, level, PATTERNS_BASE + s_wave->game.round,
+                           WAVE_GROUND_Y, speed, sim_random);
+    s_wave->game.dolphin_y = FP(DOLPHIN_GROUND_Y);
+    s_wave->game.dolphin_y_prev = s_wave->game.dolphin_y;
+    s_wave->game.dolphin_vy = 0;
+    s_wave->game.is_jumping = false;
+    s_wave->game.accum_ms = 0;
+    s_wave->game.next_valid = false;
+    s_wave->game.jump_pending = false;
+    s_wave->game.start_time_ms = get_ms();
+
+    ESP_LOGI(TAG, "Round %d started, level %d, speed: %ld px/s",
+             s_wave->game.round, level,
+             (long)(speed * 1000 / (MINIGAME_STEP_MS * MINIGAME_FP_ONE)));
+}
+
+/**
+ * @brief Test one obstacle against the dolphin, pixel by pixel
+ *
+ * Falls back to the bounding boxes for sprites without a mask.
+ */
+static bool touches_dolphin(int i, int dolphin_top)
+{
+    const obstacle_pool_t *pool = &s_wave->game.obstacles;
+    const obstacle_kind_info_t *info = &obstacle_kinds[pool->kind[i]];
+    int x = pool->x[i] >> MINIGAME_FP_SHIFT;
+
+    if (dolphin_top + DOLPHIN_H <= pool->y[i] || dolphin_top >= pool->y[i] + info->h) return false;
+
+    const sprite_mask_t *dolphin = sprite_mask_get(DOLPHIN_SPRITE);
+    const sprite_mask_t *obstacle = sprite_mask_get(s_kind_sprites[pool->kind[i]]);
+    if (dolphin == NULL || obstacle == NULL) return true;
+
+    return sprite_mask_overlap(dolphin, DOLPHIN_X, dolphin_top, obstacle, x, pool->y[i]);
+}
+
+/**
+ * @brief Test the dolphin against the obstacles in its column
+ *
+ * Fish it touches are caught and removed.
+ * @return true if it hit a hazard
+ */
+static bool check_collision(void)
+{
+    obstacle_pool_t *pool = &s_wave->game.obstacles;
+    int dolphin_top = s_wave->game.dolphin_y >> MINIGAME_FP_SHIFT;
+
+    uint8_t near[OBSTACLE_MAX];
+    int n = obstacles_query(pool, DOLPHIN_X, DOLPHIN_X + DOLPHIN_W, near, OBSTACLE_MAX);
+
+    // Backwards, so removing a fish does not shift the remaining indices
+    for (int k = n - 1; k >= 0; k--) {
+        int i = near[k];
+        const obstacle_kind_info_t *info = &obstacle_kinds[pool->kind[i]];
+        if (!touches_dolphin(i, dolphin_top)) continue;
+
+        if (info->harmful) return true;
+
+        obstacles_remove(pool, i);
+        s_wave->game.fish++;
+        s_wave->game.score += SCORE_FISH;
+    }
+    return false;
+}
+
+/**
+ * @brief Check whether the round's last obstacle has passed the dolphin
+ */
+static bool all_passed(void)
+{
+    const obstacle_pool_t *pool = &s_wave->game.obstacles;
+    if (!obstacles_spawner_done(&s_wave->game.spawner)) return false;
+    for (int i = 0; i < pool->count; i++) {
+        if ((pool->x[i] >> MINIGAME_FP_SHIFT) + obstacle_kinds[pool->kind[i]].w >= DOLPHIN_X) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Track the next hazard and score jumps that cleared theirs
+ *
+ * Called after a step without a hit. A pending jump counts once its hazard
+ * has passed the dolphin (or scrolled off and been culled).
+ */
+static void track_reaction(void)
+{
+    wave_game_t *game = &s_wave->game;
+    const obstacle_pool_t *pool = &game->obstacles;
+
+    if (game->jump_pending) {
+        bool passed = true;
+        for (int i = 0; i < pool->count; i++) {
+            if (pool->id[i] == game->jump_id) {
+                passed = (pool->x[i] >> MINIGAME_FP_SHIFT) + obstacle_kinds[pool->kind[i]].w < DOLPHIN_X;
+                break;
+            }
+        }
+        if (passed) {
+            game->jump_pending = false;
+            if (game->best_reaction_ms == 0 || game->jump_ms < game->best_reaction_ms) {
+                game->best_reaction_ms = game->jump_ms;
+            }
+        }
+    }
+
+    // First hazard on screen that has not reached the dolphin yet
+    uint8_t ahead[OBSTACLE_MAX];
+    int n = obstacles_query(pool, DOLPHIN_X + DOLPHIN_W, SCREEN_W, ahead, OBSTACLE_MAX);
+    for (int k = 0; k < n; k++) {
+        int i = ahead[k];
+        if (!obstacle_kinds[pool->kind[i]].harmful) continue;
+        if ((pool->x[i] >> MINIGAME_FP_SHIFT) < DOLPHIN_X + DOLPHIN_W) continue;
+        if (!game->next_valid || game->next_id != pool->id[i]) {
+            game->next_valid = true;
+            game->next_id = pool->id[i];
+            game->next_step = game->steps;
+        }
+        return;
+    }
+    game->next_valid = false;
+}
+
+/**
+ * @brief Advance physics by one fixed step
+ */
+static void physics_step(void)
+{
+    s_wave->game.steps++;
+    s_wave->game.dolphin_y_prev = s_wave->game.dolphin_y;
+
+    // Dolphin (semi-implicit Euler)
+    if (s_wave->game.is_jumping) {
+        s_wave->game.dolphin_vy += GRAVITY;
+        s_wave->game.dolphin_y += s_wave->game.dolphin_vy;
+
+        // Land on ground
+        if (s_wave->game.dolphin_y >= FP(DOLPHIN_GROUND_Y)) {
+            s_wave->game.dolphin_y = FP(DOLPHIN_GROUND_Y);
+            s_wave->game.dolphin_vy = 0;
+            s_wave->game.is_jumping = false;
+        }
+    }
+
+    obstacles_spawner_step(&s_wave->game.spawner, &s_wave->game.obstacles, SPAWN_X);
+    obstacles_step(&s_wave->game.obstacles, 0);
+
+    if (check_collision()) {
+        // Fail!
+        s_wave->game.state = WAVE_STATE_FAIL;
+        s_wave->game.failures++;
+        s_wave->game.result_time_ms = get_ms();
+        ESP_LOGI(TAG, "Round %d: FAIL", s_wave->game.round);
+        return;
+    }
+
+    track_reaction();
+
+    if (all_passed()) {
+        // Success!
+        s_wave->game.state = WAVE_STATE_SUCCESS;
+        s_wave->game.successes++;
+        s_wave->game.score += SCORE_ROUND;
+        s_wave->game.result_time_ms = get_ms();
+        ESP_LOGI(TAG, "Round %d: SUCCESS", s_wave->game.round);
+    }
+}
+
+/**
+ * @brief Interpolate a Q8 position for rendering
+ * @return Whole pixels
+ */
+static inline int lerp_px(int32_t prev, int32_t cur)
+{
+    int32_t alpha = (int32_t)(s_draw->game.accum_ms * MINIGAME_FP_ONE / MINIGAME_STEP_MS);
+    return (prev + (((cur - prev) * alpha) >> MINIGAME_FP_SHIFT)) >> MINIGAME_FP_SHIFT;
+}
+
+//=============================================================================
+// Rendering
+//=============================================================================
+
+static mg_rect_t rect_clip(int x, int y, int w, int h)
+{
+    mg_rect_t r = {0};
+    int x1 = x + w, y1 = y + h;
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x1 > SCREEN_W) x1 = SCREEN_W;
+    if (y1 > SCREEN_H) y1 = SCREEN_H;
+    if (x1 > x && y1 > y) {
+        r.x = x; r.y = y; r.w = x1 - x; r.h = y1 - y;
+    }
+    return r;
+}
+
+static bool rect_equal(const mg_rect_t *a, const mg_rect_t *b)
+{
+    return a->x == b->x && a->y == b->y && a->w == b->w && a->h == b->h;
+}
+
+static bool rect_overlaps(const mg_rect_t *a, const mg_rect_t *b)
+{
+    return a->w && b->w &&
+           a->x < b->x + b->w && b->x < a->x + a->w &&
+           a->y < b->y + b->h && b->y < a->y + a->h;
+}
+
+static mg_rect_t rect_union(const mg_rect_t *a, const mg_rect_t *b)
+{
+    if (!a->w) return *b;
+    if (!b->w) return *a;
+    int x0 = (a->x < b->x) ? a->x : b->x;
+    int y0 = (a->y < b->y) ? a->y : b->y;
+    int x1 = (a->x + a->w > b->x + b->w) ? a->x + a->w : b->x + b->w;
+    int y1 = (a->y + a->h > b->y + b->h) ? a->y + a->h : b->y + b->h;
+    return rect_clip(x0, y0, x1 - x0, y1 - y0);
+}
+
+static mg_rect_t object_box(const mg_object_t *object)
+{
+    return rect_clip(object->box.x, object->box.y, object->box.w, object->box.h);
+}
+
+/**
+ * @brief Collect everything to draw this frame (off-screen obstacles culled)
+ * @param objects Output: obstacles in pool order, then the dolphin
+ * @return Number of objects
+ */
+static int collect_objects(mg_object_t *objects)
+{
+    const obstacle_pool_t *pool = &s_draw->game.obstacles;
+    uint8_t visible[OBSTACLE_MAX];
+    int count = 0;
+    int w, h;
+
+    // Drawn positions lag x by up to one step, so look slightly left of the screen
+    int n = obstacles_query(pool, -STEP_MAX_PX, SCREEN_W, visible, OBSTACLE_MAX);
+    for (int k = 0; k < n; k++) {
+        int i = visible[k];
+        const uint16_t *sprite = sprites_get(s_kind_sprites[pool->kind[i]], &w, &h);
+        mg_rect_t box = { lerp_px(pool->x_prev[i], pool->x[i]), pool->y[i], w, h };
+        if (box.x >= SCREEN_W || box.x + box.w <= 0) continue;
+        objects[count].sprite = sprite;
+        objects[count].box = box;
+        objects[count].scale = 1;
+        objects[count].id = pool->id[i];
+        count++;
+    }
+
+    objects[count].sprite = sprites_get(DOLPHIN_SPRITE, &w, &h);
+    objects[count].box = (mg_rect_t){ DOLPHIN_X, lerp_px(s_draw->game.dolphin_y_prev, s_draw->game.dolphin_y),
+                                      w * DOLPHIN_SCALE, h * DOLPHIN_SCALE };
+    objects[count].scale = DOLPHIN_SCALE;
+    objects[count].id = 0;
+    return count + 1;
+}
+
+/**
+ * @brief Draw one sprite into the strip (transparent pixels skipped)
+ */
+static void strip_blit(const mg_rect_t *strip, const mg_object_t *object)
+{
+    const mg_rect_t *box = &object->box;
+    int sw = box->w / object->scale;
+
+    int xa = (box->x > strip->x) ? box->x : strip->x;
+    int xb = (box->x + box->w < strip->x + strip->w) ? box->x + box->w : strip->x + strip->w;
+    int ya = (box->y > strip->y) ? box->y : strip->y;
+    int yb = (box->y + box->h < strip->y + strip->h) ? box->y + box->h : strip->y + strip->h;
+
+    for (int y = ya; y < yb; y++) {
+        const uint16_t *src = &object->sprite[((y - box->y) / object->scale) * sw];
+        uint16_t *row = &s_draw->strip[(y - strip->y) * strip->w];
+        for (int x = xa; x < xb; x++) {
+            uint16_t pixel = src[(x - box->x) / object->scale];
+            if (pixel != SPRITE_TRANSPARENT) row[x - strip->x] = pixel;
+        }
+    }
+}
+
+/**
+ * @brief Compose the scene inside r into strips and send each as a bitmap
+ */
+static void compose_rect(const mg_rect_t *r, const mg_object_t *objects, int count)
+{
+    int rows = STRIP_PIXELS / r->w;
+
+    for (int y0 = r->y; y0 < r->y + r->h; y0 += rows) {
+        int n = (r->y + r->h - y0 < rows) ? r->y + r->h - y0 : rows;
+        mg_rect_t strip = { r->x, y0, r->w, n };
+
+        // Background bands
+        for (size_t b = 0; b < sizeof(s_bg_bands) / sizeof(s_bg_bands[0]); b++) {
+            int ya = (s_bg_bands[b].y0 > y0) ? s_bg_bands[b].y0 : y0;
+            int yb = (s_bg_bands[b].y1 < y0 + n) ? s_bg_bands[b].y1 : y0 + n;
+            for (int y = ya; y < yb; y++) {
+                uint16_t *row = &s_draw->strip[(y - y0) * r->w];
+                for (int i = 0; i < r->w; i++) row[i] = s_bg_bands[b].color;
+            }
+        }
+
+        // Objects, back to front
+        for (int k = 0; k < count; k++) {
+            if (rect_overlaps(&objects[k].box, &strip)) {
+                strip_blit(&strip, &objects[k]);
+            }
+        }
+
+        display_draw_bitmap(strip.x, strip.y, strip.w, strip.h, s_draw->strip);
+    }
+}
+
+static void draw_score(void)
+{
+    char buf[16];
+    snprintf(buf, sizeof(buf), "Score: %d", s_draw->game.score);
+    display_draw_string(SCORE_X, 5, buf, COLOR_TEXT, COLOR_BG, 1);
+}
+
+/**
+ * @brief Repaint the whole screen for the current state
+ */
+static void render_full(const mg_object_t *objects, int count)
+{
+    mg_rect_t screen = { 0, 0, SCREEN_W, SCREEN_H };
+    compose_rect(&screen, objects, count);
+
+    // Round indicator
+    char buf[16];
+    snprintf(buf, sizeof(buf), "Round %d/%d", s_draw->game.round, s_draw->game.max_rounds);
+    display_draw_string(5, 5, buf, COLOR_TEXT, COLOR_BG, 1);
+    draw_score();
+
+    // Result overlay
+    if (s_draw->game.state == WAVE_STATE_SUCCESS) {
+        display_draw_string(80, 50, "NICE!", COLOR_SUCCESS, COLOR_BG, 2);
+    } else if (s_draw->game.state == WAVE_STATE_FAIL) {
+        display_draw_string(80, 50, "OOPS!", COLOR_FAIL, COLOR_BG, 2);
+    }
+
+    // Instructions
+    if (s_draw->game.state == WAVE_STATE_PLAYING) {
+        display_draw_string(HINT_X, HINT_Y, HINT_TEXT, COLOR_TEXT, COLOR_BG_DARK, 1);
+    }
+}
+
+/**
+ * @brief Redraw only what moved since the last frame
+ */
+static void render_incremental(const mg_object_t *objects, int count)
+{
+    mg_rect_t *dirty = s_draw->dirty;
+    bool seen[OBSTACLE_MAX] = {0};
+    int obstacles = count - 1;
+    int n = 0;
+
+    // Obstacles that moved or appeared
+    for (int k = 0; k < obstacles; k++) {
+        mg_rect_t box = object_box(&objects[k]);
+        mg_rect_t old = {0};
+        for (int j = 0; j < s_draw->view.obstacle_count; j++) {
+            if (s_draw->view.obstacle_ids[j] == objects[k].id) {
+                old = s_draw->view.obstacle_boxes[j];
+                seen[j] = true;
+                break;
+            }
+        }
+        if (!rect_equal(&box, &old)) dirty[n++] = rect_union(&box, &old);
+    }
+
+    // Obstacles that scrolled off or were caught
+    for (int j = 0; j < s_draw->view.obstacle_count; j++) {
+        if (!seen[j]) dirty[n++] = s_draw->view.obstacle_boxes[j];
+    }
+
+    // Dolphin
+    mg_rect_t dolphin = object_box(&objects[count - 1]);
+    if (!rect_equal(&dolphin, &s_draw->view.dolphin)) {
+        dirty[n++] = rect_union(&dolphin, &s_draw->view.dolphin);
+    }
+
+    // Merge overlapping boxes so no pixel is sent twice
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            if (rect_overlaps(&dirty[i], &dirty[j])) {
+                dirty[i] = rect_union(&dirty[i], &dirty[j]);
+                dirty[j] = dirty[--n];
+                i = -1;  // The grown box may touch earlier ones: start over
+                break;
+            }
+        }
+    }
+
+    bool hint_dirty = false;
+    mg_rect_t hint = { HINT_X, HINT_Y, (sizeof(HINT_TEXT) - 1) * 6, 8 };
+    for (int i = 0; i < n; i++) {
+        if (!dirty[i].w) continue;
+        compose_rect(&dirty[i], objects, count);
+        hint_dirty |= rect_overlaps(&dirty[i], &hint);
+    }
+
+    // Text stays on top, as in a full repaint
+    if (hint_dirty && s_draw->game.state == WAVE_STATE_PLAYING) {
+        display_draw_string(HINT_X, HINT_Y, HINT_TEXT, COLOR_TEXT, COLOR_BG_DARK, 1);
+    }
+    if (s_draw->game.score != s_draw->view.score) {
+        draw_score();
+    }
+}
+
+static void log_render_stats(void)
+{
+    ESP_LOGI(TAG, "SPI per frame: full repaint %lu B, incremental avg %lu B (%lu frames)",
+             (unsigned long)s_draw->view.full_bytes,
+             (unsigned long)(s_draw->view.inc_frames ? s_draw->view.inc_bytes / s_draw->view.inc_frames : 0),
+             (unsigned long)s_draw->view.inc_frames);
+}
+
+//=============================================================================
+// Lifecycle Handlers
+//=============================================================================
+
+static void wave_init(void *state)
+{
+    s_wave = state;
+    ESP_LOGI(TAG, "Starting mini-game");
+    s_wave->game.state = WAVE_STATE_READY;
+    s_wave->game.round = 1;
+    s_wave->game.max_rounds = MAX_ROUNDS;
+    s_wave->view.full = true;
+    start_round();
+}
+
+static bool wave_update(void *state, uint32_t delta_ms)
+{
+    s_wave = state;
+
+    if (s_wave->game.state == WAVE_STATE_SUCCESS || s_wave->game.state == WAVE_STATE_FAIL ||
+        s_wave->game.state == WAVE_STATE_RESULTS) {
+        // Check if result display time is over
+        if (get_ms() - s_wave->game.result_time_ms > RESULT_DISPLAY_MS) {
+            if (s_wave->game.round >= s_wave->game.max_rounds) {
+                // Game over
+                return false;
+            }
+            // Start next round
+            s_wave->game.round++;
+            start_round();
+        }
+        return true;
+    }
+
+    if (s_wave->game.state != WAVE_STATE_PLAYING) {
+        return true;
+    }
+
+    // Fixed-timestep accumulator: gameplay does not depend on frame rate
+    s_wave->game.accum_ms += (delta_ms > MAX_CATCHUP_MS) ? MAX_CATCHUP_MS : delta_ms;
+    while (s_wave->game.accum_ms >= MINIGAME_STEP_MS) {
+        s_wave->game.accum_ms -= MINIGAME_STEP_MS;
+        physics_step();
+        if (s_wave->game.state != WAVE_STATE_PLAYING) {
+            // Freeze the final position (no interpolation past the hit)
+            s_wave->game.accum_ms = 0;
+            s_wave->game.dolphin_y_prev = s_wave->game.dolphin_y;
+            for (int i = 0; i < s_wave->game.obstacles.count; i++) {
+                s_wave->game.obstacles.x_prev[i] = s_wave->game.obstacles.x[i];
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static void wave_input(void *state, button_id_t button, button_event_t event)
+{
+    s_wave = state;
+
+    if (event != BUTTON_EVENT_CLICK) return;
+
+    if (s_wave->game.state == WAVE_STATE_PLAYING) {
+        if (!s_wave->game.is_jumping) {
+            // Jump!
+            s_wave->game.is_jumping = true;
+            s_wave->game.dolphin_vy = JUMP_VELOCITY;
+            if (s_wave->game.next_valid) {
+                // Input lands between steps: round up to the next one
+                s_wave->game.jump_pending = true;
+                s_wave->game.jump_id = s_wave->game.next_id;
+                s_wave->game.jump_ms = (uint16_t)((s_wave->game.steps - s_wave->game.next_step + 1) * MINIGAME_STEP_MS);
+            }
+            latency_mark_region(DOLPHIN_X, 0, DOLPHIN_W * DOLPHIN_SCALE, SCREEN_H);
+            ESP_LOGD(TAG, "Jump!");
+        }
+    }
+}
+
+static void wave_render(void *state)
+{
+    s_draw = state;
+    mg_object_t *objects = s_draw->objects;
+    display_stats_t before, after;
+    display_get_stats(&before);
+
+    int count = collect_objects(objects);
+
+    bool full = !WAVE_INCREMENTAL || s_draw->view.full || s_draw->game.state != s_draw->view.state;
+    if (full) {
+        render_full(objects, count);
+    } else {
+        render_incremental(objects, count);
+    }
+
+    // Remember what is on screen now
+    s_draw->view.full = false;
+    s_draw->view.state = s_draw->game.state;
+    s_draw->view.score = s_draw->game.score;
+    s_draw->view.obstacle_count = count - 1;
+    for (int k = 0; k < count - 1; k++) {
+        s_draw->view.obstacle_ids[k] = objects[k].id;
+        s_draw->view.obstacle_boxes[k] = object_box(&objects[k]);
+    }
+    s_draw->view.dolphin = object_box(&objects[count - 1]);
+
+    display_get_stats(&after);
+    if (full) {
+        s_draw->view.full_bytes = after.bytes - before.bytes;
+    } else {
+        s_draw->view.inc_bytes += after.bytes - before.bytes;
+        s_draw->view.inc_frames++;
+    }
+
+    // Final round's result just went up: the game ends on this screen
+    bool over = s_draw->game.state == WAVE_STATE_SUCCESS || s_draw->game.state == WAVE_STATE_FAIL;
+    if (full && over && s_draw->game.round >= s_draw->game.max_rounds) {
+        log_render_stats();
+    }
+}
+
+static void wave_result(const void *state, minigame_result_t *result)
+{
+    const wave_ctx_t *ctx = state;
+    result->won = ctx->game.successes > ctx->game.failures;
+    result->score = ctx->game.score;
+    result->reaction_ms = ctx->game.best_reaction_ms;
+}
+
+//=============================================================================
+// Registration
+//=============================================================================
+
+const minigame_vtable_t minigame_wave = {
+    .name = "WAVE",
+    .state_size = sizeof(wave_ctx_t),
+    .model_size = offsetof(wave_ctx_t, view),
+    .frame_budget_us = FRAME_BUDGET_US,
+    .init = wave_init,
+    .update = wave_update,
+    .render = wave_render,
+    .input = wave_input,
+    .result = wave_result,
+};
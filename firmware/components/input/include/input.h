@@ -3,7 +3,14 @@
  * @brief Button input handling for TTGO T-Display
  *
  * REQ-SW-012: Button Input
+ * REQ-SW-016: Interrupt-Driven Input
+ * REQ-SW-017: Button Gestures
  * Two-button control scheme with debouncing and long press detection.
+ * GPIO edge interrupts timestamp every transition; debouncing and
+ * click/long-press classification run on those timestamps, and the
+ * resulting events are queued for the game loop. A table-driven gesture
+ * recognizer on the same timestamps adds double-click, chord and
+ * hold-click events for the gestures the game currently has bound.
  */
 
 #ifndef INPUT_H
@@ -32,46 +39,99 @@ typedef enum {
     BUTTON_EVENT_LONG_PRESS,    // Held for long press threshold
     BUTTON_EVENT_CLICK,         // Short press completed
     BUTTON_EVENT_REPEAT,        // Repeated while held (after long press)
+    BUTTON_EVENT_DOUBLE_CLICK,  // Two clicks within the double-click window
+    BUTTON_EVENT_CHORD,         // Both pressed together (button = second one)
+    BUTTON_EVENT_HOLD_CLICK,    // Clicked while the other button is held
 } button_event_t;
 
+/**
+ * @brief Multi-button/multi-click gestures
+ *
+ * Gestures are bound per button with INPUT_GESTURE_BIT(). A click on a
+ * button is only held back (by the double-click window) when that
+ * button's double-click is bound; chords and hold-clicks never delay.
+ */
+typedef enum {
+    INPUT_GESTURE_DOUBLE_CLICK = 0,
+    INPUT_GESTURE_CHORD,        // Bit of the button that completes the chord
+    INPUT_GESTURE_HOLD_CLICK,   // Bit of the button that is clicked
+    INPUT_GESTURE_COUNT
+} input_gesture_t;
+
+#define INPUT_GESTURE_BIT(gesture, button)  (1u << ((gesture) * BUTTON_COUNT + (button)))
+#define INPUT_GESTURE_CHORD_ANY             (INPUT_GESTURE_BIT(INPUT_GESTURE_CHORD, BUTTON_LEFT) | \
+                                             INPUT_GESTURE_BIT(INPUT_GESTURE_CHORD, BUTTON_RIGHT))
+
+/**
+ * @brief Gesture timing windows
+ */
+typedef struct {
+    uint32_t double_click_ms;   // Max gap from first release to second press
+    uint32_t chord_ms;          // Max gap between the two presses of a chord
+} input_gesture_config_t;
+
 /**
  * @brief Button state information
  */
 typedef struct {
-    bool is_pressed;            // Current state
-    bool was_pressed;           // Previous state
-    uint32_t press_start_ms;    // When button was pressed
-    uint32_t last_event_ms;     // Last event time
+    bool is_pressed;            // Debounced state
+    bool was_pressed;           // Debounced state at previous update
+    bool raw_pressed;           // Level after the most recent edge
     bool long_press_fired;      // Long press event already sent
+    int64_t raw_since_us;       // Time of the most recent edge
+    int64_t press_start_us;     // When the debounced press began
+    int64_t last_event_us;      // Last long press/repeat event time
+    uint8_t gesture;            // Gesture recognizer state
+    int64_t gesture_since_us;   // Start of the double-click window
 } button_state_t;
 
 /**
- * @brief Button event callback function type
- * @param button Which button triggered the event
- * @param event Type of button event
+ * @brief Timestamped button event
  */
-typedef void (*button_callback_t)(button_id_t button, button_event_t event);
+typedef struct {
+    int64_t time_us;            // When it happened (edge time, not poll time)
+    uint16_t trace_id;          // Sequence number for latency tracing
+    button_id_t button;
+    button_event_t event;
+} input_event_t;
 
 /**
- * @brief Initialize button input system
+ * @brief Initialize button input system and edge interrupts
  * @return ESP_OK on success
  */
 esp_err_t input_init(void);
 
 /**
- * @brief Register callback for button events
- * @param callback Function to call on button events (NULL to unregister)
+ * @brief Pop the oldest pending button event
+ * @param event Output: event data
+ * @return true if an event was returned, false if the queue is empty
  */
-void input_register_callback(button_callback_t callback);
+bool input_get_event(input_event_t *event);
 
 /**
  * @brief Update button state (call from main loop or task)
  *
- * This processes button state changes and fires callbacks.
- * Should be called at regular intervals (e.g., every 20ms).
+ * Drains edges captured by the GPIO interrupts, debounces them and queues
+ * events. Call rate only affects when events become visible, not their
+ * timestamps; short taps between two calls are not lost.
  */
 void input_update(void);
 
+/**
+ * @brief Select which gestures are recognised
+ *
+ * Call on every game state change. Unbound gestures fall back to plain
+ * click/long press events with no added latency.
+ * @param mask OR of INPUT_GESTURE_BIT() values, 0 for none
+ */
+void input_set_gestures(uint32_t mask);
+
+/**
+ * @brief Change the gesture timing windows
+ * @param config New windows (copied)
+ */
+void input_set_gesture_config(const input_gesture_config_t *config);
+
 /**
  * @brief Check if button is currently pressed
  * @param button Which button to check
@@ -103,7 +163,8 @@ uint32_t input_get_hold_time(button_id_t button);
 /**
  * @brief Clear all pending button events
  *
- * Useful when transitioning between game states.
+ * Drops queued events and suppresses the click/long press/gesture of any
+ * button currently held. Useful when transitioning between game states.
  */
 void input_clear_events(void);
 
@@ -3,13 +3,25 @@
  * @brief Button input handling implementation
  *
  * REQ-SW-012: Button Input
+ * REQ-SW-016: Interrupt-Driven Input
+ * REQ-SW-017: Button Gestures
  * Implements debounced button input with short/long press detection.
+ *
+ * Data flow:
+ *   GPIO ISR --(edge ring)--> input_update() --(event ring)--> game loop
+ * Both rings are single-producer/single-consumer and lock-free, so
+ * input_update() and input_get_event() may run on different tasks. The two
+ * GPIO ISRs run through the same ISR service on one core and never nest,
+ * so together they form a single producer.
  */
 
 #include "input.h"
+#include "trace.h"
 #include "driver/gpio.h"
+#include "esp_attr.h"
 #include "esp_timer.h"
 #include "esp_log.h"
+#include <stdatomic.h>
 
 static const char *TAG = "input";
 
@@ -18,10 +30,27 @@ static const char *TAG = "input";
 #define BUTTON_RIGHT_GPIO   35
 
 // Timing configuration
-#define DEBOUNCE_MS         50
-#define LONG_PRESS_MS       2000
-#define REPEAT_DELAY_MS     500
-#define REPEAT_RATE_MS      150
+#define DEBOUNCE_US         (50 * 1000)
+#define LONG_PRESS_US       (2000 * 1000)
+#define REPEAT_DELAY_US     (500 * 1000)
+#define REPEAT_RATE_US      (150 * 1000)
+
+// Default gesture windows
+#define DOUBLE_CLICK_MS     250
+#define CHORD_MS            80
+
+// Ring sizes (power of two)
+#define EDGE_RING_SIZE      32
+#define EVENT_RING_SIZE     16
+
+/**
+ * @brief Raw edge captured in the ISR
+ */
+typedef struct {
+    int64_t time_us;
+    uint8_t button;
+    uint8_t pressed;
+} input_edge_t;
 
 // Button GPIO mapping
 static const gpio_num_t s_button_gpio[BUTTON_COUNT] = {
@@ -31,36 +60,351 @@ static const gpio_num_t s_button_gpio[BUTTON_COUNT] = {
 
 // Static state
 static button_state_t s_buttons[BUTTON_COUNT] = {0};
-static button_callback_t s_callback = NULL;
-static uint32_t s_last_update_ms = 0;
+
+// ISR -> input_update()
+static input_edge_t s_edges[EDGE_RING_SIZE];
+static atomic_uint s_edge_head;     // Written by ISR
+static atomic_uint s_edge_tail;     // Written by input_update()
+static atomic_bool s_edge_overflow;
+
+// input_update() -> game loop
+static input_event_t s_events[EVENT_RING_SIZE];
+static atomic_uint s_event_head;    // Written by input_update()
+static atomic_uint s_event_tail;    // Written by input_get_event()
+static uint32_t s_events_dropped = 0;
+static uint16_t s_next_trace_id = 0;
+
+// Gesture bindings: set by the game, read by input_update() (may be
+// another task); the configuration is set before the tasks start
+static atomic_uint s_gesture_mask;
+static input_gesture_config_t s_gesture_config = {
+    .double_click_ms = DOUBLE_CLICK_MS,
+    .chord_ms = CHORD_MS,
+};
 
 /**
- * @brief Get current time in milliseconds
+ * @brief Read raw button state (active LOW)
  */
-static inline uint32_t get_ms(void)
+static inline bool read_button_raw(button_id_t button)
+{
+    return gpio_get_level(s_button_gpio[button]) == 0;
+}
+
+//-----------------------------------------------------------------------------
+// Interrupt side
+//-----------------------------------------------------------------------------
+
+static void IRAM_ATTR button_isr_handler(void *arg)
+{
+    button_id_t button = (button_id_t)(uintptr_t)arg;
+
+    unsigned head = atomic_load_explicit(&s_edge_head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&s_edge_tail, memory_order_acquire);
+    if (head - tail >= EDGE_RING_SIZE) {
+        atomic_store_explicit(&s_edge_overflow, true, memory_order_relaxed);
+        return;
+    }
+
+    input_edge_t *edge = &s_edges[head & (EDGE_RING_SIZE - 1)];
+    edge->time_us = esp_timer_get_time();
+    edge->button = (uint8_t)button;
+    edge->pressed = read_button_raw(button);
+
+    atomic_store_explicit(&s_edge_head, head + 1, memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+// Event queue
+//-----------------------------------------------------------------------------
+
+static void push_event(button_id_t button, button_event_t event, int64_t time_us)
 {
-    return (uint32_t)(esp_timer_get_time() / 1000);
+    unsigned head = atomic_load_explicit(&s_event_head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&s_event_tail, memory_order_acquire);
+    if (head - tail >= EVENT_RING_SIZE) {
+        s_events_dropped++;
+        return;
+    }
+
+    input_event_t *ev = &s_events[head & (EVENT_RING_SIZE - 1)];
+    ev->time_us = time_us;
+    ev->trace_id = s_next_trace_id++;
+    ev->button = button;
+    ev->event = event;
+
+    atomic_store_explicit(&s_event_head, head + 1, memory_order_release);
 }
 
+bool input_get_event(input_event_t *event)
+{
+    unsigned tail = atomic_load_explicit(&s_event_tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&s_event_head, memory_order_acquire);
+    if (tail == head) {
+        return false;
+    }
+
+    *event = s_events[tail & (EVENT_RING_SIZE - 1)];
+    atomic_store_explicit(&s_event_tail, tail + 1, memory_order_release);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Gesture recognizer
+//-----------------------------------------------------------------------------
+
 /**
- * @brief Read raw button state (active LOW)
+ * @brief Per-button recognizer states
  */
-static inline bool read_button_raw(button_id_t button)
+typedef enum {
+    GS_IDLE = 0,        // Released, nothing pending
+    GS_DOWN,            // Pressed, outcome still open
+    GS_WAIT_SECOND,     // Clicked once, double-click window running
+    GS_DOWN_SECOND,     // Second press of a possible double-click
+    GS_HELD,            // Long press fired, repeats running
+    GS_SWALLOW,         // Used up by a chord/hold-click, ignore until release
+} gesture_state_t;
+
+/**
+ * @brief Recognizer inputs, derived from debounced edges
+ */
+typedef enum {
+    GI_PRESS = 0,
+    GI_CHORD_PRESS,     // Pressed within the chord window of the other button
+    GI_RELEASE,
+    GI_HOLD_RELEASE,    // Released while the other (earlier) button is held
+    GI_LONG,            // Long press threshold reached
+    GI_TIMEOUT,         // Double-click window expired
+    GI_COMBO,           // Other button completed a chord/hold-click with us
+    GI_COUNT
+} gesture_input_t;
+
+// Rule actions (bit set, emitted in this order)
+#define GA_CLICK            (1 << 0)
+#define GA_DOUBLE_CLICK     (1 << 1)
+#define GA_LONG_PRESS       (1 << 2)
+#define GA_CHORD            (1 << 3)
+#define GA_HOLD_CLICK       (1 << 4)
+#define GA_COMBO            (1 << 5)    // Feed GI_COMBO to the other button
+#define GA_ARM              (1 << 6)    // Start the double-click window
+
+#define GESTURE_ANY         (-1)
+
+typedef struct {
+    uint8_t state;      // gesture_state_t
+    uint8_t input;      // gesture_input_t
+    int8_t requires;    // input_gesture_t that must be bound, or GESTURE_ANY
+    uint8_t next;       // gesture_state_t
+    uint8_t actions;    // GA_* bits
+} gesture_rule_t;
+
+// First matching row wins. Rows that need a gesture are skipped while it
+// is unbound, so the plain rows below them apply with no added delay.
+static const gesture_rule_t s_gesture_rules[] = {
+    // state          input            requires                    next            actions
+    { GS_IDLE,        GI_CHORD_PRESS,  INPUT_GESTURE_CHORD,        GS_SWALLOW,     GA_CHORD | GA_COMBO },
+    { GS_IDLE,        GI_PRESS,        GESTURE_ANY,                GS_DOWN,        0 },
+    { GS_DOWN,        GI_HOLD_RELEASE, INPUT_GESTURE_HOLD_CLICK,   GS_IDLE,        GA_HOLD_CLICK | GA_COMBO },
+    { GS_DOWN,        GI_RELEASE,      INPUT_GESTURE_DOUBLE_CLICK, GS_WAIT_SECOND, GA_ARM },
+    { GS_DOWN,        GI_RELEASE,      GESTURE_ANY,                GS_IDLE,        GA_CLICK },
+    { GS_DOWN,        GI_LONG,         GESTURE_ANY,                GS_HELD,        GA_LONG_PRESS },
+    { GS_DOWN,        GI_COMBO,        GESTURE_ANY,                GS_SWALLOW,     0 },
+    { GS_WAIT_SECOND, GI_PRESS,        GESTURE_ANY,                GS_DOWN_SECOND, 0 },
+    { GS_WAIT_SECOND, GI_TIMEOUT,      GESTURE_ANY,                GS_IDLE,        GA_CLICK },
+    { GS_DOWN_SECOND, GI_RELEASE,      GESTURE_ANY,                GS_IDLE,        GA_DOUBLE_CLICK },
+    { GS_DOWN_SECOND, GI_LONG,         GESTURE_ANY,                GS_HELD,        GA_CLICK | GA_LONG_PRESS },
+    { GS_DOWN_SECOND, GI_COMBO,        GESTURE_ANY,                GS_SWALLOW,     GA_CLICK },
+    { GS_HELD,        GI_RELEASE,      GESTURE_ANY,                GS_IDLE,        0 },
+    { GS_HELD,        GI_COMBO,        GESTURE_ANY,                GS_SWALLOW,     0 },
+    { GS_SWALLOW,     GI_RELEASE,      GESTURE_ANY,                GS_IDLE,        0 },
+};
+
+#define GESTURE_RULE_COUNT  (sizeof(s_gesture_rules) / sizeof(s_gesture_rules[0]))
+
+// Input to retry with when no rule matches (GI_COUNT = give up)
+static const uint8_t s_gesture_fallback[GI_COUNT] = {
+    [GI_PRESS] = GI_COUNT,
+    [GI_CHORD_PRESS] = GI_PRESS,
+    [GI_RELEASE] = GI_COUNT,
+    [GI_HOLD_RELEASE] = GI_RELEASE,
+    [GI_LONG] = GI_COUNT,
+    [GI_TIMEOUT] = GI_COUNT,
+    [GI_COMBO] = GI_COUNT,
+};
+
+static const struct {
+    uint8_t action;
+    button_event_t event;
+} s_gesture_events[] = {
+    { GA_CLICK,        BUTTON_EVENT_CLICK },
+    { GA_DOUBLE_CLICK, BUTTON_EVENT_DOUBLE_CLICK },
+    { GA_LONG_PRESS,   BUTTON_EVENT_LONG_PRESS },
+    { GA_CHORD,        BUTTON_EVENT_CHORD },
+    { GA_HOLD_CLICK,   BUTTON_EVENT_HOLD_CLICK },
+};
+
+static inline button_id_t other_button(button_id_t id)
 {
-    return gpio_get_level(s_button_gpio[button]) == 0;
+    return (id == BUTTON_LEFT) ? BUTTON_RIGHT : BUTTON_LEFT;
+}
+
+/**
+ * @brief Run one recognizer input through the rule table
+ */
+static void gesture_feed(button_id_t id, gesture_input_t input, int64_t time_us)
+{
+    button_state_t *btn = &s_buttons[id];
+    uint32_t mask = atomic_load_explicit(&s_gesture_mask, memory_order_relaxed);
+
+    while (input != GI_COUNT) {
+        for (size_t r = 0; r < GESTURE_RULE_COUNT; r++) {
+            const gesture_rule_t *rule = &s_gesture_rules[r];
+            if (rule->state != btn->gesture || rule->input != input) continue;
+            if (rule->requires != GESTURE_ANY &&
+                !(mask & INPUT_GESTURE_BIT(rule->requires, id))) continue;
+
+            btn->gesture = rule->next;
+            if (rule->actions & GA_ARM) {
+                btn->gesture_since_us = time_us;
+            }
+            for (size_t e = 0; e < sizeof(s_gesture_events) / sizeof(s_gesture_events[0]); e++) {
+                if (rule->actions & s_gesture_events[e].action) {
+                    push_event(id, s_gesture_events[e].event, time_us);
+                }
+            }
+            if (rule->actions & GA_COMBO) {
+                gesture_feed(other_button(id), GI_COMBO, time_us);
+            }
+            return;
+        }
+        input = s_gesture_fallback[input];
+    }
 }
 
+/**
+ * @brief Close double-click windows that ended before a time
+ *
+ * The resulting click keeps the time of its release edge, so latency
+ * measured from event timestamps includes the double-click wait.
+ */
+static void gesture_expire(int64_t until_us)
+{
+    int64_t window_us = (int64_t)s_gesture_config.double_click_ms * 1000;
+    for (int i = 0; i < BUTTON_COUNT; i++) {
+        button_state_t *btn = &s_buttons[i];
+        if (btn->gesture == GS_WAIT_SECOND && until_us - btn->gesture_since_us >= window_us) {
+            gesture_feed((button_id_t)i, GI_TIMEOUT, btn->gesture_since_us);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Debounce and classification (all on edge timestamps)
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief Emit long press / repeat events that fall due up to a time
+ */
+static void classify_hold(button_id_t id, int64_t until_us)
+{
+    button_state_t *btn = &s_buttons[id];
+    if (!btn->is_pressed) return;
+
+    if (!btn->long_press_fired) {
+        int64_t due = btn->press_start_us + LONG_PRESS_US;
+        if (until_us < due) return;
+        btn->long_press_fired = true;
+        btn->last_event_us = due;
+        gesture_feed(id, GI_LONG, due);
+    }
+
+    // Repeat while held (after long press, unless used by a gesture)
+    if (btn->gesture != GS_HELD) return;
+    while (until_us - btn->last_event_us >= REPEAT_RATE_US) {
+        btn->last_event_us += REPEAT_RATE_US;
+        push_event(id, BUTTON_EVENT_REPEAT, btn->last_event_us);
+    }
+}
+
+/**
+ * @brief Accept a debounced state change that started at time_us
+ */
+static void commit_state(button_id_t id, bool pressed, int64_t time_us)
+{
+    button_state_t *btn = &s_buttons[id];
+    const button_state_t *other = &s_buttons[other_button(id)];
+
+    gesture_expire(time_us);
+
+    if (pressed) {
+        btn->is_pressed = true;
+        btn->press_start_us = time_us;
+        btn->last_event_us = time_us;
+        btn->long_press_fired = false;
+        push_event(id, BUTTON_EVENT_PRESSED, time_us);
+
+        bool chord = other->is_pressed && other->gesture == GS_DOWN &&
+                     time_us - other->press_start_us <= (int64_t)s_gesture_config.chord_ms * 1000;
+        gesture_feed(id, chord ? GI_CHORD_PRESS : GI_PRESS, time_us);
+    } else {
+        classify_hold(id, time_us);
+        btn->is_pressed = false;
+
+        bool held = other->is_pressed && other->press_start_us < btn->press_start_us &&
+                    (other->gesture == GS_DOWN || other->gesture == GS_HELD);
+        gesture_feed(id, held ? GI_HOLD_RELEASE : GI_RELEASE, time_us);
+        push_event(id, BUTTON_EVENT_RELEASED, time_us);
+    }
+}
+
+/**
+ * @brief Feed one raw edge into the debouncer
+ *
+ * A level counts once it has been stable for DEBOUNCE_US. When the next
+ * edge arrives, the previous level's stable time is already known, so a
+ * tap that starts and ends between two input_update() calls still yields
+ * a press and a release at their true times.
+ */
+static void debounce_edge(button_id_t id, bool pressed, int64_t time_us)
+{
+    button_state_t *btn = &s_buttons[id];
+    if (pressed == btn->raw_pressed) return;  // Missed opposite edge
+
+    if (btn->raw_pressed != btn->is_pressed &&
+        time_us - btn->raw_since_us >= DEBOUNCE_US) {
+        commit_state(id, btn->raw_pressed, btn->raw_since_us);
+    }
+
+    btn->raw_pressed = pressed;
+    btn->raw_since_us = time_us;
+}
+
+static void debounce_poll(button_id_t id, int64_t now_us)
+{
+    button_state_t *btn = &s_buttons[id];
+
+    if (btn->raw_pressed != btn->is_pressed &&
+        now_us - btn->raw_since_us >= DEBOUNCE_US) {
+        commit_state(id, btn->raw_pressed, btn->raw_since_us);
+    }
+    gesture_expire(now_us);
+    classify_hold(id, now_us);
+}
+
+//-----------------------------------------------------------------------------
+// Public functions
+//-----------------------------------------------------------------------------
+
 esp_err_t input_init(void)
 {
     ESP_LOGI(TAG, "Initializing button input");
 
-    // Configure button GPIOs
+    // Configure button GPIOs with edge interrupts
     gpio_config_t io_conf = {
         .pin_bit_mask = (1ULL << BUTTON_LEFT_GPIO) | (1ULL << BUTTON_RIGHT_GPIO),
         .mode = GPIO_MODE_INPUT,
         .pull_up_en = GPIO_PULLUP_ENABLE,
         .pull_down_en = GPIO_PULLDOWN_DISABLE,
-        .intr_type = GPIO_INTR_DISABLE,
+        .intr_type = GPIO_INTR_ANYEDGE,
     };
     esp_err_t ret = gpio_config(&io_conf);
     if (ret != ESP_OK) {
@@ -68,102 +412,96 @@ esp_err_t input_init(void)
         return ret;
     }
 
-    // Initialize button states
+    // Initialize button states (a button held during boot is ignored
+    // until it is released and pressed again)
+    int64_t now = esp_timer_get_time();
     for (int i = 0; i < BUTTON_COUNT; i++) {
         s_buttons[i].is_pressed = false;
         s_buttons[i].was_pressed = false;
-        s_buttons[i].press_start_ms = 0;
-        s_buttons[i].last_event_ms = 0;
+        s_buttons[i].raw_pressed = false;
+        s_buttons[i].raw_since_us = now;
+        s_buttons[i].press_start_us = 0;
+        s_buttons[i].last_event_us = 0;
         s_buttons[i].long_press_fired = false;
+        s_buttons[i].gesture = GS_IDLE;
+        s_buttons[i].gesture_since_us = 0;
+    }
+    atomic_store(&s_gesture_mask, 0);
+
+    atomic_store(&s_edge_head, 0);
+    atomic_store(&s_edge_tail, 0);
+    atomic_store(&s_edge_overflow, false);
+    atomic_store(&s_event_head, 0);
+    atomic_store(&s_event_tail, 0);
+
+    // Not ESP_INTR_FLAG_IRAM: edges during flash writes are held pending
+    // and stamped late rather than requiring the whole path in IRAM
+    ret = gpio_install_isr_service(0);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "ISR service install failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    for (int i = 0; i < BUTTON_COUNT; i++) {
+        ret = gpio_isr_handler_add(s_button_gpio[i], button_isr_handler, (void *)(uintptr_t)i);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "ISR handler add failed: %s", esp_err_to_name(ret));
+            return ret;
+        }
     }
-
-    s_last_update_ms = get_ms();
 
     ESP_LOGI(TAG, "Buttons initialized: LEFT=GPIO%d, RIGHT=GPIO%d",
              BUTTON_LEFT_GPIO, BUTTON_RIGHT_GPIO);
     return ESP_OK;
 }
 
-void input_register_callback(button_callback_t callback)
-{
-    s_callback = callback;
-}
-
 void input_update(void)
 {
-    uint32_t now = get_ms();
-
+    TRACE_ZONE("input_update");
     for (int i = 0; i < BUTTON_COUNT; i++) {
-        button_state_t *btn = &s_buttons[i];
-
-        // Save previous state
-        btn->was_pressed = btn->is_pressed;
-
-        // Read current state with debounce
-        bool raw_state = read_button_raw(i);
-
-        // Simple debounce: only change state if stable for DEBOUNCE_MS
-        static uint32_t s_debounce_start[BUTTON_COUNT] = {0};
-        static bool s_debounce_state[BUTTON_COUNT] = {false};
-
-        if (raw_state != s_debounce_state[i]) {
-            s_debounce_start[i] = now;
-            s_debounce_state[i] = raw_state;
-        } else if ((now - s_debounce_start[i]) >= DEBOUNCE_MS) {
-            btn->is_pressed = raw_state;
-        }
+        s_buttons[i].was_pressed = s_buttons[i].is_pressed;
+    }
 
-        // Detect press event
-        if (btn->is_pressed && !btn->was_pressed) {
-            btn->press_start_ms = now;
-            btn->long_press_fired = false;
-            btn->last_event_ms = now;
+    // Drain edges captured since the last update
+    unsigned tail = atomic_load_explicit(&s_edge_tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&s_edge_head, memory_order_acquire);
+    while (tail != head) {
+        const input_edge_t *edge = &s_edges[tail & (EDGE_RING_SIZE - 1)];
+        debounce_edge((button_id_t)edge->button, edge->pressed, edge->time_us);
+        tail++;
+    }
+    atomic_store_explicit(&s_edge_tail, tail, memory_order_release);
 
-            if (s_callback) {
-                s_callback((button_id_t)i, BUTTON_EVENT_PRESSED);
-            }
-        }
+    int64_t now = esp_timer_get_time();
 
-        // Detect release event
-        if (!btn->is_pressed && btn->was_pressed) {
-            if (!btn->long_press_fired) {
-                // Short press completed - send click event
-                if (s_callback) {
-                    s_callback((button_id_t)i, BUTTON_EVENT_CLICK);
-                }
-            }
-            if (s_callback) {
-                s_callback((button_id_t)i, BUTTON_EVENT_RELEASED);
-            }
+    // Edges were lost: resynchronise with the pin levels
+    if (atomic_exchange_explicit(&s_edge_overflow, false, memory_order_relaxed)) {
+        ESP_LOGW(TAG, "Edge ring overflow, resyncing");
+        for (int i = 0; i < BUTTON_COUNT; i++) {
+            debounce_edge((button_id_t)i, read_button_raw((button_id_t)i), now);
         }
+    }
 
-        // Detect long press
-        if (btn->is_pressed && !btn->long_press_fired) {
-            uint32_t hold_time = now - btn->press_start_ms;
-            if (hold_time >= LONG_PRESS_MS) {
-                btn->long_press_fired = true;
-                btn->last_event_ms = now;
+    for (int i = 0; i < BUTTON_COUNT; i++) {
+        debounce_poll((button_id_t)i, now);
+    }
 
-                if (s_callback) {
-                    s_callback((button_id_t)i, BUTTON_EVENT_LONG_PRESS);
-                }
-            }
-        }
+    if (s_events_dropped) {
+        ESP_LOGW(TAG, "Event queue full, dropped %lu events", (unsigned long)s_events_dropped);
+        s_events_dropped = 0;
+    }
+}
 
-        // Detect repeat (after long press)
-        if (btn->is_pressed && btn->long_press_fired) {
-            uint32_t since_last = now - btn->last_event_ms;
-            if (since_last >= REPEAT_RATE_MS) {
-                btn->last_event_ms = now;
+void input_set_gestures(uint32_t mask)
+{
+    // A pending double-click window keeps running and resolves to a click
+    atomic_store_explicit(&s_gesture_mask, mask, memory_order_relaxed);
+}
 
-                if (s_callback) {
-                    s_callback((button_id_t)i, BUTTON_EVENT_REPEAT);
-                }
-            }
-        }
+void input_set_gesture_config(const input_gesture_config_t *config)
+{
+    if (config) {
+        s_gesture_config = *config;
     }
-
-    s_last_update_ms = now;
 }
 
 bool input_is_pressed(button_id_t button)
@@ -188,7 +526,7 @@ uint32_t input_get_hold_time(button_id_t button)
 {
     if (button >= BUTTON_COUNT) return 0;
     if (!s_buttons[button].is_pressed) return 0;
-    return get_ms() - s_buttons[button].press_start_ms;
+    return (uint32_t)((esp_timer_get_time() - s_buttons[button].press_start_us) / 1000);
 }
 
 void input_clear_events(void)
@@ -196,5 +534,10 @@ void input_clear_events(void)
     for (int i = 0; i < BUTTON_COUNT; i++) {
         s_buttons[i].was_pressed = s_buttons[i].is_pressed;
         s_buttons[i].long_press_fired = true;  // Prevent pending events
+        s_buttons[i].gesture = s_buttons[i].is_pressed ? GS_SWALLOW : GS_IDLE;
     }
+
+    // Consumer side: dropping everything queued is just moving the tail
+    unsigned head = atomic_load_explicit(&s_event_head, memory_order_acquire);
+    atomic_store_explicit(&s_event_tail, head, memory_order_release);
 }
@@ -0,0 +1,130 @@
+/**
+ * @file latency.h
+ * @brief Input-to-photon latency tracing for ESP32 Tamagotchi
+ *
+ * REQ-SW-050: Input Latency Tracing
+ * Follows each input event from its GPIO edge timestamp through
+ * game_handle_input(), the frame that redraws the affected screen region,
+ * and the last SPI pixel transaction inside that region. Stage latencies
+ * are collected in 1 ms histograms and reported as p50/p95/p99 over UART.
+ *
+ * Call order per frame:
+ *   simulation task: latency_begin() / latency_mark_region() / latency_end()
+ *                    per input event, latency_frame_queue() at the handoff
+ *   render task:     latency_frame_begin(), latency_pixels() per SPI write,
+ *                    latency_frame_end()
+ * Each trace is owned by one task at a time (REQ-SW-037): the simulation
+ * task until it is queued, the render task from then until it is freed.
+ */
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stdint.h>
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define LATENCY_MAX_TRACES      8       // Events in flight at once
+#define LATENCY_BUCKETS         256     // 1 ms per bucket, last = overflow
+#define LATENCY_MAX_FRAMES      3       // Drop traces not redrawn by then
+
+//=============================================================================
+// Types
+//=============================================================================
+
+/**
+ * @brief Pipeline stages measured for each traced event
+ */
+typedef enum {
+    LATENCY_STAGE_QUEUE = 0,    // Edge -> dispatched to the game
+    LATENCY_STAGE_WAIT,         // Dispatched -> frame render starts
+    LATENCY_STAGE_RENDER,       // Render start -> last SPI write in region
+    LATENCY_STAGE_TOTAL,        // Edge -> last SPI write in region
+    LATENCY_STAGE_COUNT
+} latency_stage_t;
+
+// Histogram memory (REQ-SW-039): a u16 histogram per stage
+#define LATENCY_RAM_BYTES       (LATENCY_STAGE_COUNT * LATENCY_BUCKETS * 2)
+
+/**
+ * @brief Summary of one stage histogram
+ */
+typedef struct {
+    uint32_t count;
+    uint16_t p50_ms;
+    uint16_t p95_ms;
+    uint16_t p99_ms;
+    uint16_t max_ms;
+} latency_summary_t;
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+/**
+ * @brief Clear all histograms and in-flight traces
+ */
+void latency_reset(void);
+
+/**
+ * @brief Start tracing an input event as it is dispatched
+ * @param trace_id Event ID assigned by the input queue
+ * @param edge_us Edge timestamp of the event (esp_timer time)
+ */
+void latency_begin(uint16_t trace_id, int64_t edge_us);
+
+/**
+ * @brief Add a screen area changed by the event being dispatched
+ *
+ * No-op outside latency_begin()/latency_end(). Events that mark no area
+ * had no visible effect and are not measured.
+ */
+void latency_mark_region(int16_t x, int16_t y, int16_t w, int16_t h);
+
+/**
+ * @brief Finish dispatching the current event
+ */
+void latency_end(void);
+
+/**
+ * @brief Hand dispatched events to the frame being published
+ *
+ * Events dispatched later wait for the next frame: the one in hand does
+ * not show them.
+ */
+void latency_frame_queue(void);
+
+/**
+ * @brief Mark the start of a frame render
+ */
+void latency_frame_begin(void);
+
+/**
+ * @brief Record an SPI pixel write (call after the transfer completes)
+ * @param x0 Window left (inclusive)
+ * @param y0 Window top (inclusive)
+ * @param x1 Window right (inclusive)
+ * @param y1 Window bottom (inclusive)
+ */
+void latency_pixels(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+/**
+ * @brief Mark the end of a frame render and close finished traces
+ */
+void latency_frame_end(void);
+
+/**
+ * @brief Get percentiles of one stage
+ * @param stage Which stage
+ * @param summary Output: count and percentiles (ms, bucket upper bound)
+ */
+void latency_get_summary(latency_stage_t stage, latency_summary_t *summary);
+
+/**
+ * @brief Log all stage percentiles (UART console)
+ */
+void latency_report(void);
+
+#endif // LATENCY_H
@@ -0,0 +1,99 @@
+/**
+ * @file telemetry.h
+ * @brief Frame-time telemetry for ESP32 Tamagotchi
+ *
+ * REQ-SW-053: Frame-time Telemetry
+ * Frame interval, simulation, render and SPI time go into fixed-bucket
+ * histograms kept per game state, next to a count of frames that came
+ * later than their deadline. Everything is static; a report logs p50,
+ * p95 and p99 per state and metric and starts a new window.
+ *
+ * Recording (per state; the simulation task records FRAME and SIM, the
+ * render task RENDER and SPI while it owns the frame):
+ *   telemetry_record(state, metric, us), telemetry_missed(state)
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define TELEMETRY_MAX_STATES    12      // Game states tracked
+#define TELEMETRY_BUCKETS       49      // See telemetry.c for the edges, last = overflow
+
+//=============================================================================
+// Types
+//=============================================================================
+
+typedef enum {
+    TELEMETRY_FRAME = 0,        // Start of one frame to the start of the next
+    TELEMETRY_SIM,              // Simulation task work per period
+    TELEMETRY_RENDER,           // game_render() incl. SPI, per frame
+    TELEMETRY_SPI,              // SPI transactions per frame
+    TELEMETRY_METRIC_COUNT
+} telemetry_metric_t;
+
+// Histogram memory (REQ-SW-039): per state, a u16 histogram, count and
+// maximum per metric, and the missed-deadline count
+#define TELEMETRY_RAM_BYTES     (TELEMETRY_MAX_STATES * \
+                                 (TELEMETRY_METRIC_COUNT * (TELEMETRY_BUCKETS * 2 + 8) + 4))
+
+/**
+ * @brief Percentiles of one metric in one state (us, bucket upper bounds)
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t p50_us;
+    uint32_t p95_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} telemetry_summary_t;
+
+/**
+ * @brief Game state names for the report
+ */
+typedef const char *(*telemetry_state_name_fn)(int state);
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+/**
+ * @brief Clear all histograms and set how states are named
+ * @param state_name Name lookup (NULL: states shown by number)
+ */
+void telemetry_init(telemetry_state_name_fn state_name);
+
+/**
+ * @brief Add one sample
+ */
+void telemetry_record(int state, telemetry_metric_t metric, uint32_t us);
+
+/**
+ * @brief Count a frame that started after its deadline
+ */
+void telemetry_missed(int state);
+
+/**
+ * @brief Get percentiles of one metric in one state for the current window
+ */
+void telemetry_get_summary(int state, telemetry_metric_t metric, telemetry_summary_t *summary);
+
+/**
+ * @brief Get the missed-deadline count of one state for the current window
+ */
+uint32_t telemetry_get_missed(int state);
+
+/**
+ * @brief Log every state that had frames this window
+ * @param reset Start a new window afterwards (periodic log); false for an
+ *        on-demand dump that leaves the window running
+ */
+void telemetry_report(bool reset);
+
+#endif // TELEMETRY_H
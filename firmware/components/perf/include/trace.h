@@ -0,0 +1,122 @@
+/**
+ * @file trace.h
+ * @brief Cycle-counter profiling zones for ESP32 Tamagotchi
+ *
+ * REQ-SW-052: Profiling Zones
+ * TRACE_ZONE("name") at the top of a scope records a begin event with
+ * the CPU cycle counter (CCOUNT) and an end event when the scope is left.
+ * Events go into a lock-free ring per core; the trace task streams them
+ * over a spare UART in small binary packets, and
+ * tools/trace_to_chrome.py turns a capture into Chrome trace JSON for
+ * chrome://tracing or Perfetto.
+ *
+ * Build with `idf.py -DTRACE=1 build` to enable. Otherwise TRACE_ENABLED
+ * is 0, the macros expand to nothing and trace.c compiles to an empty
+ * object: no code, no RAM.
+ *
+ * Stream format (little-endian), one packet:
+ *   0xA5 0x5A, u8 type, u16 payload length, payload, u8 sum of payload bytes
+ *   TRACE_PKT_INFO:   u16 CPU MHz, u8 zone count, per zone: u8 id, u8 len, name
+ *   TRACE_PKT_EVENTS: u8 core, u32 events dropped since boot, then
+ *                     per event: u32 cycles, u8 zone id, u8 phase
+ * A SYNC event (cycle count) is followed by a SYNC_US event whose cycles
+ * field holds esp_timer microseconds; each core emits the pair on its
+ * first event and about once a second, which lets the converter unwrap
+ * CCOUNT and put both cores on one time base.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED       0
+#endif
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define TRACE_MAX_ZONES     64      // Distinct zone names (ids 1..64)
+#define TRACE_RING_EVENTS   512     // Per core, power of two
+#define TRACE_FLUSH_MS      10      // Trace task period
+#define TRACE_INFO_MS       1000    // Zone table resent this often
+#define TRACE_RAM_BYTES     (TRACE_ENABLED ? 2 * TRACE_RING_EVENTS * 8 : 0)  // Rings (REQ-SW-039)
+
+#ifndef TRACE_UART_NUM
+#define TRACE_UART_NUM      1       // Console stays on UART0
+#endif
+#ifndef TRACE_UART_TX_GPIO
+#define TRACE_UART_TX_GPIO  26      // Free pin on the T-Display header
+#endif
+#ifndef TRACE_UART_BAUD
+#define TRACE_UART_BAUD     921600
+#endif
+
+#define TRACE_SYNC0         0xA5
+#define TRACE_SYNC1         0x5A
+
+typedef enum {
+    TRACE_PKT_INFO = 1,
+    TRACE_PKT_EVENTS = 2,
+} trace_packet_t;
+
+typedef enum {
+    TRACE_PHASE_BEGIN = 0,
+    TRACE_PHASE_END,
+    TRACE_PHASE_SYNC,           // cycles = CCOUNT at the sync point
+    TRACE_PHASE_SYNC_US,        // cycles = esp_timer time (us, low 32 bits)
+} trace_phase_t;
+
+//=============================================================================
+// Zone Macros
+//=============================================================================
+
+#if TRACE_ENABLED
+
+#include <stdatomic.h>
+#include "esp_err.h"
+
+#define TRACE_CAT_(a, b)    a##b
+#define TRACE_CAT(a, b)     TRACE_CAT_(a, b)
+
+/**
+ * @brief Profile the rest of the enclosing scope as zone `name`
+ *        (string literal; the id is assigned on first use)
+ */
+#define TRACE_ZONE(name) \
+    static atomic_uchar TRACE_CAT(s_trace_zone_, __LINE__); \
+    __attribute__((cleanup(trace_zone_end))) uint8_t TRACE_CAT(trace_scope_, __LINE__) = \
+        trace_zone_begin(&TRACE_CAT(s_trace_zone_, __LINE__), name)
+
+/**
+ * @brief Record a zone begin event (use TRACE_ZONE)
+ * @param slot Zone id, 0 until registered
+ * @return Zone id for trace_zone_end(), 0 if the zone table is full
+ */
+uint8_t trace_zone_begin(atomic_uchar *slot, const char *name);
+
+/**
+ * @brief Record a zone end event (scope cleanup of TRACE_ZONE)
+ */
+void trace_zone_end(const uint8_t *zone);
+
+/**
+ * @brief Install the trace UART (call once before trace_task runs)
+ * @return ESP_OK on success, or the UART driver error
+ */
+esp_err_t trace_init(void);
+
+/**
+ * @brief Trace task: streams both rings every TRACE_FLUSH_MS
+ */
+void trace_task(void *param);
+
+#else
+
+#define TRACE_ZONE(name)    do { } while (0)
+
+#endif // TRACE_ENABLED
+
+#endif // TRACE_H
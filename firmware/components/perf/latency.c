@@ -0,0 +1,258 @@
+/**
+ * @file latency.c
+ * @brief Input-to-photon latency tracing implementation
+ *
+ * REQ-SW-050: Input Latency Tracing
+ * REQ-SW-037: Multi-task Runtime
+ * The trace state is the only field both tasks touch: a slot is claimed
+ * by the simulation task once it reads TRACE_FREE and handed to the
+ * render task by TRACE_QUEUED, each with release/acquire ordering. The
+ * report reads the histograms without a lock and may miss the event
+ * being recorded.
+ */
+
+#include "latency.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <string.h>
+
+static const char *TAG = "latency";
+
+//=============================================================================
+// Types
+//=============================================================================
+
+typedef enum {
+    TRACE_FREE = 0,
+    TRACE_DISPATCH,     // Inside game_handle_input()
+    TRACE_PENDING,      // Waiting for the next frame handoff
+    TRACE_QUEUED,       // In the handed-over frame, render not started
+    TRACE_RENDER,       // Frame in progress, watching SPI writes
+} trace_state_t;
+
+typedef struct {
+    atomic_uchar state;         // trace_state_t
+    uint8_t frames;             // Frames rendered without touching region
+    uint16_t id;
+    int16_t x0, y0, x1, y1;     // Affected region, empty while x1 < x0
+    int64_t edge_us;
+    int64_t dispatch_us;
+    int64_t render_us;
+    int64_t photon_us;          // Last SPI write in region, 0 = none yet
+} latency_trace_t;
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+static latency_trace_t s_traces[LATENCY_MAX_TRACES];
+static latency_trace_t *s_current = NULL;
+static uint8_t s_rendering = 0;     // Traces in TRACE_RENDER
+static uint16_t s_hist[LATENCY_STAGE_COUNT][LATENCY_BUCKETS];
+_Static_assert(sizeof(s_hist) == LATENCY_RAM_BYTES, "latency histograms outside their budget");
+static uint32_t s_count[LATENCY_STAGE_COUNT];
+static uint32_t s_max_us[LATENCY_STAGE_COUNT];
+static atomic_uint s_dropped;
+
+static const char *s_stage_names[LATENCY_STAGE_COUNT] = {
+    [LATENCY_STAGE_QUEUE] = "queue",
+    [LATENCY_STAGE_WAIT] = "wait",
+    [LATENCY_STAGE_RENDER] = "render",
+    [LATENCY_STAGE_TOTAL] = "total",
+};
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+static void record(latency_stage_t stage, int64_t us)
+{
+    if (us < 0) us = 0;
+
+    uint32_t bucket = (uint32_t)(us / 1000);
+    if (bucket >= LATENCY_BUCKETS) bucket = LATENCY_BUCKETS - 1;
+    if (s_hist[stage][bucket] < UINT16_MAX) {
+        s_hist[stage][bucket]++;
+    }
+    s_count[stage]++;
+    if ((uint32_t)us > s_max_us[stage]) {
+        s_max_us[stage] = (uint32_t)us;
+    }
+}
+
+static void finish(latency_trace_t *t)
+{
+    record(LATENCY_STAGE_QUEUE, t->dispatch_us - t->edge_us);
+    record(LATENCY_STAGE_WAIT, t->render_us - t->dispatch_us);
+    record(LATENCY_STAGE_RENDER, t->photon_us - t->render_us);
+    record(LATENCY_STAGE_TOTAL, t->photon_us - t->edge_us);
+    ESP_LOGD(TAG, "#%u: %lld us", t->id, (long long)(t->photon_us - t->edge_us));
+    atomic_store_explicit(&t->state, TRACE_FREE, memory_order_release);
+}
+
+static uint16_t percentile(latency_stage_t stage, uint32_t total, uint32_t pct)
+{
+    uint32_t need = (total * pct + 99) / 100;
+    uint32_t seen = 0;
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        seen += s_hist[stage][i];
+        if (seen >= need) {
+            return (uint16_t)(i + 1);
+        }
+    }
+    return LATENCY_BUCKETS;
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+void latency_reset(void)
+{
+    memset(s_traces, 0, sizeof(s_traces));
+    memset(s_hist, 0, sizeof(s_hist));
+    memset(s_count, 0, sizeof(s_count));
+    memset(s_max_us, 0, sizeof(s_max_us));
+    s_current = NULL;
+    s_rendering = 0;
+    atomic_store(&s_dropped, 0);
+}
+
+void latency_begin(uint16_t trace_id, int64_t edge_us)
+{
+    s_current = NULL;
+    for (int i = 0; i < LATENCY_MAX_TRACES; i++) {
+        if (atomic_load_explicit(&s_traces[i].state, memory_order_acquire) == TRACE_FREE) {
+            s_current = &s_traces[i];
+            break;
+        }
+    }
+    if (!s_current) {
+        atomic_fetch_add_explicit(&s_dropped, 1, memory_order_relaxed);
+        return;
+    }
+
+    atomic_store_explicit(&s_current->state, TRACE_DISPATCH, memory_order_relaxed);
+    s_current->frames = 0;
+    s_current->id = trace_id;
+    s_current->x0 = INT16_MAX;
+    s_current->y0 = INT16_MAX;
+    s_current->x1 = INT16_MIN;
+    s_current->y1 = INT16_MIN;
+    s_current->edge_us = edge_us;
+    s_current->dispatch_us = esp_timer_get_time();
+    s_current->render_us = 0;
+    s_current->photon_us = 0;
+}
+
+void latency_mark_region(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    if (!s_current || w <= 0 || h <= 0) return;
+
+    if (x < s_current->x0) s_current->x0 = x;
+    if (y < s_current->y0) s_current->y0 = y;
+    if (x + w - 1 > s_current->x1) s_current->x1 = x + w - 1;
+    if (y + h - 1 > s_current->y1) s_current->y1 = y + h - 1;
+}
+
+void latency_end(void)
+{
+    if (!s_current) return;
+
+    // Nothing on screen changes: not an input-to-photon path
+    atomic_store_explicit(&s_current->state,
+                          (s_current->x1 < s_current->x0) ? TRACE_FREE : TRACE_PENDING,
+                          memory_order_relaxed);
+    s_current = NULL;
+}
+
+void latency_frame_queue(void)
+{
+    for (int i = 0; i < LATENCY_MAX_TRACES; i++) {
+        latency_trace_t *t = &s_traces[i];
+        if (atomic_load_explicit(&t->state, memory_order_relaxed) == TRACE_PENDING) {
+            atomic_store_explicit(&t->state, TRACE_QUEUED, memory_order_release);
+        }
+    }
+}
+
+void latency_frame_begin(void)
+{
+    int64_t now = esp_timer_get_time();
+    for (int i = 0; i < LATENCY_MAX_TRACES; i++) {
+        latency_trace_t *t = &s_traces[i];
+        if (atomic_load_explicit(&t->state, memory_order_acquire) == TRACE_QUEUED) {
+            atomic_store_explicit(&t->state, TRACE_RENDER, memory_order_relaxed);
+            t->render_us = now;
+            s_rendering++;
+        }
+    }
+}
+
+void latency_pixels(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    if (s_rendering == 0) return;
+
+    int64_t now = esp_timer_get_time();
+    for (int i = 0; i < LATENCY_MAX_TRACES; i++) {
+        latency_trace_t *t = &s_traces[i];
+        if (atomic_load_explicit(&t->state, memory_order_relaxed) != TRACE_RENDER) continue;
+        if (x1 < t->x0 || x0 > t->x1 || y1 < t->y0 || y0 > t->y1) continue;
+        t->photon_us = now;
+    }
+}
+
+void latency_frame_end(void)
+{
+    for (int i = 0; i < LATENCY_MAX_TRACES; i++) {
+        latency_trace_t *t = &s_traces[i];
+        if (atomic_load_explicit(&t->state, memory_order_relaxed) != TRACE_RENDER) continue;
+
+        if (t->photon_us != 0) {
+            finish(t);
+            s_rendering--;
+        } else if (++t->frames >= LATENCY_MAX_FRAMES) {
+            // Region never redrawn (screen only updates on change)
+            atomic_store_explicit(&t->state, TRACE_FREE, memory_order_release);
+            s_rendering--;
+            atomic_fetch_add_explicit(&s_dropped, 1, memory_order_relaxed);
+        }
+    }
+}
+
+void latency_get_summary(latency_stage_t stage, latency_summary_t *summary)
+{
+    memset(summary, 0, sizeof(*summary));
+    if (stage >= LATENCY_STAGE_COUNT || s_count[stage] == 0) return;
+
+    summary->count = s_count[stage];
+    summary->p50_ms = percentile(stage, s_count[stage], 50);
+    summary->p95_ms = percentile(stage, s_count[stage], 95);
+    summary->p99_ms = percentile(stage, s_count[stage], 99);
+    uint32_t max_ms = (s_max_us[stage] + 999) / 1000;
+    summary->max_ms = (max_ms > UINT16_MAX) ? UINT16_MAX : (uint16_t)max_ms;
+
+    // Bucket upper bounds can overshoot the exact maximum
+    if (summary->p50_ms > summary->max_ms) summary->p50_ms = summary->max_ms;
+    if (summary->p95_ms > summary->max_ms) summary->p95_ms = summary->max_ms;
+    if (summary->p99_ms > summary->max_ms) summary->p99_ms = summary->max_ms;
+}
+
+void latency_report(void)
+{
+    if (s_count[LATENCY_STAGE_TOTAL] == 0) return;
+
+    for (int s = 0; s < LATENCY_STAGE_COUNT; s++) {
+        latency_summary_t sum;
+        latency_get_summary((latency_stage_t)s, &sum);
+        ESP_LOGI(TAG, "%-6s n=%lu p50=%ums p95=%ums p99=%ums max=%ums",
+                 s_stage_names[s], (unsigned long)sum.count,
+                 sum.p50_ms, sum.p95_ms, sum.p99_ms, sum.max_ms);
+    }
+    unsigned dropped = atomic_load_explicit(&s_dropped, memory_order_relaxed);
+    if (dropped) {
+        ESP_LOGI(TAG, "dropped %lu traces", (unsigned long)dropped);
+    }
+}
@@ -0,0 +1,198 @@
+/**
+ * @file telemetry.c
+ * @brief Frame-time telemetry implementation
+ *
+ * REQ-SW-053: Frame-time Telemetry
+ */
+
+#include "telemetry.h"
+#include "esp_log.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "telemetry";
+
+//=============================================================================
+// Configuration
+//=============================================================================
+
+// Bucket edges: 0.5 ms steps to 8 ms (SPI, render), 2 ms steps to 40 ms
+// (frame intervals around 33 ms), 8 ms steps to 168 ms, then overflow
+#define FINE_US             500
+#define FINE_END_US         8000
+#define MID_US              2000
+#define MID_END_US          40000
+#define COARSE_US           8000
+#define COARSE_END_US       168000
+#define FINE_BUCKETS        (FINE_END_US / FINE_US)
+#define MID_BUCKETS         ((MID_END_US - FINE_END_US) / MID_US)
+#define COARSE_BUCKETS      ((COARSE_END_US - MID_END_US) / COARSE_US)
+
+_Static_assert(FINE_BUCKETS + MID_BUCKETS + COARSE_BUCKETS + 1 == TELEMETRY_BUCKETS,
+               "bucket edges do not match TELEMETRY_BUCKETS");
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+typedef struct {
+    uint16_t hist[TELEMETRY_METRIC_COUNT][TELEMETRY_BUCKETS];
+    uint32_t count[TELEMETRY_METRIC_COUNT];
+    uint32_t max_us[TELEMETRY_METRIC_COUNT];
+    uint32_t missed;
+} state_telemetry_t;
+
+static state_telemetry_t s_states[TELEMETRY_MAX_STATES];
+_Static_assert(sizeof(s_states) == TELEMETRY_RAM_BYTES, "telemetry outside its budget");
+static telemetry_state_name_fn s_state_name = NULL;
+
+static const char *s_metric_names[TELEMETRY_METRIC_COUNT] = {
+    [TELEMETRY_FRAME] = "frame",
+    [TELEMETRY_SIM] = "sim",
+    [TELEMETRY_RENDER] = "render",
+    [TELEMETRY_SPI] = "spi",
+};
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+static int bucket_of(uint32_t us)
+{
+    if (us < FINE_END_US) return us / FINE_US;
+    if (us < MID_END_US) return FINE_BUCKETS + (us - FINE_END_US) / MID_US;
+    if (us < COARSE_END_US) return FINE_BUCKETS + MID_BUCKETS + (us - MID_END_US) / COARSE_US;
+    return TELEMETRY_BUCKETS - 1;
+}
+
+static uint32_t bucket_upper_us(int bucket)
+{
+    if (bucket < FINE_BUCKETS) return (bucket + 1) * FINE_US;
+    bucket -= FINE_BUCKETS;
+    if (bucket < MID_BUCKETS) return FINE_END_US + (bucket + 1) * MID_US;
+    bucket -= MID_BUCKETS;
+    if (bucket < COARSE_BUCKETS) return MID_END_US + (bucket + 1) * COARSE_US;
+    return UINT32_MAX;      // Overflow: clamped to the maximum by the caller
+}
+
+static uint32_t percentile(const uint16_t *hist, uint32_t total, uint32_t pct)
+{
+    uint32_t need = (total * pct + 99) / 100;
+    uint32_t seen = 0;
+    for (int i = 0; i < TELEMETRY_BUCKETS; i++) {
+        seen += hist[i];
+        if (seen >= need) {
+            return bucket_upper_us(i);
+        }
+    }
+    return UINT32_MAX;
+}
+
+static inline bool valid_state(int state)
+{
+    return state >= 0 && state < TELEMETRY_MAX_STATES;
+}
+
+/**
+ * @brief Format microseconds as milliseconds with one decimal
+ */
+static const char *fmt_ms(char *buf, size_t len, uint32_t us)
+{
+    snprintf(buf, len, "%lu.%lu", (unsigned long)(us / 1000), (unsigned long)(us % 1000 / 100));
+    return buf;
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+void telemetry_init(telemetry_state_name_fn state_name)
+{
+    memset(s_states, 0, sizeof(s_states));
+    s_state_name = state_name;
+    ESP_LOGI(TAG, "%u states x %u metrics x %u buckets, %u bytes",
+             (unsigned)TELEMETRY_MAX_STATES, (unsigned)TELEMETRY_METRIC_COUNT,
+             (unsigned)TELEMETRY_BUCKETS,
+             (unsigned)sizeof(s_states));
+}
+
+void telemetry_record(int state, telemetry_metric_t metric, uint32_t us)
+{
+    if (!valid_state(state) || metric >= TELEMETRY_METRIC_COUNT) return;
+
+    state_telemetry_t *st = &s_states[state];
+    uint16_t *slot = &st->hist[metric][bucket_of(us)];
+    if (*slot < UINT16_MAX) {
+        (*slot)++;
+    }
+    st->count[metric]++;
+    if (us > st->max_us[metric]) {
+        st->max_us[metric] = us;
+    }
+}
+
+void telemetry_missed(int state)
+{
+    if (valid_state(state)) {
+        s_states[state].missed++;
+    }
+}
+
+void telemetry_get_summary(int state, telemetry_metric_t metric, telemetry_summary_t *summary)
+{
+    memset(summary, 0, sizeof(*summary));
+    if (!valid_state(state) || metric >= TELEMETRY_METRIC_COUNT) return;
+
+    const state_telemetry_t *st = &s_states[state];
+    uint32_t total = st->count[metric];
+    if (total == 0) return;
+
+    summary->count = total;
+    summary->max_us = st->max_us[metric];
+    summary->p50_us = percentile(st->hist[metric], total, 50);
+    summary->p95_us = percentile(st->hist[metric], total, 95);
+    summary->p99_us = percentile(st->hist[metric], total, 99);
+
+    // Bucket upper bounds can overshoot the exact maximum
+    if (summary->p50_us > summary->max_us) summary->p50_us = summary->max_us;
+    if (summary->p95_us > summary->max_us) summary->p95_us = summary->max_us;
+    if (summary->p99_us > summary->max_us) summary->p99_us = summary->max_us;
+}
+
+uint32_t telemetry_get_missed(int state)
+{
+    return valid_state(state) ? s_states[state].missed : 0;
+}
+
+void telemetry_report(bool reset)
+{
+    char p50[12], p95[12], p99[12], max[12], num[4];
+
+    for (int state = 0; state < TELEMETRY_MAX_STATES; state++) {
+        const state_telemetry_t *st = &s_states[state];
+        if (st->count[TELEMETRY_FRAME] == 0 && st->count[TELEMETRY_SIM] == 0) continue;
+
+        const char *name = s_state_name ? s_state_name(state) : NULL;
+        if (name == NULL) {
+            snprintf(num, sizeof(num), "%d", state);
+            name = num;
+        }
+        ESP_LOGI(TAG, "%-8s frames %lu, missed deadline %lu",
+                 name, (unsigned long)st->count[TELEMETRY_FRAME],
+                 (unsigned long)st->missed);
+
+        for (int m = 0; m < TELEMETRY_METRIC_COUNT; m++) {
+            telemetry_summary_t sum;
+            telemetry_get_summary(state, (telemetry_metric_t)m, &sum);
+            if (sum.count == 0) continue;
+            ESP_LOGI(TAG, "  %-6s n=%lu p50=%sms p95=%sms p99=%sms max=%sms",
+                     s_metric_names[m], (unsigned long)sum.count,
+                     fmt_ms(p50, sizeof(p50), sum.p50_us), fmt_ms(p95, sizeof(p95), sum.p95_us),
+                     fmt_ms(p99, sizeof(p99), sum.p99_us), fmt_ms(max, sizeof(max), sum.max_us));
+        }
+    }
+
+    if (reset) {
+        memset(s_states, 0, sizeof(s_states));
+    }
+}
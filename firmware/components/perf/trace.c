@@ -0,0 +1,270 @@
+/**
+ * @file trace.c
+ * @brief Cycle-counter profiling zones implementation
+ *
+ * REQ-SW-052: Profiling Zones
+ */
+
+#include "trace.h"
+
+#if TRACE_ENABLED
+
+#include "spsc_queue.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/uart.h"
+#include "esp_cpu.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+#include <string.h>
+
+static const char *TAG = "trace";
+
+//=============================================================================
+// Configuration
+//=============================================================================
+
+#define TRACE_CORES             2
+#define TRACE_SYNC_CYCLES       (1u << 28)  // ~1.1 s at 240 MHz, well inside a wrap
+#define TRACE_PACKET_EVENTS     64          // Events per EVENTS packet
+#define TRACE_EVENT_BYTES       6           // Packed on the wire
+#define TRACE_UART_TX_BUF       4096
+
+//=============================================================================
+// Types
+//=============================================================================
+
+typedef struct {
+    uint32_t cycles;
+    uint8_t zone;
+    uint8_t phase;              // trace_phase_t
+} trace_event_t;
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+// One ring per core. Only code on that core pushes, with interrupts
+// masked, so tasks and ISRs sharing a core never interleave a push;
+// the trace task is the single consumer.
+SPSC_QUEUE_DEFINE(s_ring0, trace_event_t, TRACE_RING_EVENTS);
+SPSC_QUEUE_DEFINE(s_ring1, trace_event_t, TRACE_RING_EVENTS);
+static spsc_queue_t *const s_rings[TRACE_CORES] = { &s_ring0, &s_ring1 };
+_Static_assert(sizeof(s_ring0_items) + sizeof(s_ring1_items) == TRACE_RAM_BYTES,
+               "trace rings outside their budget");
+
+static uint32_t s_sync_cycles[TRACE_CORES];
+static bool s_synced[TRACE_CORES];
+
+// Zone table; names[id] is set before s_zone_count covers it
+static const char *s_zone_names[TRACE_MAX_ZONES + 1];
+static atomic_uint s_zone_count;
+static portMUX_TYPE s_zone_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static uint8_t s_packet[5 + 5 + TRACE_PACKET_EVENTS * TRACE_EVENT_BYTES + 1];
+static bool s_uart_ready = false;
+
+//=============================================================================
+// Recording
+//=============================================================================
+
+static uint8_t register_zone(atomic_uchar *slot, const char *name)
+{
+    uint8_t id;
+
+    portENTER_CRITICAL(&s_zone_lock);
+    id = atomic_load_explicit(slot, memory_order_relaxed);
+    if (id == 0) {
+        unsigned count = atomic_load_explicit(&s_zone_count, memory_order_relaxed);
+        if (count < TRACE_MAX_ZONES) {
+            id = (uint8_t)(count + 1);
+            s_zone_names[id] = name;
+            atomic_store_explicit(&s_zone_count, count + 1, memory_order_release);
+            atomic_store_explicit(slot, id, memory_order_relaxed);
+        }
+    }
+    portEXIT_CRITICAL(&s_zone_lock);
+    return id;
+}
+
+static void IRAM_ATTR record(uint8_t zone, uint8_t phase)
+{
+    UBaseType_t irq = portSET_INTERRUPT_MASK_FROM_ISR();
+    int core = esp_cpu_get_core_id();
+    spsc_queue_t *ring = s_rings[core];
+    uint32_t now = esp_cpu_get_cycle_count();
+
+    if (!s_synced[core] || now - s_sync_cycles[core] >= TRACE_SYNC_CYCLES) {
+        trace_event_t sync = { now, 0, TRACE_PHASE_SYNC };
+        trace_event_t sync_us = { (uint32_t)esp_timer_get_time(), 0, TRACE_PHASE_SYNC_US };
+        if (spsc_push(ring, &sync) && spsc_push(ring, &sync_us)) {
+            s_sync_cycles[core] = now;
+            s_synced[core] = true;
+        } else {
+            s_synced[core] = false;     // Half a pair: the next event retries
+        }
+    }
+
+    trace_event_t ev = { now, zone, phase };
+    spsc_push(ring, &ev);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(irq);
+}
+
+uint8_t trace_zone_begin(atomic_uchar *slot, const char *name)
+{
+    uint8_t id = atomic_load_explicit(slot, memory_order_relaxed);
+    if (id == 0) {
+        id = register_zone(slot, name);
+        if (id == 0) return 0;
+    }
+    record(id, TRACE_PHASE_BEGIN);
+    return id;
+}
+
+void trace_zone_end(const uint8_t *zone)
+{
+    if (*zone) record(*zone, TRACE_PHASE_END);
+}
+
+//=============================================================================
+// Streaming
+//=============================================================================
+
+static inline uint8_t *put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+    return p + 2;
+}
+
+static inline uint8_t *put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = v >> 24;
+    return p + 4;
+}
+
+/**
+ * @brief Frame and send the payload written at s_packet + 5
+ */
+static void send_packet(trace_packet_t type, size_t len)
+{
+    uint8_t sum = 0;
+    for (size_t i = 0; i < len; i++) {
+        sum += s_packet[5 + i];
+    }
+    s_packet[0] = TRACE_SYNC0;
+    s_packet[1] = TRACE_SYNC1;
+    s_packet[2] = (uint8_t)type;
+    put_u16(&s_packet[3], (uint16_t)len);
+    s_packet[5 + len] = sum;
+    uart_write_bytes(TRACE_UART_NUM, s_packet, 5 + len + 1);
+}
+
+/**
+ * @brief Send the zone table, split over packets if it is long
+ */
+static void send_info(void)
+{
+    unsigned count = atomic_load_explicit(&s_zone_count, memory_order_acquire);
+    unsigned id = 1;
+
+    do {
+        uint8_t *p = put_u16(&s_packet[5], CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ);
+        uint8_t *n = p++;
+        *n = 0;
+        for (; id <= count; id++) {
+            size_t len = strlen(s_zone_names[id]);
+            if (len > 255) len = 255;
+            if ((size_t)(p - &s_packet[5]) + 2 + len > sizeof(s_packet) - 6) break;
+            *p++ = (uint8_t)id;
+            *p++ = (uint8_t)len;
+            memcpy(p, s_zone_names[id], len);
+            p += len;
+            (*n)++;
+        }
+        send_packet(TRACE_PKT_INFO, p - &s_packet[5]);
+    } while (id <= count);
+}
+
+/**
+ * @brief Send everything queued on one core
+ */
+static void send_events(int core)
+{
+    spsc_queue_t *ring = s_rings[core];
+    trace_event_t ev;
+
+    while (1) {
+        uint8_t *p = &s_packet[5];
+        *p++ = (uint8_t)core;
+        p = put_u32(p, atomic_load_explicit(&ring->dropped, memory_order_relaxed));
+
+        int n = 0;
+        while (n < TRACE_PACKET_EVENTS && spsc_pop(ring, &ev)) {
+            p = put_u32(p, ev.cycles);
+            *p++ = ev.zone;
+            *p++ = ev.phase;
+            n++;
+        }
+        if (n == 0) return;
+        send_packet(TRACE_PKT_EVENTS, p - &s_packet[5]);
+        if (n < TRACE_PACKET_EVENTS) return;
+    }
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+esp_err_t trace_init(void)
+{
+    uart_config_t cfg = {
+        .baud_rate = TRACE_UART_BAUD,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .source_clk = UART_SCLK_DEFAULT,
+    };
+
+    esp_err_t ret = uart_driver_install(TRACE_UART_NUM, 256, TRACE_UART_TX_BUF, 0, NULL, 0);
+    if (ret == ESP_OK) ret = uart_param_config(TRACE_UART_NUM, &cfg);
+    if (ret == ESP_OK) {
+        ret = uart_set_pin(TRACE_UART_NUM, TRACE_UART_TX_GPIO, UART_PIN_NO_CHANGE,
+                           UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Trace UART setup failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    s_uart_ready = true;
+    ESP_LOGI(TAG, "Streaming zones on UART%d (TX GPIO %d, %d baud), %u events per core",
+             TRACE_UART_NUM, TRACE_UART_TX_GPIO, TRACE_UART_BAUD, TRACE_RING_EVENTS);
+    return ESP_OK;
+}
+
+void trace_task(void *param)
+{
+    TickType_t last_info = 0;
+
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(TRACE_FLUSH_MS));
+        if (!s_uart_ready) continue;
+
+        TickType_t now = xTaskGetTickCount();
+        if (last_info == 0 || now - last_info >= pdMS_TO_TICKS(TRACE_INFO_MS)) {
+            send_info();
+            last_info = now;
+        }
+        for (int core = 0; core < TRACE_CORES; core++) {
+            send_events(core);
+        }
+    }
+}
+
+#endif // TRACE_ENABLED
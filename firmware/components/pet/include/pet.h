@@ -4,7 +4,9 @@
  *
  * REQ-SW-001: Pet State System
  * REQ-SW-002: Pet Life Stages
+ * REQ-SW-038: Pet State Snapshots
  * Manages all pet attributes, stat decay, and life stage progression.
+ * The simulation task owns the state and publishes copies for the others.
  */
 
 #ifndef PET_H
@@ -119,6 +121,16 @@ typedef struct {
     uint16_t times_medicated;
 } pet_state_t;
 
+/**
+ * @brief Snapshot publication counters (REQ-SW-038)
+ */
+typedef struct {
+    uint32_t publishes;         // pet_publish_snapshot() calls
+    uint32_t reads;             // pet_get_snapshot() calls
+    uint32_t retries;           // Reads repeated because a publish overlapped
+    uint32_t max_retries;       // Most retries of a single read
+} pet_snapshot_stats_t;
+
 //=============================================================================
 // Initialization
 //=============================================================================
@@ -136,6 +148,9 @@ void pet_new(void);
 
 /**
  * @brief Get pointer to current pet state
+ *
+ * Live state: simulation task only. Other tasks use pet_get_snapshot();
+ * the render task draws the copy in the game's frame view.
  * @return Pointer to pet state (read-only recommended)
  */
 const pet_state_t *pet_get_state(void);
@@ -146,6 +161,26 @@ const pet_state_t *pet_get_state(void);
  */
 pet_state_t *pet_get_state_mutable(void);
 
+/**
+ * @brief Publish the current state for other tasks (simulation task only)
+ *
+ * Never blocks. The state is copied into both halves of a sequence
+ * latch; while one half is rewritten, readers take the other.
+ */
+void pet_publish_snapshot(void);
+
+/**
+ * @brief Copy the last published state (any task, any core)
+ *
+ * Lock-free: retries only if a publish rewrote the half being read.
+ */
+void pet_get_snapshot(pet_state_t *out);
+
+/**
+ * @brief Get snapshot publication counters since boot
+ */
+void pet_get_snapshot_stats(pet_snapshot_stats_t *stats);
+
 //=============================================================================
 // Core Update
 //=============================================================================
@@ -250,6 +285,12 @@ uint32_t pet_get_age_days(void);
  */
 const char *pet_get_stage_name(void);
 
+/**
+ * @brief Get string name for a life stage (e.g. of a snapshot)
+ * @return Stage name string
+ */
+const char *pet_stage_name(pet_stage_t stage);
+
 /**
  * @brief Get string name for current mood
  * @return Mood name string
@@ -0,0 +1,120 @@
+/**
+ * @file pet_history.h
+ * @brief Multi-resolution stat history for ESP32 Tamagotchi
+ *
+ * REQ-SW-015: Stat Trend Graphs
+ * Keeps a mipmapped min/max/avg summary of the core stats. Each level
+ * holds PET_HISTORY_BUCKETS buckets; a bucket at level N summarises
+ * PET_HISTORY_FANOUT buckets of level N-1. All levels are maintained
+ * incrementally on append, so drawing a graph of any time window only
+ * touches as many buckets as the graph is wide.
+ */
+
+#ifndef PET_HISTORY_H
+#define PET_HISTORY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define PET_HISTORY_SAMPLE_MS   60000   // One level-0 sample per minute
+#define PET_HISTORY_LEVELS      5       // Spans: 1, 4, 16, 64, 256 minutes
+#define PET_HISTORY_FANOUT      4       // Buckets merged per level step
+#define PET_HISTORY_BUCKETS     160     // Buckets per level (= graph width)
+
+// History memory (REQ-SW-039): per level, the bucket ring of every stat,
+// the open bucket's accumulators and the ring bookkeeping
+#define PET_HISTORY_RAM_BYTES   (PET_HISTORY_LEVELS * \
+                                 (PET_HISTORY_BUCKETS * PET_HISTORY_STAT_COUNT * 3 + \
+                                  PET_HISTORY_STAT_COUNT * 4 + 8))
+
+//=============================================================================
+// Types
+//=============================================================================
+
+/**
+ * @brief Stats tracked by the history
+ */
+typedef enum {
+    PET_HISTORY_HUNGER = 0,
+    PET_HISTORY_HAPPINESS,
+    PET_HISTORY_HEALTH,
+    PET_HISTORY_ENERGY,
+    PET_HISTORY_STAT_COUNT
+} pet_history_stat_t;
+
+/**
+ * @brief Summary of one closed bucket
+ */
+typedef struct {
+    uint8_t min;
+    uint8_t max;
+    uint8_t avg;
+} pet_history_bucket_t;
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+/**
+ * @brief Clear all history (new pet)
+ */
+void pet_history_reset(void);
+
+/**
+ * @brief Advance the sample clock and record current stats when due
+ * @param delta_ms Time since last update in milliseconds
+ */
+void pet_history_update(uint32_t delta_ms);
+
+/**
+ * @brief Append one level-0 sample and fold it into the coarser levels
+ * @param values One value per pet_history_stat_t
+ */
+void pet_history_append(const uint8_t values[PET_HISTORY_STAT_COUNT]);
+
+/**
+ * @brief Get the time covered by one bucket of a level
+ * @param level Level index (0 = finest)
+ * @return Bucket span in minutes
+ */
+uint32_t pet_history_span_minutes(int level);
+
+/**
+ * @brief Pick the finest level that fits a time window into a pixel width
+ * @param window_min Time window to display in minutes
+ * @param width Graph width in pixels
+ * @return Level index (coarsest level if the window does not fit)
+ */
+int pet_history_select_level(uint32_t window_min, int width);
+
+/**
+ * @brief Get number of closed buckets available at a level
+ * @param level Level index
+ * @return Bucket count (0..PET_HISTORY_BUCKETS)
+ */
+int pet_history_count(int level);
+
+/**
+ * @brief Get number of buckets ever closed at a level
+ *
+ * Changes exactly when a new bucket closes, so renderers can compare it
+ * against the value seen at their last redraw.
+ * @param level Level index
+ * @return Monotonic bucket counter
+ */
+uint32_t pet_history_generation(int level);
+
+/**
+ * @brief Read a closed bucket
+ * @param level Level index
+ * @param stat Which stat
+ * @param age 0 = newest bucket, count-1 = oldest
+ * @return Pointer to bucket, NULL if out of range
+ */
+const pet_history_bucket_t *pet_history_get(int level, pet_history_stat_t stat, int age);
+
+#endif // PET_HISTORY_H
@@ -4,13 +4,16 @@
  *
  * REQ-SW-001: Pet State System
  * REQ-SW-002: Pet Life Stages
+ * REQ-SW-038: Pet State Snapshots
+ * REQ-SW-058: Pet Balance Simulator
  */
 
 #include "pet.h"
-#include "esp_timer.h"
+#include "sim.h"
+#include "trace.h"
 #include "esp_log.h"
-#include "esp_random.h"
 #include <string.h>
+#include <stdatomic.h>
 
 static const char *TAG = "pet";
 
@@ -18,11 +21,22 @@ static const char *TAG = "pet";
 // Configuration Constants
 //=============================================================================
 
+// Balance tunables can be overridden from the build (-D), which is how
+// tools/pet_balance tries other values (REQ-SW-058)
+
 // Stat decay rates (per minute)
+#ifndef HUNGER_DECAY_PER_MIN
 #define HUNGER_DECAY_PER_MIN        2
+#endif
+#ifndef HAPPINESS_DECAY_PER_MIN
 #define HAPPINESS_DECAY_PER_MIN     1
+#endif
+#ifndef ENERGY_DECAY_PER_MIN
 #define ENERGY_DECAY_PER_MIN        1   // Only when awake
+#endif
+#ifndef ENERGY_RESTORE_PER_MIN
 #define ENERGY_RESTORE_PER_MIN      5   // When sleeping
+#endif
 
 // Feeding effects
 #define FISH_HUNGER_GAIN            20
@@ -43,9 +57,15 @@ static const char *TAG = "pet";
 #define MEDICINE_HEALTH_RESTORE     40
 
 // Poop timing (in minutes)
+#ifndef POOP_INTERVAL_MIN
 #define POOP_INTERVAL_MIN           30      // 30 minutes minimum
+#endif
+#ifndef POOP_INTERVAL_MAX
 #define POOP_INTERVAL_MAX           90      // 90 minutes maximum
+#endif
+#ifndef POOP_HEALTH_PENALTY_PER_MIN
 #define POOP_HEALTH_PENALTY_PER_MIN 1
+#endif
 
 // Life stages (in minutes)
 #define EGG_DURATION_MIN            2       // 2 minutes to hatch
@@ -55,14 +75,28 @@ static const char *TAG = "pet";
 // Adult: 14+ days
 
 // Sickness threshold
+#ifndef SICK_THRESHOLD
 #define SICK_THRESHOLD              30
+#endif
+#ifndef SICK_DECAY_MULTIPLIER
 #define SICK_DECAY_MULTIPLIER       2
+#endif
 
 //=============================================================================
 // Static State
 //=============================================================================
 
-static pet_state_t s_pet = {0};
+static SIM_THREAD_LOCAL pet_state_t s_pet = {0};
+
+// Published copies for other tasks (sequence latch): s_snapshot_seq is
+// odd while copy 0 is rewritten and even while copy 1 is, so a reader
+// always has a stable copy and only retries if a publish overlapped it
+static pet_state_t s_snapshots[2];
+static atomic_uint s_snapshot_seq;
+static uint32_t s_snapshot_publishes = 0;  // Simulation task only
+static atomic_uint s_snapshot_reads;
+static atomic_uint s_snapshot_retries;
+static atomic_uint s_snapshot_max_retries;
 
 //=============================================================================
 // Helper Functions
@@ -70,7 +104,7 @@ static pet_state_t s_pet = {0};
 
 static inline uint32_t get_ms(void)
 {
-    return (uint32_t)(esp_timer_get_time() / 1000);
+    return sim_now_ms();  // Simulated time, see sim.h
 }
 
 static inline uint8_t clamp_stat(int32_t value)
@@ -89,7 +123,7 @@ static inline uint8_t clamp_weight(int32_t value)
 
 static uint32_t random_range(uint32_t min, uint32_t max)
 {
-    return min + (esp_random() % (max - min + 1));
+    return min + (sim_random() % (max - min + 1));
 }
 
 /**
@@ -264,12 +298,62 @@ pet_state_t *pet_get_state_mutable(void)
     return &s_pet;
 }
 
+void pet_publish_snapshot(void)
+{
+    unsigned seq = atomic_load_explicit(&s_snapshot_seq, memory_order_relaxed);
+
+    // Readers move to copy 1 while copy 0 is rewritten...
+    atomic_store_explicit(&s_snapshot_seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    s_snapshots[0] = s_pet;
+
+    // ...and back to copy 0 while copy 1 is
+    atomic_store_explicit(&s_snapshot_seq, seq + 2, memory_order_release);
+    atomic_thread_fence(memory_order_release);
+    s_snapshots[1] = s_pet;
+
+    s_snapshot_publishes++;
+}
+
+void pet_get_snapshot(pet_state_t *out)
+{
+    unsigned retries = 0;
+    unsigned seq;
+
+    while (1) {
+        seq = atomic_load_explicit(&s_snapshot_seq, memory_order_acquire);
+        memcpy(out, &s_snapshots[seq & 1], sizeof(*out));
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&s_snapshot_seq, memory_order_relaxed) == seq) break;
+        retries++;  // A publish rewrote the copy while it was read
+    }
+
+    atomic_fetch_add_explicit(&s_snapshot_reads, 1, memory_order_relaxed);
+    if (retries) {
+        atomic_fetch_add_explicit(&s_snapshot_retries, retries, memory_order_relaxed);
+        unsigned max = atomic_load_explicit(&s_snapshot_max_retries, memory_order_relaxed);
+        while (retries > max &&
+               !atomic_compare_exchange_weak_explicit(&s_snapshot_max_retries, &max, retries,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+        }
+    }
+}
+
+void pet_get_snapshot_stats(pet_snapshot_stats_t *stats)
+{
+    stats->publishes = s_snapshot_publishes;
+    stats->reads = atomic_load_explicit(&s_snapshot_reads, memory_order_relaxed);
+    stats->retries = atomic_load_explicit(&s_snapshot_retries, memory_order_relaxed);
+    stats->max_retries = atomic_load_explicit(&s_snapshot_max_retries, memory_order_relaxed);
+}
+
 //=============================================================================
 // Core Update
 //=============================================================================
 
 void pet_update(uint32_t delta_ms)
 {
+    TRACE_ZONE("pet_update");
     if (s_pet.stage == PET_STAGE_DEAD) return;
 
     uint32_t now = get_ms();
@@ -530,7 +614,12 @@ uint32_t pet_get_age_days(void)
 
 const char *pet_get_stage_name(void)
 {
-    switch (s_pet.stage) {
+    return pet_stage_name(s_pet.stage);
+}
+
+const char *pet_stage_name(pet_stage_t stage)
+{
+    switch (stage) {
         case PET_STAGE_EGG:   return "Egg";
         case PET_STAGE_BABY:  return "Baby";
         case PET_STAGE_CHILD: return "Child";
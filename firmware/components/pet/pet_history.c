@@ -0,0 +1,170 @@
+/**
+ * @file pet_history.c
+ * @brief Multi-resolution stat history implementation
+ *
+ * REQ-SW-015: Stat Trend Graphs
+ */
+
+#include "pet_history.h"
+#include "pet.h"
+#include <string.h>
+
+//=============================================================================
+// Types
+//=============================================================================
+
+// Open (not yet closed) bucket of a level >= 1
+typedef struct {
+    uint8_t min;
+    uint8_t max;
+    uint16_t sum;
+} history_acc_t;
+
+typedef struct {
+    pet_history_bucket_t ring[PET_HISTORY_BUCKETS][PET_HISTORY_STAT_COUNT];
+    history_acc_t acc[PET_HISTORY_STAT_COUNT];
+    uint8_t acc_count;          // Child buckets folded into acc
+    uint8_t head;               // Next write slot
+    uint8_t count;              // Valid buckets in ring
+    uint32_t generation;        // Buckets ever closed
+} history_level_t;
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+static history_level_t s_levels[PET_HISTORY_LEVELS];
+_Static_assert(sizeof(s_levels) == PET_HISTORY_RAM_BYTES, "history outside its budget");
+static uint32_t s_sample_timer = 0;
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+static void push_bucket(history_level_t *lvl, const pet_history_bucket_t *b)
+{
+    memcpy(lvl->ring[lvl->head], b, sizeof(lvl->ring[0]));
+    lvl->head = (lvl->head + 1) % PET_HISTORY_BUCKETS;
+    if (lvl->count < PET_HISTORY_BUCKETS) {
+        lvl->count++;
+    }
+    lvl->generation++;
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+void pet_history_reset(void)
+{
+    memset(s_levels, 0, sizeof(s_levels));
+    s_sample_timer = 0;
+}
+
+void pet_history_update(uint32_t delta_ms)
+{
+    s_sample_timer += delta_ms;
+    if (s_sample_timer < PET_HISTORY_SAMPLE_MS) {
+        return;
+    }
+    s_sample_timer %= PET_HISTORY_SAMPLE_MS;
+
+    const pet_state_t *pet = pet_get_state();
+    const uint8_t values[PET_HISTORY_STAT_COUNT] = {
+        [PET_HISTORY_HUNGER] = pet->hunger,
+        [PET_HISTORY_HAPPINESS] = pet->happiness,
+        [PET_HISTORY_HEALTH] = pet->health,
+        [PET_HISTORY_ENERGY] = pet->energy,
+    };
+    pet_history_append(values);
+}
+
+void pet_history_append(const uint8_t values[PET_HISTORY_STAT_COUNT])
+{
+    pet_history_bucket_t closed[PET_HISTORY_STAT_COUNT];
+
+    // Level 0: every sample is its own bucket
+    for (int s = 0; s < PET_HISTORY_STAT_COUNT; s++) {
+        closed[s].min = values[s];
+        closed[s].max = values[s];
+        closed[s].avg = values[s];
+    }
+    push_bucket(&s_levels[0], closed);
+
+    // Coarser levels: fold the bucket that just closed into the parent,
+    // stopping at the first level whose bucket is still open. Amortised
+    // cost per append is O(1).
+    for (int l = 1; l < PET_HISTORY_LEVELS; l++) {
+        history_level_t *lvl = &s_levels[l];
+
+        for (int s = 0; s < PET_HISTORY_STAT_COUNT; s++) {
+            history_acc_t *acc = &lvl->acc[s];
+            if (lvl->acc_count == 0) {
+                acc->min = closed[s].min;
+                acc->max = closed[s].max;
+                acc->sum = closed[s].avg;
+            } else {
+                if (closed[s].min < acc->min) acc->min = closed[s].min;
+                if (closed[s].max > acc->max) acc->max = closed[s].max;
+                acc->sum += closed[s].avg;
+            }
+        }
+
+        if (++lvl->acc_count < PET_HISTORY_FANOUT) {
+            break;
+        }
+
+        for (int s = 0; s < PET_HISTORY_STAT_COUNT; s++) {
+            closed[s].min = lvl->acc[s].min;
+            closed[s].max = lvl->acc[s].max;
+            closed[s].avg = (uint8_t)(lvl->acc[s].sum / PET_HISTORY_FANOUT);
+        }
+        lvl->acc_count = 0;
+        push_bucket(lvl, closed);
+    }
+}
+
+uint32_t pet_history_span_minutes(int level)
+{
+    uint32_t span = 1;
+    for (int l = 0; l < level; l++) {
+        span *= PET_HISTORY_FANOUT;
+    }
+    return span;
+}
+
+int pet_history_select_level(uint32_t window_min, int width)
+{
+    for (int l = 0; l < PET_HISTORY_LEVELS; l++) {
+        uint32_t buckets = (window_min + pet_history_span_minutes(l) - 1) /
+                           pet_history_span_minutes(l);
+        if (buckets <= (uint32_t)width && buckets <= PET_HISTORY_BUCKETS) {
+            return l;
+        }
+    }
+    return PET_HISTORY_LEVELS - 1;
+}
+
+int pet_history_count(int level)
+{
+    if (level < 0 || level >= PET_HISTORY_LEVELS) return 0;
+    return s_levels[level].count;
+}
+
+uint32_t pet_history_generation(int level)
+{
+    if (level < 0 || level >= PET_HISTORY_LEVELS) return 0;
+    return s_levels[level].generation;
+}
+
+const pet_history_bucket_t *pet_history_get(int level, pet_history_stat_t stat, int age)
+{
+    if (level < 0 || level >= PET_HISTORY_LEVELS) return NULL;
+    if (stat >= PET_HISTORY_STAT_COUNT) return NULL;
+
+    const history_level_t *lvl = &s_levels[level];
+    if (age < 0 || age >= lvl->count) return NULL;
+
+    int idx = (lvl->head + PET_HISTORY_BUCKETS - 1 - age) % PET_HISTORY_BUCKETS;
+    return &lvl->ring[idx][stat];
+}
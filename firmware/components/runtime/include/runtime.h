@@ -0,0 +1,126 @@
+/**
+ * @file runtime.h
+ * @brief Task table, CPU accounting and stack reporting for ESP32 Tamagotchi
+ *
+ * REQ-SW-037: Multi-task Runtime
+ * The application declares its tasks (entry point, stack, priority,
+ * core) in one table and starts them with runtime_start(). Each task
+ * brackets its work with runtime_busy_begin()/runtime_busy_end() so the
+ * report can show the CPU share per task next to the stack high-water
+ * mark, without FreeRTOS run-time stats.
+ *
+ * REQ-SW-039: Static Memory Budget
+ * Task stacks and control blocks are static (xTaskCreateStatic), so
+ * starting the tasks cannot fail for lack of heap. The application also
+ * declares its large buffers in a budget table; runtime_memory_report()
+ * logs RAM by subsystem next to the linker's totals, the stacks' high-water
+ * marks and the heap that is left.
+ */
+
+#ifndef RUNTIME_H
+#define RUNTIME_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define RUNTIME_MAX_TASKS   6
+
+/**
+ * @brief Define the static stack of one task (bytes; StackType_t is a byte
+ *        on ESP-IDF, so sizeof(name) is the stack size in the task table)
+ */
+#define RUNTIME_STACK_DEFINE(name, bytes) \
+    static StackType_t name[(bytes) / sizeof(StackType_t)]
+
+//=============================================================================
+// Types
+//=============================================================================
+
+/**
+ * @brief One task of the table
+ */
+typedef struct {
+    const char *name;
+    TaskFunction_t entry;
+    StackType_t *stack;         // RUNTIME_STACK_DEFINE()
+    uint32_t stack_bytes;       // sizeof(stack)
+    UBaseType_t priority;
+    BaseType_t core;
+} runtime_task_def_t;
+
+/**
+ * @brief Accounting of one task since the last report
+ */
+typedef struct {
+    uint32_t runs;              // Work items (loop iterations with work)
+    uint32_t busy_us;           // Time between busy_begin and busy_end
+    uint32_t max_us;            // Longest single work item
+    uint32_t stack_free;        // Stack high-water mark (bytes never used)
+} runtime_task_stats_t;
+
+/**
+ * @brief One row of the memory budget: a subsystem's buffers
+ */
+typedef struct {
+    const char *name;
+    size_t bytes;
+    bool boot_heap;             // Allocated once during init, not in .data/.bss
+} runtime_mem_def_t;
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+/**
+ * @brief Create every task of the table on its static stack, pinned to its core
+ * @param defs Task table (must stay valid; index = task ID)
+ * @param count Number of tasks (<= RUNTIME_MAX_TASKS)
+ * @return ESP_OK, ESP_ERR_INVALID_ARG if a task has no stack
+ */
+esp_err_t runtime_start(const runtime_task_def_t *defs, int count);
+
+/**
+ * @brief Get a task's handle (for notifications)
+ */
+TaskHandle_t runtime_task_handle(int id);
+
+/**
+ * @brief Mark the start of a work item on task id (call from that task)
+ */
+void runtime_busy_begin(int id);
+
+/**
+ * @brief Mark the end of the work item started by runtime_busy_begin()
+ */
+void runtime_busy_end(int id);
+
+/**
+ * @brief Get a task's accounting since the last report
+ */
+void runtime_get_stats(int id, runtime_task_stats_t *stats);
+
+/**
+ * @brief Log CPU share, longest work item and free stack of every task,
+ *        then start a new accounting window
+ */
+void runtime_report(void);
+
+/**
+ * @brief Log the memory budget: static RAM by subsystem (the task stacks
+ *        added as their own row), what the linker placed beyond it, the
+ *        boot-time heap rows, stack high-water marks, and free heap with
+ *        its largest block
+ * @param defs Budget table
+ * @param count Number of rows
+ */
+void runtime_memory_report(const runtime_mem_def_t *defs, int count);
+
+#endif // RUNTIME_H
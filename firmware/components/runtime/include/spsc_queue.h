@@ -0,0 +1,68 @@
+/**
+ * @file spsc_queue.h
+ * @brief Lock-free single-producer/single-consumer ring for ESP32 Tamagotchi
+ *
+ * REQ-SW-037: Multi-task Runtime
+ * Same scheme as the input rings: the producer owns head, the consumer
+ * owns tail, both only ever increase. Neither side blocks or takes a
+ * lock, so a task of any priority can push to a lower-priority consumer.
+ * Items are copied in and out; the capacity must be a power of two.
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdatomic.h>
+
+typedef struct {
+    void *items;
+    size_t item_size;
+    unsigned capacity;          // Power of two
+    atomic_uint head;           // Written by the producer
+    atomic_uint tail;           // Written by the consumer
+    atomic_uint dropped;        // Pushes refused because the ring was full
+} spsc_queue_t;
+
+/**
+ * @brief Define a static queue of n items of type
+ */
+#define SPSC_QUEUE_DEFINE(name, type, n) \
+    _Static_assert(((n) & ((n) - 1)) == 0, "SPSC capacity must be a power of two"); \
+    static type name##_items[n]; \
+    static spsc_queue_t name = { .items = name##_items, .item_size = sizeof(type), .capacity = (n) }
+
+/**
+ * @brief Copy an item in (producer only)
+ * @return false if the queue is full (the item is dropped and counted)
+ */
+static inline bool spsc_push(spsc_queue_t *q, const void *item)
+{
+    unsigned head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+    if (head - tail >= q->capacity) {
+        atomic_fetch_add_explicit(&q->dropped, 1, memory_order_relaxed);
+        return false;
+    }
+    memcpy((char *)q->items + (head & (q->capacity - 1)) * q->item_size, item, q->item_size);
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Copy the oldest item out (consumer only)
+ * @return false if the queue is empty
+ */
+static inline bool spsc_pop(spsc_queue_t *q, void *item)
+{
+    unsigned tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&q->head, memory_order_acquire);
+    if (tail == head) return false;
+    memcpy(item, (const char *)q->items + (tail & (q->capacity - 1)) * q->item_size, q->item_size);
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,172 @@
+/**
+ * @file runtime.c
+ * @brief Task table, CPU accounting and stack reporting implementation
+ *
+ * REQ-SW-037: Multi-task Runtime
+ * REQ-SW-039: Static Memory Budget
+ */
+
+#include "runtime.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char *TAG = "runtime";
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+// Written only by the task it belongs to; the report reads it racily,
+// which at worst mixes two windows in one line
+typedef struct {
+    StaticTask_t tcb;
+    TaskHandle_t handle;
+    int64_t busy_start_us;
+    uint32_t runs;
+    uint64_t busy_us;
+    uint32_t max_us;
+} task_slot_t;
+
+static const runtime_task_def_t *s_defs = NULL;
+static int s_count = 0;
+static task_slot_t s_slots[RUNTIME_MAX_TASKS];
+static int64_t s_window_start_us = 0;
+
+// Section bounds from the ESP-IDF linker script (internal DRAM)
+extern int _data_start, _data_end, _bss_start, _bss_end;
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+esp_err_t runtime_start(const runtime_task_def_t *defs, int count)
+{
+    if (count > RUNTIME_MAX_TASKS) return ESP_ERR_INVALID_ARG;
+
+    s_defs = defs;
+    s_count = count;
+    memset(s_slots, 0, sizeof(s_slots));
+    s_window_start_us = esp_timer_get_time();
+
+    for (int i = 0; i < count; i++) {
+        const runtime_task_def_t *def = &defs[i];
+        if (def->stack == NULL) {
+            ESP_LOGE(TAG, "Task %s has no stack", def->name);
+            return ESP_ERR_INVALID_ARG;
+        }
+        s_slots[i].handle = xTaskCreateStaticPinnedToCore(def->entry, def->name, def->stack_bytes,
+                                                          NULL, def->priority, def->stack,
+                                                          &s_slots[i].tcb, def->core);
+        ESP_LOGI(TAG, "Task %-8s core %d prio %2u stack %lu",
+                 def->name, (int)def->core, (unsigned)def->priority, (unsigned long)def->stack_bytes);
+    }
+    return ESP_OK;
+}
+
+TaskHandle_t runtime_task_handle(int id)
+{
+    if (id < 0 || id >= s_count) return NULL;
+    return s_slots[id].handle;
+}
+
+void runtime_busy_begin(int id)
+{
+    s_slots[id].busy_start_us = esp_timer_get_time();
+}
+
+void runtime_busy_end(int id)
+{
+    task_slot_t *slot = &s_slots[id];
+    uint32_t us = (uint32_t)(esp_timer_get_time() - slot->busy_start_us);
+    slot->runs++;
+    slot->busy_us += us;
+    if (us > slot->max_us) slot->max_us = us;
+}
+
+void runtime_get_stats(int id, runtime_task_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    if (id < 0 || id >= s_count) return;
+
+    const task_slot_t *slot = &s_slots[id];
+    stats->runs = slot->runs;
+    stats->busy_us = (uint32_t)slot->busy_us;
+    stats->max_us = slot->max_us;
+    if (slot->handle) {
+        // High-water mark is in bytes on ESP-IDF (stack type is uint8_t)
+        stats->stack_free = uxTaskGetStackHighWaterMark(slot->handle);
+    }
+}
+
+void runtime_report(void)
+{
+    int64_t now = esp_timer_get_time();
+    uint64_t window_us = (uint64_t)(now - s_window_start_us);
+    if (window_us == 0) return;
+
+    ESP_LOGI(TAG, "Tasks over %lu ms:", (unsigned long)(window_us / 1000));
+    for (int i = 0; i < s_count; i++) {
+        runtime_task_stats_t stats;
+        runtime_get_stats(i, &stats);
+        uint32_t permille = (uint32_t)((uint64_t)stats.busy_us * 1000 / window_us);
+
+        ESP_LOGI(TAG, "  %-8s core %d  cpu %2lu.%lu%%  runs %6lu  max %6lu us  stack free %5lu/%lu B",
+                 s_defs[i].name, (int)s_defs[i].core,
+                 (unsigned long)(permille / 10), (unsigned long)(permille % 10),
+                 (unsigned long)stats.runs, (unsigned long)stats.max_us,
+                 (unsigned long)stats.stack_free, (unsigned long)s_defs[i].stack_bytes);
+
+        s_slots[i].runs = 0;
+        s_slots[i].busy_us = 0;
+        s_slots[i].max_us = 0;
+    }
+    s_window_start_us = now;
+}
+
+void runtime_memory_report(const runtime_mem_def_t *defs, int count)
+{
+    size_t data = (size_t)((char *)&_data_end - (char *)&_data_start);
+    size_t bss = (size_t)((char *)&_bss_end - (char *)&_bss_start);
+    size_t stacks = 0;
+    size_t budget = 0;
+
+    for (int i = 0; i < s_count; i++) {
+        stacks += s_defs[i].stack_bytes + sizeof(StaticTask_t);
+    }
+
+    ESP_LOGI(TAG, "Static RAM by subsystem:");
+    ESP_LOGI(TAG, "  %-12s %7lu B", "tasks", (unsigned long)stacks);
+    budget += stacks;
+    for (int i = 0; i < count; i++) {
+        if (defs[i].bytes == 0 || defs[i].boot_heap) continue;
+        ESP_LOGI(TAG, "  %-12s %7lu B", defs[i].name, (unsigned long)defs[i].bytes);
+        budget += defs[i].bytes;
+    }
+    ESP_LOGI(TAG, "  %-12s %7lu B", "budget", (unsigned long)budget);
+    // Everything else: small module state, ESP-IDF and driver statics
+    ESP_LOGI(TAG, "  %-12s %7lu B (.data %lu + .bss %lu)", "other",
+             (unsigned long)(data + bss > budget ? data + bss - budget : 0),
+             (unsigned long)data, (unsigned long)bss);
+
+    ESP_LOGI(TAG, "Heap allocated at boot:");
+    for (int i = 0; i < count; i++) {
+        if (defs[i].bytes == 0 || !defs[i].boot_heap) continue;
+        ESP_LOGI(TAG, "  %-12s %7lu B", defs[i].name, (unsigned long)defs[i].bytes);
+    }
+
+    ESP_LOGI(TAG, "Stacks (peak use / size):");
+    for (int i = 0; i < s_count; i++) {
+        uint32_t size = s_defs[i].stack_bytes;
+        uint32_t free_bytes = s_slots[i].handle ? uxTaskGetStackHighWaterMark(s_slots[i].handle) : size;
+        ESP_LOGI(TAG, "  %-8s %5lu / %5lu B", s_defs[i].name,
+                 (unsigned long)(size - free_bytes), (unsigned long)size);
+    }
+
+    ESP_LOGI(TAG, "Heap: free %lu B, min free %lu B, largest block %lu B (DMA %lu B)",
+             (unsigned long)heap_caps_get_free_size(MALLOC_CAP_8BIT),
+             (unsigned long)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT),
+             (unsigned long)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT),
+             (unsigned long)heap_caps_get_largest_free_block(MALLOC_CAP_DMA));
+}
@@ -12,7 +12,9 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "esp_err.h"
+#include "pet.h"
 
 /**
  * @brief Initialize save manager and NVS
@@ -26,6 +28,12 @@ esp_err_t save_manager_init(void);
  */
 esp_err_t save_manager_save(void);
 
+/**
+ * @brief Save a given pet state to NVS (e.g. a snapshot, from another task)
+ * @return ESP_OK on success
+ */
+esp_err_t save_manager_save_state(const pet_state_t *pet);
+
 /**
  * @brief Load pet state from NVS
  * @return ESP_OK on success, ESP_ERR_NOT_FOUND if no save exists
@@ -55,4 +63,22 @@ uint32_t save_manager_get_offline_minutes(void);
  */
 void save_manager_update_timestamp(void);
 
+/**
+ * @brief Store an auxiliary blob (recordings etc.) next to the save
+ * @param key NVS key (max 15 characters)
+ * @param data Blob contents
+ * @param len Blob size in bytes
+ * @return ESP_OK on success
+ */
+esp_err_t save_manager_write_blob(const char *key, const void *data, size_t len);
+
+/**
+ * @brief Read an auxiliary blob
+ * @param key NVS key
+ * @param data Output buffer
+ * @param len In: buffer size, out: blob size
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the key does not exist
+ */
+esp_err_t save_manager_read_blob(const char *key, void *data, size_t *len);
+
 #endif // SAVE_MANAGER_H
@@ -90,14 +90,17 @@ esp_err_t save_manager_init(void)
 }
 
 esp_err_t save_manager_save(void)
+{
+    return save_manager_save_state(pet_get_state());
+}
+
+esp_err_t save_manager_save_state(const pet_state_t *pet)
 {
     if (s_nvs_handle == 0) {
         ESP_LOGE(TAG, "NVS not initialized");
         return ESP_ERR_INVALID_STATE;
     }
 
-    const pet_state_t *pet = pet_get_state();
-
     // Pack pet state into save structure
     save_data_t save = {
         .version = SAVE_VERSION,
@@ -257,3 +260,38 @@ void save_manager_update_timestamp(void)
 {
     s_last_save_time = get_ms();
 }
+
+esp_err_t save_manager_write_blob(const char *key, const void *data, size_t len)
+{
+    if (s_nvs_handle == 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t ret = nvs_set_blob(s_nvs_handle, key, data, len);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to write %s: %s", key, esp_err_to_name(ret));
+        return ret;
+    }
+
+    ret = nvs_commit(s_nvs_handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "NVS commit failed: %s", esp_err_to_name(ret));
+    }
+    return ret;
+}
+
+esp_err_t save_manager_read_blob(const char *key, void *data, size_t *len)
+{
+    if (s_nvs_handle == 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t ret = nvs_get_blob(s_nvs_handle, key, data, len);
+    if (ret == ESP_ERR_NVS_NOT_FOUND) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to read %s: %s", key, esp_err_to_name(ret));
+    }
+    return ret;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file sim.h
+ * @brief Simulation clock and PRNG for ESP32 Tamagotchi
+ *
+ * REQ-SW-051: Input Recording and Replay
+ * Game logic reads time and randomness only through this module. Time
+ * advances in fixed ticks driven by the game loop and the PRNG is a
+ * seeded xorshift32, so a session is fully determined by the start state,
+ * the seed and the tick at which each input event was dispatched.
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define SIM_TICK_MS     33      // One game update (~30 FPS)
+
+// Storage class of the clock, the PRNG and the pet (REQ-SW-058). Empty on
+// the device; the host balance simulator builds with _Thread_local so
+// every worker thread runs its own pet
+#ifndef SIM_THREAD_LOCAL
+#define SIM_THREAD_LOCAL
+#endif
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+/**
+ * @brief Reset the clock to tick 0 and seed the PRNG
+ * @param seed PRNG seed (0 is replaced by a fixed non-zero value)
+ */
+void sim_init(uint32_t seed);
+
+/**
+ * @brief Restore a clock/PRNG state captured earlier
+ * @param tick Tick index
+ * @param rng_state Value from sim_get_rng_state()
+ */
+void sim_restore(uint32_t tick, uint32_t rng_state);
+
+/**
+ * @brief Advance the clock by one tick
+ */
+void sim_step(void);
+
+/**
+ * @brief Advance the clock by many ticks at once (debug console time warp)
+ */
+void sim_advance(uint32_t ticks);
+
+/**
+ * @brief Get the current tick index
+ */
+uint32_t sim_get_tick(void);
+
+/**
+ * @brief Get simulated milliseconds since sim_init()
+ */
+uint32_t sim_now_ms(void);
+
+/**
+ * @brief Get the PRNG state (for recordings)
+ */
+uint32_t sim_get_rng_state(void);
+
+/**
+ * @brief Next pseudo-random number
+ * @return 32 random bits
+ */
+uint32_t sim_random(void);
+
+#endif // SIM_H
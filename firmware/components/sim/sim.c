@@ -0,0 +1,68 @@
+/**
+ * @file sim.c
+ * @brief Simulation clock and PRNG implementation
+ *
+ * REQ-SW-051: Input Recording and Replay
+ */
+
+#include "sim.h"
+
+#define SIM_DEFAULT_SEED    0x2545F491
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+static SIM_THREAD_LOCAL uint32_t s_tick = 0;
+static SIM_THREAD_LOCAL uint32_t s_rng = SIM_DEFAULT_SEED;
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+void sim_init(uint32_t seed)
+{
+    sim_restore(0, seed);
+}
+
+void sim_restore(uint32_t tick, uint32_t rng_state)
+{
+    s_tick = tick;
+    s_rng = rng_state ? rng_state : SIM_DEFAULT_SEED;  // xorshift sticks at 0
+}
+
+void sim_step(void)
+{
+    s_tick++;
+}
+
+void sim_advance(uint32_t ticks)
+{
+    s_tick += ticks;
+}
+
+uint32_t sim_get_tick(void)
+{
+    return s_tick;
+}
+
+uint32_t sim_now_ms(void)
+{
+    return s_tick * SIM_TICK_MS;
+}
+
+uint32_t sim_get_rng_state(void)
+{
+    return s_rng;
+}
+
+uint32_t sim_random(void)
+{
+    // xorshift32 (Marsaglia)
+    uint32_t x = s_rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_rng = x;
+    return x;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file asset_pack.h
+ * @brief On-flash asset pack format for ESP32 Tamagotchi
+ *
+ * REQ-SW-034: Asset Pack Partition
+ * An asset pack is written to its own data partition by the host asset
+ * compiler (tools/asset_compiler.py) and memory-mapped at boot, so sprite
+ * and font data is used in place without copying to RAM.
+ *
+ * Layout (all fields little-endian):
+ *   asset_pack_header_t
+ *   asset_pack_entry_t[entry_count]
+ *   blobs, each starting on an ASSET_PACK_ALIGN boundary
+ */
+
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <stdint.h>
+
+#define ASSET_PACK_MAGIC        0x4B505441  // "ATPK"
+#define ASSET_PACK_VERSION      1
+#define ASSET_PACK_ALIGN        32          // Flash cache line size
+#define ASSET_PACK_PARTITION    "assets"
+#define ASSET_PACK_SUBTYPE      0x40        // Custom data subtype
+#define ASSET_FONT_GLYPHS       95          // ASCII 32-126
+
+/**
+ * @brief Asset payload types
+ */
+typedef enum {
+    ASSET_TYPE_RGB565 = 0,      // width*height RGB565 pixels
+    ASSET_TYPE_FONT_6X8 = 1,    // 6 column bytes per glyph, ASCII 32-126
+} asset_type_t;
+
+/**
+ * @brief Pack header (16 bytes)
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t magic;             // ASSET_PACK_MAGIC
+    uint16_t version;           // ASSET_PACK_VERSION
+    uint16_t entry_count;       // Entries in index table
+    uint32_t total_size;        // Header + index + blobs, in bytes
+    uint32_t crc32;             // CRC-32 of everything after the header
+} asset_pack_header_t;
+
+/**
+ * @brief Index table entry (16 bytes)
+ */
+typedef struct __attribute__((packed)) {
+    uint16_t id;                // sprite_asset_t value
+    uint8_t type;               // asset_type_t
+    uint8_t reserved;
+    uint16_t width;             // Pixels (ASSET_FONT_GLYPHS for fonts)
+    uint16_t height;            // Pixels
+    uint32_t offset;            // From start of pack, ASSET_PACK_ALIGN aligned
+    uint32_t size;              // Blob size in bytes
+} asset_pack_entry_t;
+
+#endif // ASSET_PACK_H
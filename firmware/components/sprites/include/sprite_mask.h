@@ -0,0 +1,55 @@
+/**
+ * @file sprite_mask.h
+ * @brief 1-bit collision masks for ESP32 Tamagotchi sprites
+ *
+ * REQ-SW-063: Pixel-accurate Mini-game Collision
+ * The host asset compiler (tools/asset_compiler.py --masks) turns every
+ * opaque pixel of the collision sprites into a set bit, one 32-bit word
+ * per row with the leftmost pixel in bit 31. Two masks overlap when any
+ * pair of rows ANDs to non-zero after shifting one by the X offset.
+ *
+ * No ESP-IDF dependencies beyond sprites.h: also built on the host.
+ */
+
+#ifndef SPRITE_MASK_H
+#define SPRITE_MASK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sprites.h"
+
+#define SPRITE_MASK_MAX_W   32      // One word per row
+
+/**
+ * @brief Collision mask of one sprite frame
+ */
+typedef struct {
+    uint8_t w, h;               // Pixels, same as the sprite
+    const uint32_t *rows;       // h words, bit 31 = leftmost pixel
+} sprite_mask_t;
+
+/**
+ * @brief Masks indexed by asset ID (rows is NULL for sprites without one)
+ *
+ * Generated into the build directory from the built-in sprite arrays.
+ */
+extern const sprite_mask_t sprite_masks[SPRITE_ASSET_COUNT];
+
+/**
+ * @brief Get the collision mask of a sprite
+ * @return Mask, NULL if the sprite has none
+ */
+const sprite_mask_t *sprite_mask_get(sprite_asset_t id);
+
+/**
+ * @brief Test two masks at screen positions for a shared opaque pixel
+ *
+ * Rejects on the bounding boxes first, then ANDs the overlapping rows.
+ * @param a First mask, top-left at (ax, ay)
+ * @param b Second mask, top-left at (bx, by)
+ * @return true if any opaque pixels overlap
+ */
+bool sprite_mask_overlap(const sprite_mask_t *a, int ax, int ay,
+                         const sprite_mask_t *b, int bx, int by);
+
+#endif // SPRITE_MASK_H
@@ -13,6 +13,8 @@
 #define SPRITES_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
 
 //=============================================================================
 // Transparency Color
@@ -57,9 +59,41 @@
 #define POOP_W              12
 #define POOP_H              10
 
-// Wave sprite (for mini-game)
+// Mini-game obstacles (fish pickup uses FOOD_FISH_W/H)
 #define WAVE_W              32
-#define WAVE_H              16
+#define WAVE_H              20
+#define ROCK_W              24
+#define ROCK_H              16
+
+//=============================================================================
+// Asset IDs (REQ-SW-034)
+//=============================================================================
+
+/**
+ * @brief Assets that can be replaced by the asset pack partition
+ *
+ * Values are stored in the pack index; append new IDs at the end and keep
+ * tools/asset_compiler.py in sync.
+ */
+typedef enum {
+    SPRITE_ASSET_EGG_1 = 0,
+    SPRITE_ASSET_EGG_2,
+    SPRITE_ASSET_EGG_3,
+    SPRITE_ASSET_BABY_IDLE_1,
+    SPRITE_ASSET_BABY_IDLE_2,
+    SPRITE_ASSET_BABY_IDLE_3,
+    SPRITE_ASSET_BABY_IDLE_4,
+    SPRITE_ASSET_ICON_HUNGER,
+    SPRITE_ASSET_ICON_HAPPY,
+    SPRITE_ASSET_ICON_HEALTH,
+    SPRITE_ASSET_ICON_ENERGY,
+    SPRITE_ASSET_ICON_ATTENTION,
+    SPRITE_ASSET_FONT_6X8,
+    SPRITE_ASSET_MG_WAVE,
+    SPRITE_ASSET_MG_ROCK,
+    SPRITE_ASSET_MG_FISH,
+    SPRITE_ASSET_COUNT
+} sprite_asset_t;
 
 //=============================================================================
 // Sprite Data Declarations (defined in sprites.c)
@@ -146,6 +180,11 @@ extern const uint16_t *sprite_food_shrimp;
 // Poop sprite - pointer (alias)
 extern const uint16_t *sprite_poop;
 
+// Mini-game obstacles
+extern const uint16_t sprite_mg_wave[];
+extern const uint16_t sprite_mg_rock[];
+extern const uint16_t sprite_mg_fish[];
+
 // Wave for mini-game - pointer (alias)
 extern const uint16_t *sprite_wave;
 
@@ -156,6 +195,36 @@ extern const uint16_t *sprite_zzz;
 // Helper Functions
 //=============================================================================
 
+/**
+ * @brief Map the asset pack partition, if present
+ *
+ * Assets found in a valid pack replace the built-in ones; everything else
+ * (or everything, when no pack is flashed) falls back to the arrays above.
+ * @return ESP_OK if a pack was mapped, ESP_ERR_NOT_FOUND if built-ins are used
+ */
+esp_err_t sprites_init(void);
+
+/**
+ * @brief Check whether assets are served from the asset pack
+ * @return true if a valid pack is mapped
+ */
+bool sprites_has_pack(void);
+
+/**
+ * @brief Get an RGB565 asset by ID
+ * @param id Asset ID
+ * @param width Output: sprite width (may be NULL)
+ * @param height Output: sprite height (may be NULL)
+ * @return Pointer to pixel data (mapped flash or built-in)
+ */
+const uint16_t *sprites_get(sprite_asset_t id, int *width, int *height);
+
+/**
+ * @brief Get 6x8 font glyphs from the asset pack
+ * @return Glyph data (6 bytes per glyph, ASCII 32-126), NULL if not in pack
+ */
+const uint8_t *sprites_get_font(void);
+
 /**
  * @brief Get idle animation frame for current pet stage
  * @param stage Pet life stage
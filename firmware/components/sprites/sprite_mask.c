@@ -0,0 +1,48 @@
+/**
+ * @file sprite_mask.c
+ * @brief Pixel-accurate sprite collision
+ *
+ * REQ-SW-063: Pixel-accurate Mini-game Collision
+ * After the bounding-box reject the X offset between two masks is below
+ * SPRITE_MASK_MAX_W, so each overlapping row costs one shift and one AND.
+ */
+
+#include "sprite_mask.h"
+#include <stddef.h>
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+const sprite_mask_t *sprite_mask_get(sprite_asset_t id)
+{
+    if (id >= SPRITE_ASSET_COUNT || sprite_masks[id].rows == NULL) return NULL;
+    return &sprite_masks[id];
+}
+
+bool sprite_mask_overlap(const sprite_mask_t *a, int ax, int ay,
+                         const sprite_mask_t *b, int bx, int by)
+{
+    // Bounding boxes first: most pairs end here
+    if (ax >= bx + b->w || bx >= ax + a->w) return false;
+    if (ay >= by + b->h || by >= ay + a->h) return false;
+
+    int y0 = ay > by ? ay : by;
+    int y1 = (ay + a->h < by + b->h) ? ay + a->h : by + b->h;
+    const uint32_t *row_a = &a->rows[y0 - ay];
+    const uint32_t *row_b = &b->rows[y0 - by];
+    int rows = y1 - y0;
+
+    // Bit 31 is the leftmost pixel: moving b right shifts it right
+    int dx = bx - ax;
+    if (dx >= 0) {
+        for (int i = 0; i < rows; i++) {
+            if (row_a[i] & (row_b[i] >> dx)) return true;
+        }
+    } else {
+        for (int i = 0; i < rows; i++) {
+            if (row_a[i] & (row_b[i] << -dx)) return true;
+        }
+    }
+    return false;
+}
@@ -13,9 +13,19 @@
  * - Black:       0x0000
  * - Pink:        0xFE19 (blush)
  * - Yellow:      0xFFE0 (star)
+ *
+ * REQ-SW-034: Assets in a mapped asset pack partition override the
+ * built-in arrays below.
  */
 
 #include "sprites.h"
+#include "asset_pack.h"
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char *TAG = "sprites";
 
 // Transparency shorthand
 #define T   0xF81F  // Transparent (magenta)
@@ -31,6 +41,9 @@
 #define OR  0xFD20  // Orange
 #define CY  0x07FF  // Cyan
 #define BL  0x001F  // Blue
+#define RK  0x8410  // Rock
+#define RL  0xAD55  // Rock highlight
+#define RS  0x4208  // Rock shadow
 
 //=============================================================================
 // Egg Sprites (24x28)
@@ -277,6 +290,70 @@ const uint16_t *sprite_dolphin_sad = sprite_baby_idle_1;
 const uint16_t *sprite_dolphin_sick = sprite_baby_idle_1;
 const uint16_t *sprite_dolphin_dead = sprite_baby_idle_1;
 
+//=============================================================================
+// Mini-game Sprites
+//=============================================================================
+
+// Breaking wave (32x20)
+const uint16_t sprite_mg_wave[] = {
+    T,T,T,T,T,T,T,T,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,T,T,T,T,T,T,T,T,
+    T,T,T,T,T,T,T,T,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,T,T,T,T,T,T,T,T,
+    T,T,T,T,T,T,T,T,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,T,T,T,T,T,T,T,T,
+    T,T,T,T,T,T,T,T,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,T,T,T,T,T,T,T,T,
+    T,T,T,T,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,T,T,T,T,
+    T,T,T,T,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,T,T,T,T,
+    T,T,T,T,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,T,T,T,T,
+    T,T,T,T,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,T,T,T,T,
+    T,T,T,T,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,T,T,T,T,
+    T,T,T,T,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,T,T,T,T,
+    T,T,T,T,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,T,T,T,T,
+    T,T,T,T,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,T,T,T,T,
+    CY,CY,CY,CY,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,CY,CY,CY,CY,
+    CY,CY,CY,CY,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,W,CY,CY,CY,CY,
+    CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,
+    CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,
+    CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,
+    CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,
+    CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,
+    CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,CY,
+};
+
+// Rock (24x16)
+const uint16_t sprite_mg_rock[] = {
+    T,T,T,T,T,T,T,T,T,T,T,T,T,T,T,T,T,T,T,T,T,T,T,T,
+    T,T,T,T,T,T,T,T,T,RK,RK,RK,RK,RK,RK,T,T,T,T,T,T,T,T,T,
+    T,T,T,T,T,T,T,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,T,T,T,T,T,T,T,
+    T,T,T,T,T,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,T,T,T,T,T,
+    T,T,T,T,RK,RK,RL,RL,RL,RL,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,T,T,T,T,
+    T,T,T,T,RK,RL,RL,RL,RL,RL,RL,RK,RK,RK,RK,RK,RK,RK,RK,RK,T,T,T,T,
+    T,T,T,RK,RL,RL,RL,RL,RL,RL,RL,RL,RK,RK,RK,RK,RK,RK,RK,RK,RK,T,T,T,
+    T,T,RK,RK,RL,RL,RL,RL,RL,RL,RL,RL,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,T,T,
+    T,T,RK,RK,RL,RL,RL,RL,RL,RL,RL,RL,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,T,T,
+    T,RK,RK,RK,RK,RL,RL,RL,RL,RL,RL,RK,RK,RK,RK,RK,RS,RS,RS,RS,RS,RS,RS,T,
+    T,RK,RK,RK,RK,RK,RL,RL,RL,RL,RK,RK,RK,RK,RK,RK,RS,RS,RS,RS,RS,RS,RS,T,
+    T,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RS,RS,RS,RS,RS,RS,RS,T,
+    RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RS,RS,RS,RS,RS,RS,RS,RS,
+    RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RS,RS,RS,RS,RS,RS,RS,RS,
+    RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RS,RS,RS,RS,RS,RS,RS,RS,
+    RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RK,RS,RS,RS,RS,RS,RS,RS,RS,
+};
+
+// Fish pickup (16x12)
+const uint16_t sprite_mg_fish[] = {
+    T,T,T,T,T,T,T,T,T,T,T,T,T,T,T,T,
+    T,T,T,T,YL,YL,YL,YL,T,T,T,T,T,T,T,OR,
+    T,T,T,OR,OR,OR,OR,OR,OR,OR,T,T,T,T,OR,OR,
+    T,T,OR,OR,OR,OR,OR,OR,OR,OR,OR,T,T,OR,OR,OR,
+    T,OR,OR,B,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,
+    T,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,
+    T,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,
+    T,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,OR,
+    T,T,OR,OR,OR,OR,OR,OR,OR,OR,OR,T,T,OR,OR,OR,
+    T,T,T,OR,OR,OR,OR,OR,OR,OR,T,T,T,T,OR,OR,
+    T,T,T,T,T,T,T,T,T,T,T,T,T,T,T,OR,
+    T,T,T,T,T,T,T,T,T,T,T,T,T,T,T,T,
+};
+
 //=============================================================================
 // Status Icons (16x16)
 //=============================================================================
@@ -413,27 +490,190 @@ const uint16_t *icon_menu_settings = icon_attention;
 const uint16_t *sprite_food_fish = icon_hunger_full;
 const uint16_t *sprite_food_shrimp = icon_hunger_full;
 const uint16_t *sprite_poop = icon_attention;
-const uint16_t *sprite_wave = icon_energy_full;
+const uint16_t *sprite_wave = sprite_mg_wave;
 const uint16_t *sprite_zzz = icon_energy_full;
 
+//=============================================================================
+// Asset Table (REQ-SW-034)
+//=============================================================================
+
+typedef struct {
+    const void *data;
+    uint16_t width;
+    uint16_t height;
+} asset_ref_t;
+
+// Built-in fallbacks, indexed by sprite_asset_t
+static const asset_ref_t s_builtin[SPRITE_ASSET_COUNT] = {
+    [SPRITE_ASSET_EGG_1]          = { sprite_egg_1, DOLPHIN_EGG_W, DOLPHIN_EGG_H },
+    [SPRITE_ASSET_EGG_2]          = { sprite_egg_2, DOLPHIN_EGG_W, DOLPHIN_EGG_H },
+    [SPRITE_ASSET_EGG_3]          = { sprite_egg_3, DOLPHIN_EGG_W, DOLPHIN_EGG_H },
+    [SPRITE_ASSET_BABY_IDLE_1]    = { sprite_baby_idle_1, DOLPHIN_BABY_W, DOLPHIN_BABY_H },
+    [SPRITE_ASSET_BABY_IDLE_2]    = { sprite_baby_idle_2, DOLPHIN_BABY_W, DOLPHIN_BABY_H },
+    [SPRITE_ASSET_BABY_IDLE_3]    = { sprite_baby_idle_3, DOLPHIN_BABY_W, DOLPHIN_BABY_H },
+    [SPRITE_ASSET_BABY_IDLE_4]    = { sprite_baby_idle_4, DOLPHIN_BABY_W, DOLPHIN_BABY_H },
+    [SPRITE_ASSET_ICON_HUNGER]    = { icon_hunger_full, ICON_SIZE, ICON_SIZE },
+    [SPRITE_ASSET_ICON_HAPPY]     = { icon_happy_full, ICON_SIZE, ICON_SIZE },
+    [SPRITE_ASSET_ICON_HEALTH]    = { icon_health_full, ICON_SIZE, ICON_SIZE },
+    [SPRITE_ASSET_ICON_ENERGY]    = { icon_energy_full, ICON_SIZE, ICON_SIZE },
+    [SPRITE_ASSET_ICON_ATTENTION] = { icon_attention, ICON_SIZE, ICON_SIZE },
+    [SPRITE_ASSET_FONT_6X8]       = { NULL, 0, 0 },  // Built into display driver
+    [SPRITE_ASSET_MG_WAVE]        = { sprite_mg_wave, WAVE_W, WAVE_H },
+    [SPRITE_ASSET_MG_ROCK]        = { sprite_mg_rock, ROCK_W, ROCK_H },
+    [SPRITE_ASSET_MG_FISH]        = { sprite_mg_fish, FOOD_FISH_W, FOOD_FISH_H },
+};
+
+static asset_ref_t s_assets[SPRITE_ASSET_COUNT];
+static esp_partition_mmap_handle_t s_pack_handle;
+static bool s_pack_mapped = false;
+
+/**
+ * @brief Validate a mapped pack and point the asset table into it
+ * @return Number of assets taken from the pack, -1 if the pack is invalid
+ */
+static int apply_pack(const uint8_t *pack, size_t size)
+{
+    const asset_pack_header_t *hdr = (const asset_pack_header_t *)pack;
+    size_t index_end = sizeof(*hdr) + (size_t)hdr->entry_count * sizeof(asset_pack_entry_t);
+    if (index_end > size) {
+        ESP_LOGE(TAG, "Asset index exceeds pack size");
+        return -1;
+    }
+
+    uint32_t crc = esp_rom_crc32_le(0, pack + sizeof(*hdr), size - sizeof(*hdr));
+    if (crc != hdr->crc32) {
+        ESP_LOGE(TAG, "Asset pack CRC mismatch: %08lx vs %08lx",
+                 (unsigned long)crc, (unsigned long)hdr->crc32);
+        return -1;
+    }
+
+    const asset_pack_entry_t *index = (const asset_pack_entry_t *)(pack + sizeof(*hdr));
+    int applied = 0;
+
+    for (int i = 0; i < hdr->entry_count; i++) {
+        const asset_pack_entry_t *e = &index[i];
+
+        if (e->id >= SPRITE_ASSET_COUNT) {
+            continue;  // Newer pack than firmware, ignore unknown assets
+        }
+        if (e->offset % ASSET_PACK_ALIGN != 0 || e->offset < index_end ||
+            (size_t)e->offset + e->size > size) {
+            ESP_LOGW(TAG, "Asset %d has bad offset, using built-in", e->id);
+            continue;
+        }
+
+        size_t expected;
+        if (e->id == SPRITE_ASSET_FONT_6X8) {
+            expected = (e->type == ASSET_TYPE_FONT_6X8 && e->width == ASSET_FONT_GLYPHS) ?
+                       ASSET_FONT_GLYPHS * 6 : 0;
+        } else {
+            expected = (e->type == ASSET_TYPE_RGB565) ? (size_t)e->width * e->height * 2 : 0;
+        }
+        if (expected == 0 || e->size != expected) {
+            ESP_LOGW(TAG, "Asset %d has bad type/size, using built-in", e->id);
+            continue;
+        }
+
+        s_assets[e->id].data = pack + e->offset;
+        s_assets[e->id].width = e->width;
+        s_assets[e->id].height = e->height;
+        applied++;
+    }
+
+    return applied;
+}
+
 //=============================================================================
 // Helper Functions
 //=============================================================================
 
+esp_err_t sprites_init(void)
+{
+    memcpy(s_assets, s_builtin, sizeof(s_assets));
+
+    if (s_pack_mapped) {
+        esp_partition_munmap(s_pack_handle);
+        s_pack_mapped = false;
+    }
+
+    const esp_partition_t *part = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)ASSET_PACK_SUBTYPE,
+        ASSET_PACK_PARTITION);
+    if (part == NULL) {
+        ESP_LOGI(TAG, "No asset partition, using built-in sprites");
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    asset_pack_header_t hdr;
+    esp_err_t ret = esp_partition_read(part, 0, &hdr, sizeof(hdr));
+    if (ret != ESP_OK || hdr.magic != ASSET_PACK_MAGIC) {
+        ESP_LOGI(TAG, "Asset partition empty, using built-in sprites");
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (hdr.version != ASSET_PACK_VERSION || hdr.total_size < sizeof(hdr) ||
+        hdr.total_size > part->size) {
+        ESP_LOGW(TAG, "Unsupported asset pack (v%d, %lu bytes)",
+                 hdr.version, (unsigned long)hdr.total_size);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    // Map only the pack itself; the flash cache serves reads in place
+    const void *pack = NULL;
+    ret = esp_partition_mmap(part, 0, hdr.total_size, ESP_PARTITION_MMAP_DATA,
+                             &pack, &s_pack_handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Asset pack mmap failed: %s", esp_err_to_name(ret));
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    int applied = apply_pack((const uint8_t *)pack, hdr.total_size);
+    if (applied < 0) {
+        memcpy(s_assets, s_builtin, sizeof(s_assets));
+        esp_partition_munmap(s_pack_handle);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    s_pack_mapped = true;
+    ESP_LOGI(TAG, "Asset pack mapped: %d/%d assets, %lu bytes",
+             applied, SPRITE_ASSET_COUNT, (unsigned long)hdr.total_size);
+    return ESP_OK;
+}
+
+bool sprites_has_pack(void)
+{
+    return s_pack_mapped;
+}
+
+const uint16_t *sprites_get(sprite_asset_t id, int *width, int *height)
+{
+    if (id >= SPRITE_ASSET_COUNT || id == SPRITE_ASSET_FONT_6X8) {
+        id = SPRITE_ASSET_ICON_ATTENTION;
+    }
+
+    // Before sprites_init() the table is still empty
+    const asset_ref_t *ref = s_assets[id].data ? &s_assets[id] : &s_builtin[id];
+
+    if (width) *width = ref->width;
+    if (height) *height = ref->height;
+    return (const uint16_t *)ref->data;
+}
+
+const uint8_t *sprites_get_font(void)
+{
+    return (const uint8_t *)s_assets[SPRITE_ASSET_FONT_6X8].data;
+}
+
 const uint16_t *sprites_get_idle_frame(int stage, int frame, int *width, int *height)
 {
-    static const uint16_t *baby_frames[] = {
-        sprite_baby_idle_1, sprite_baby_idle_2,
-        sprite_baby_idle_3, sprite_baby_idle_4
+    static const sprite_asset_t baby_frames[] = {
+        SPRITE_ASSET_BABY_IDLE_1, SPRITE_ASSET_BABY_IDLE_2,
+        SPRITE_ASSET_BABY_IDLE_3, SPRITE_ASSET_BABY_IDLE_4
     };
 
     // For now, use baby sprites for all stages
     // In production, you'd have separate arrays per stage
-    *width = DOLPHIN_BABY_W;
-    *height = DOLPHIN_BABY_H;
-
     frame = frame % 4;
-    return baby_frames[frame];
+    return sprites_get(baby_frames[frame], width, height);
 }
 
 const uint16_t *sprites_get_stat_icon(int stat_type, int level)
@@ -441,24 +681,23 @@ const uint16_t *sprites_get_stat_icon(int stat_type, int level)
     // Return appropriate icon based on stat type and level
     // 0 = hunger, 1 = happy, 2 = health, 3 = energy
     switch (stat_type) {
-        case 0: return icon_hunger_full;
-        case 1: return icon_happy_full;
-        case 2: return icon_health_full;
-        case 3: return icon_energy_full;
-        default: return icon_attention;
+        case 0: return sprites_get(SPRITE_ASSET_ICON_HUNGER, NULL, NULL);
+        case 1: return sprites_get(SPRITE_ASSET_ICON_HAPPY, NULL, NULL);
+        case 2: return sprites_get(SPRITE_ASSET_ICON_HEALTH, NULL, NULL);
+        case 3: return sprites_get(SPRITE_ASSET_ICON_ENERGY, NULL, NULL);
+        default: return sprites_get(SPRITE_ASSET_ICON_ATTENTION, NULL, NULL);
     }
 }
 
 const uint16_t *sprites_get_menu_icon(int menu_item)
 {
+    // Menu icons are aliases of the status icons
     switch (menu_item) {
-        case 0: return icon_menu_feed;
-        case 1: return icon_menu_play;
-        case 2: return icon_menu_sleep;
-        case 3: return icon_menu_clean;
-        case 4: return icon_menu_medicine;
-        case 5: return icon_menu_stats;
-        case 6: return icon_menu_settings;
-        default: return icon_attention;
+        case 0: return sprites_get(SPRITE_ASSET_ICON_HUNGER, NULL, NULL);
+        case 1: return sprites_get(SPRITE_ASSET_ICON_HAPPY, NULL, NULL);
+        case 2: return sprites_get(SPRITE_ASSET_ICON_ENERGY, NULL, NULL);
+        case 3:
+        case 4: return sprites_get(SPRITE_ASSET_ICON_HEALTH, NULL, NULL);
+        default: return sprites_get(SPRITE_ASSET_ICON_ATTENTION, NULL, NULL);
     }
 }
@@ -0,0 +1,170 @@
+/**
+ * @file host_game.c
+ * @brief The firmware's game loop on the host
+ *
+ * REQ-SW-055: Host Build
+ */
+
+#include "host_game.h"
+#include "host_mocks.h"
+#include "display.h"
+#include "sprites.h"
+#include "pet.h"
+#include "game.h"
+#include "save_manager.h"
+#include "telemetry.h"
+#include "sim.h"
+#include "nvs_flash.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+
+static const char *TAG = "host";
+
+//=============================================================================
+// Configuration
+//=============================================================================
+
+#define INPUT_POLLS_PER_TICK    3                   // input task runs every 10 ms
+#define CLICK_MS                80                  // Press length of host_game_click()
+#define CLICK_SETTLE_MS         400                 // Until the click is handled
+
+// Button pins (active low), as in input.c
+static const int s_button_gpio[BUTTON_COUNT] = {
+    [BUTTON_LEFT] = 0,
+    [BUTTON_RIGHT] = 35,
+};
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+static uint32_t s_frames = 0;
+static host_game_frame_hook_t s_frame_hook = NULL;
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+static const char *state_name(int state)
+{
+    return game_state_name((game_state_t)state);
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+esp_err_t host_game_boot(const host_game_config_t *config)
+{
+    mock_clock_set_virtual(true);
+    mock_gpio_script_clear();
+    if (!config->keep_save) {
+        nvs_flash_erase();
+    }
+    s_frames = 0;
+
+    esp_err_t ret = display_init();
+    if (ret != ESP_OK) return ret;
+
+    mock_partition_load(config->assets);
+    if (sprites_init() == ESP_OK && sprites_get_font() != NULL) {
+        display_set_font(sprites_get_font());
+    }
+
+    ret = input_init();
+    if (ret != ESP_OK) return ret;
+
+    sim_init(config->seed);
+    ret = pet_init();
+    if (ret != ESP_OK) return ret;
+    ret = save_manager_init();
+    if (ret != ESP_OK) return ret;
+    telemetry_init(state_name);
+    ret = game_init();
+    if (ret != ESP_OK) return ret;
+
+    // Saved pet: skip the splash like app_main() does
+    if (save_manager_exists() && save_manager_load() == ESP_OK) {
+        uint32_t offline_min = save_manager_get_offline_minutes();
+        if (offline_min > 0) {
+            pet_apply_time_away(offline_min);
+        }
+        game_handle_input(BUTTON_RIGHT, BUTTON_EVENT_CLICK);
+    }
+    pet_publish_snapshot();
+
+    ESP_LOGI(TAG, "Booted on the virtual clock, seed %lu, %s sprites",
+             (unsigned long)config->seed, sprites_has_pack() ? "asset pack" : "built-in");
+    return ESP_OK;
+}
+
+void host_game_tick(void)
+{
+    // Input task: polls at its own rate while the tick elapses
+    for (int i = 0; i < INPUT_POLLS_PER_TICK; i++) {
+        mock_clock_advance_us(SIM_TICK_MS * 1000 / INPUT_POLLS_PER_TICK);
+        input_update();
+    }
+    mock_clock_advance_us(SIM_TICK_MS * 1000 % INPUT_POLLS_PER_TICK);
+
+    // Simulation task
+    int64_t start_us = esp_timer_get_time();
+    input_event_t ev;
+    while (input_get_event(&ev)) {
+        game_handle_input(ev.button, ev.event);
+    }
+    game_update(SIM_TICK_MS);
+    sim_step();
+    pet_publish_snapshot();
+    game_state_t state = game_get_state();
+    telemetry_record(state, TELEMETRY_SIM, (uint32_t)(esp_timer_get_time() - start_us));
+
+    // Frame handoff: the render task draws the published view
+    game_publish_frame();
+
+    // Render task
+    display_start_frame();
+    game_render();
+    display_end_frame();
+    s_frames++;
+
+    if (s_frame_hook != NULL) {
+        s_frame_hook(s_frames);
+    }
+}
+
+void host_game_run_ms(uint32_t ms)
+{
+    uint32_t end = sim_now_ms() + ms;
+    while ((int32_t)(end - sim_now_ms()) > 0) {
+        host_game_tick();
+    }
+}
+
+esp_err_t host_game_press(button_id_t button, uint32_t at_ms, uint32_t hold_ms)
+{
+    if (button >= BUTTON_COUNT) return ESP_ERR_INVALID_ARG;
+
+    int64_t down = esp_timer_get_time() + (int64_t)at_ms * 1000;
+    esp_err_t ret = mock_gpio_script(down, s_button_gpio[button], 0);
+    if (ret == ESP_OK) {
+        ret = mock_gpio_script(down + (int64_t)hold_ms * 1000, s_button_gpio[button], 1);
+    }
+    return ret;
+}
+
+void host_game_click(button_id_t button)
+{
+    host_game_press(button, 0, CLICK_MS);
+    host_game_run_ms(CLICK_SETTLE_MS);
+}
+
+uint32_t host_game_frames(void)
+{
+    return s_frames;
+}
+
+void host_game_set_frame_hook(host_game_frame_hook_t hook)
+{
+    s_frame_hook = hook;
+}
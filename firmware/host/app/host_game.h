@@ -0,0 +1,80 @@
+/**
+ * @file host_game.h
+ * @brief The firmware's game loop on the host, single-threaded
+ *
+ * REQ-SW-055: Host Build
+ * Boots the components like app_main() (display, sprites, input, sim,
+ * pet, save manager, telemetry, game, saved pet) on the virtual clock
+ * and runs them one sim tick at a time: input polled every 11 ms of the
+ * tick, events dispatched, game updated, then the frame rendered into
+ * the mocked panel. Buttons are pressed through scripted GPIO, so they
+ * go through the real ISR, debounce and gesture code.
+ */
+
+#ifndef HOST_GAME_H
+#define HOST_GAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "input.h"
+
+//=============================================================================
+// Types
+//=============================================================================
+
+typedef struct {
+    uint32_t seed;              // Sim PRNG seed
+    const char *assets;         // Asset pack file, NULL: built-in sprites
+    bool keep_save;             // Keep the in-memory NVS from an earlier boot
+} host_game_config_t;
+
+/**
+ * @brief Called after each frame has reached the panel
+ * @param frame Frames rendered since boot, this one included
+ */
+typedef void (*host_game_frame_hook_t)(uint32_t frame);
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+/**
+ * @brief Boot the game on the virtual clock
+ * @return ESP_OK, or the first init error
+ */
+esp_err_t host_game_boot(const host_game_config_t *config);
+
+/**
+ * @brief Run one sim tick and render its frame
+ */
+void host_game_tick(void);
+
+/**
+ * @brief Run ticks until the sim clock has advanced by ms
+ */
+void host_game_run_ms(uint32_t ms);
+
+/**
+ * @brief Schedule a button press on the GPIO script
+ * @param at_ms Virtual time from now the button goes down
+ * @param hold_ms How long it stays down
+ */
+esp_err_t host_game_press(button_id_t button, uint32_t at_ms, uint32_t hold_ms);
+
+/**
+ * @brief Press a button now and run until it is released and handled
+ */
+void host_game_click(button_id_t button);
+
+/**
+ * @brief Frames rendered since boot
+ */
+uint32_t host_game_frames(void);
+
+/**
+ * @brief Set the per-frame hook (NULL: none); kept across boots
+ */
+void host_game_set_frame_hook(host_game_frame_hook_t hook);
+
+#endif // HOST_GAME_H
@@ -0,0 +1,120 @@
+/**
+ * @file tamagotchi_host.c
+ * @brief The game as a Linux program on mocked hardware
+ *
+ * REQ-SW-055: Host Build
+ * Runs the firmware's components on the virtual clock for a given sim
+ * time with scripted button presses, then prints where the game ended up
+ * and can save the panel image:
+ *   tamagotchi_host --seconds 20 --press right@2000 --press right@3000 \
+ *                   --assets build-host/assets.bin --ppm screen.ppm
+ * A press is <left|right>@<ms>[+<hold ms>] from boot (default hold 80 ms).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_game.h"
+#include "host_mocks.h"
+#include "display.h"
+#include "game.h"
+#include "pet.h"
+#include "sim.h"
+#include "telemetry.h"
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--seconds N] [--seed N] [--assets FILE] [--ppm FILE]\n"
+            "          [--press <left|right>@<ms>[+<hold ms>]]...\n", prog);
+}
+
+static bool parse_press(const char *arg)
+{
+    button_id_t button;
+    if (strncmp(arg, "left@", 5) == 0) {
+        button = BUTTON_LEFT;
+        arg += 5;
+    } else if (strncmp(arg, "right@", 6) == 0) {
+        button = BUTTON_RIGHT;
+        arg += 6;
+    } else {
+        return false;
+    }
+
+    char *end;
+    unsigned long at = strtoul(arg, &end, 10);
+    unsigned long hold = 80;
+    if (*end == '+') {
+        hold = strtoul(end + 1, &end, 10);
+    }
+    return *end == '\0' && host_game_press(button, (uint32_t)at, (uint32_t)hold) == ESP_OK;
+}
+
+//=============================================================================
+// Main
+//=============================================================================
+
+int main(int argc, char **argv)
+{
+    host_game_config_t config = { .seed = 12345 };
+    uint32_t seconds = 10;
+    const char *ppm = NULL;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    // Presses are scheduled relative to boot, so parse them after it
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--assets") == 0 && i + 1 < argc) {
+            config.assets = argv[++i];
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            config.seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--ppm") == 0 && i + 1 < argc) {
+            ppm = argv[++i];
+        } else if (strcmp(argv[i], "--press") == 0 && i + 1 < argc) {
+            i++;
+        } else {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (host_game_boot(&config) != ESP_OK) {
+        fprintf(stderr, "boot failed\n");
+        return EXIT_FAILURE;
+    }
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--press") == 0 && !parse_press(argv[++i])) {
+            fprintf(stderr, "bad press '%s'\n", argv[i]);
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    host_game_run_ms(seconds * 1000);
+
+    const pet_state_t *pet = pet_get_state();
+    display_stats_t spi;
+    display_get_stats(&spi);
+    printf("%lu ms simulated, %lu frames, state %s\n",
+           (unsigned long)sim_now_ms(), (unsigned long)host_game_frames(),
+           game_state_name(game_get_state()));
+    printf("pet: %s, hunger %u, happiness %u, health %u, energy %u\n",
+           pet_get_stage_name(), pet->hunger, pet->happiness, pet->health, pet->energy);
+    printf("SPI: %lu bytes in %lu transactions, %lu stray pixels\n",
+           (unsigned long)spi.bytes, (unsigned long)spi.transactions,
+           (unsigned long)mock_lcd_stray_pixels());
+    telemetry_report(false);
+
+    if (ppm != NULL && mock_lcd_write_ppm(ppm) != ESP_OK) {
+        fprintf(stderr, "cannot write %s\n", ppm);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,308 @@
+/**
+ * @file display_bench.c
+ * @brief Host benchmark for the display primitives on a modelled SPI bus
+ *
+ * REQ-SW-056: Display Benchmarks
+ * Runs each drawing primitive over representative sizes and reports, per
+ * call, the bus time the ST7789 mock estimates for the device (40 MHz
+ * clock, per-transaction driver overhead, DC pin changes), SPI
+ * transactions and bytes. The numbers depend only on the traffic, so a
+ * run repeats exactly and two branches can be compared:
+ *   display_bench --csv main.csv
+ *   display_bench --compare main.csv
+ * With --mode framebuffer or banded every call is one frame and its cost
+ * is the flush in display_end_frame().
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "display.h"
+#include "host_mocks.h"
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define CALLS               50      // Calls per case, results are averages
+#define SPRITE_MAX          64
+#define FRAME_US            33000   // 30 FPS
+#define NAME_MAX            32
+#define BASELINE_MAX        64
+
+#define COLOR_BG            0x0000
+#define COLOR_FG            0xFFE0
+#define COLOR_KEY           0xF81F  // Transparent colour of the test sprites
+
+//=============================================================================
+// Types
+//=============================================================================
+
+typedef enum {
+    PRIM_FILL_RECT,
+    PRIM_SPRITE_OPAQUE,
+    PRIM_SPRITE_TRANSPARENT,
+    PRIM_SPRITE_SCALED,
+    PRIM_CHAR,
+    PRIM_STRING,
+} bench_prim_t;
+
+typedef struct {
+    const char *name;
+    bench_prim_t prim;
+    int16_t w, h;               // Rectangle or sprite size
+    uint8_t scale;              // Sprite scale or font size
+    const char *text;           // PRIM_STRING
+} bench_case_t;
+
+typedef struct {
+    char name[NAME_MAX];
+    double us, transactions, bytes, dc_toggles;
+} bench_result_t;
+
+static const bench_case_t s_cases[] = {
+    { "fill_rect_8x8",          PRIM_FILL_RECT, 8, 8, 0, NULL },
+    { "fill_rect_32x32",        PRIM_FILL_RECT, 32, 32, 0, NULL },
+    { "fill_rect_120x67",       PRIM_FILL_RECT, 120, 67, 0, NULL },
+    { "fill_rect_240x135",      PRIM_FILL_RECT, 240, 135, 0, NULL },
+    { "sprite_opaque_16x16",    PRIM_SPRITE_OPAQUE, 16, 16, 0, NULL },
+    { "sprite_opaque_32x32",    PRIM_SPRITE_OPAQUE, 32, 32, 0, NULL },
+    { "sprite_opaque_64x64",    PRIM_SPRITE_OPAQUE, 64, 64, 0, NULL },
+    { "sprite_transp_16x16",    PRIM_SPRITE_TRANSPARENT, 16, 16, 0, NULL },
+    { "sprite_transp_32x32",    PRIM_SPRITE_TRANSPARENT, 32, 32, 0, NULL },
+    { "sprite_transp_64x64",    PRIM_SPRITE_TRANSPARENT, 64, 64, 0, NULL },
+    { "sprite_scaled_16x16_x2", PRIM_SPRITE_SCALED, 16, 16, 2, NULL },
+    { "sprite_scaled_16x16_x4", PRIM_SPRITE_SCALED, 16, 16, 4, NULL },
+    { "sprite_scaled_32x32_x2", PRIM_SPRITE_SCALED, 32, 32, 2, NULL },
+    { "char_size1",             PRIM_CHAR, 0, 0, 1, NULL },
+    { "char_size2",             PRIM_CHAR, 0, 0, 2, NULL },
+    { "char_size3",             PRIM_CHAR, 0, 0, 3, NULL },
+    { "string_label_size1",     PRIM_STRING, 0, 0, 1, "HUNGER" },
+    { "string_title_size2",     PRIM_STRING, 0, 0, 2, "Hello, Tama!" },
+    { "string_line_size1",      PRIM_STRING, 0, 0, 1, "Your pet is hungry. Feed it soon!" },
+};
+
+#define CASE_COUNT (sizeof(s_cases) / sizeof(s_cases[0]))
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+static uint16_t s_opaque[SPRITE_MAX * SPRITE_MAX];
+static uint16_t s_shaped[SPRITE_MAX * SPRITE_MAX];
+static bench_result_t s_results[CASE_COUNT];
+static bench_result_t s_baseline[BASELINE_MAX];
+static int s_baseline_count;
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+/**
+ * @brief Test sprites of size w x h: a colour gradient, and the same
+ *        inside a disc with the corners transparent like a pet sprite
+ */
+static void make_sprites(int w, int h)
+{
+    int cx = w / 2, cy = h / 2;
+    int r2 = (w / 2) * (w / 2);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            uint16_t c = (uint16_t)(((x * 31 / w) << 11) | ((y * 63 / h) << 5) | 0x0A);
+            if (c == COLOR_KEY) c ^= 1;
+            int dx = x - cx, dy = y - cy;
+            s_opaque[y * w + x] = c;
+            s_shaped[y * w + x] = (dx * dx + dy * dy <= r2) ? c : COLOR_KEY;
+        }
+    }
+}
+
+static void draw_case(const bench_case_t *c, int call)
+{
+    // Move a little each call so nothing depends on the previous window
+    int16_t x = (int16_t)(4 + call % 8);
+    int16_t y = (int16_t)(4 + call % 4);
+
+    switch (c->prim) {
+        case PRIM_FILL_RECT:
+            if (c->w >= 240) x = y = 0;
+            display_fill_rect(x, y, c->w, c->h, (uint16_t)(COLOR_FG ^ call));
+            break;
+        case PRIM_SPRITE_OPAQUE:
+            display_draw_sprite(x, y, c->w, c->h, s_opaque, COLOR_KEY);
+            break;
+        case PRIM_SPRITE_TRANSPARENT:
+            display_draw_sprite(x, y, c->w, c->h, s_shaped, COLOR_KEY);
+            break;
+        case PRIM_SPRITE_SCALED:
+            display_draw_sprite_scaled(x, y, c->w, c->h, s_shaped, COLOR_KEY, c->scale);
+            break;
+        case PRIM_CHAR:
+            display_draw_char(x, y, (char)('A' + call % 26), COLOR_FG, COLOR_BG, c->scale);
+            break;
+        case PRIM_STRING:
+            display_draw_string(x, y, c->text, COLOR_FG, COLOR_BG, c->scale);
+            break;
+    }
+}
+
+static void run_case(const bench_case_t *c, bench_result_t *r)
+{
+    mock_spi_stats_t spi;
+
+    if (c->w > 0) make_sprites(c->w, c->h);
+    display_fill(COLOR_BG);
+
+    mock_spi_reset_stats();
+    for (int call = 0; call < CALLS; call++) {
+        display_start_frame();
+        draw_case(c, call);
+        display_end_frame();
+    }
+    mock_spi_get_stats(&spi);
+
+    snprintf(r->name, sizeof(r->name), "%s", c->name);
+    r->us = (double)spi.bus_ns / 1000.0 / CALLS;
+    r->transactions = (double)spi.transactions / CALLS;
+    r->bytes = (double)spi.bytes / CALLS;
+    r->dc_toggles = (double)spi.dc_toggles / CALLS;
+}
+
+static esp_err_t write_csv(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (f == NULL) return ESP_FAIL;
+
+    fprintf(f, "name,us_per_call,transactions_per_call,bytes_per_call,dc_toggles_per_call\n");
+    for (size_t i = 0; i < CASE_COUNT; i++) {
+        const bench_result_t *r = &s_results[i];
+        fprintf(f, "%s,%.3f,%.2f,%.1f,%.2f\n",
+                r->name, r->us, r->transactions, r->bytes, r->dc_toggles);
+    }
+    return fclose(f) == 0 ? ESP_OK : ESP_FAIL;
+}
+
+static esp_err_t read_csv(const char *path)
+{
+    char line[128];
+    FILE *f = fopen(path, "r");
+    if (f == NULL) return ESP_ERR_NOT_FOUND;
+
+    s_baseline_count = 0;
+    while (fgets(line, sizeof(line), f) != NULL && s_baseline_count < BASELINE_MAX) {
+        bench_result_t *r = &s_baseline[s_baseline_count];
+        char *comma = strchr(line, ',');
+        if (comma == NULL || comma - line >= NAME_MAX) continue;
+        *comma = '\0';
+        if (sscanf(comma + 1, "%lf,%lf,%lf,%lf",
+                   &r->us, &r->transactions, &r->bytes, &r->dc_toggles) != 4) {
+            continue;       // Header
+        }
+        memcpy(r->name, line, (size_t)(comma - line) + 1);
+        s_baseline_count++;
+    }
+    fclose(f);
+    return ESP_OK;
+}
+
+static const bench_result_t *find_baseline(const char *name)
+{
+    for (int i = 0; i < s_baseline_count; i++) {
+        if (strcmp(s_baseline[i].name, name) == 0) return &s_baseline[i];
+    }
+    return NULL;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--mode immediate|framebuffer|banded] [--csv FILE] [--compare FILE]\n"
+            "          [--transaction-ns N] [--dc-ns N]\n", prog);
+}
+
+//=============================================================================
+// Main
+//=============================================================================
+
+int main(int argc, char **argv)
+{
+    display_render_mode_t mode = DISPLAY_RENDER_IMMEDIATE;
+    mock_spi_cost_t cost = {
+        .transaction_ns = MOCK_SPI_TRANSACTION_NS,
+        .dc_toggle_ns = MOCK_SPI_DC_TOGGLE_NS,
+    };
+    const char *csv = NULL;
+    const char *compare = NULL;
+    static const char *mode_names[] = { "immediate", "framebuffer", "banded" };
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--mode") == 0 && i + 1 < argc) {
+            i++;
+            for (mode = 0; mode < 3 && strcmp(argv[i], mode_names[mode]) != 0; mode++) {}
+            if (mode == 3) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csv = argv[++i];
+        } else if (strcmp(argv[i], "--compare") == 0 && i + 1 < argc) {
+            compare = argv[++i];
+        } else if (strcmp(argv[i], "--transaction-ns") == 0 && i + 1 < argc) {
+            cost.transaction_ns = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--dc-ns") == 0 && i + 1 < argc) {
+            cost.dc_toggle_ns = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (compare != NULL && read_csv(compare) != ESP_OK) {
+        fprintf(stderr, "cannot read %s\n", compare);
+        return EXIT_FAILURE;
+    }
+
+    mock_clock_set_virtual(true);
+    if (display_init() != ESP_OK || display_set_render_mode(mode) != ESP_OK) {
+        fprintf(stderr, "display init failed\n");
+        return EXIT_FAILURE;
+    }
+    mock_spi_set_cost(&cost);
+
+    printf("display primitives, %s mode, %d calls each, %lu ns per transaction, %lu ns per DC change\n",
+           mode_names[mode], CALLS, (unsigned long)cost.transaction_ns,
+           (unsigned long)cost.dc_toggle_ns);
+    printf("%-24s %10s %8s %9s %6s\n", "case", "us/call", "txn", "bytes", "dc");
+    for (size_t i = 0; i < CASE_COUNT; i++) {
+        bench_result_t *r = &s_results[i];
+        run_case(&s_cases[i], r);
+        printf("%-24s %10.2f %8.1f %9.0f %6.1f", r->name, r->us, r->transactions,
+               r->bytes, r->dc_toggles);
+
+        const bench_result_t *base = compare != NULL ? find_baseline(r->name) : NULL;
+        if (base != NULL && base->us > 0) {
+            printf("   was %9.2f (%+.1f%%)", base->us, (r->us - base->us) * 100.0 / base->us);
+        } else if (compare != NULL) {
+            printf("   new");
+        }
+        printf("\n");
+    }
+
+    if (csv != NULL && write_csv(csv) != ESP_OK) {
+        fprintf(stderr, "cannot write %s\n", csv);
+        return EXIT_FAILURE;
+    }
+
+    // Sanity: a full-screen fill carries every pixel and fits in a frame
+    const bench_result_t *full = &s_results[3];
+    if (full->bytes < 240.0 * 135 * 2 || full->us > FRAME_US) {
+        printf("FAIL: full-screen fill %.0f bytes in %.0f us\n", full->bytes, full->us);
+        return EXIT_FAILURE;
+    }
+    if (mock_lcd_stray_pixels() != 0) {
+        printf("FAIL: %lu pixels outside the panel\n", (unsigned long)mock_lcd_stray_pixels());
+        return EXIT_FAILURE;
+    }
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file obstacle_bench.c
+ * @brief Host benchmark for the mini-game obstacle pool
+ *
+ * REQ-SW-062: Mini-game Obstacle Pool
+ * REQ-SW-063: Pixel-accurate Mini-game Collision
+ * Keeps the pool filled with dozens of obstacles and times what one
+ * rendered frame costs the game at 30 FPS: the physics steps covering
+ * 33 ms (spawner, step, collision query, mask test of the obstacles in
+ * the dolphin's column) and the render culling query. A second pass
+ * times the mask test alone for pairs whose bounding boxes overlap, the
+ * worst case. Fails when a frame takes more than a tenth of its budget,
+ * leaving the rest for drawing and the slower target CPU.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "obstacles.h"
+#include "sprite_mask.h"
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define SCREEN_W            240
+#define GROUND_Y            95
+#define STEP_MS             8
+#define FRAME_MS            33      // 30 FPS
+#define STEPS_PER_FRAME     ((FRAME_MS + STEP_MS - 1) / STEP_MS)
+#define FRAMES              20000
+#define POOL_TARGET         48      // Obstacles kept alive
+#define SPEED_Q8            ((110 << OBSTACLE_FP_SHIFT) * STEP_MS / 1000)
+#define DOLPHIN_X           30
+#define DOLPHIN_W           32
+#define DOLPHIN_H           24
+#define BUDGET_SHARE        10      // Pool may use 1/10 of the frame
+#define MASK_PAIRS          100000
+
+static const sprite_asset_t s_kind_sprites[OBSTACLE_KIND_COUNT] = {
+    [OBSTACLE_WAVE] = SPRITE_ASSET_MG_WAVE,
+    [OBSTACLE_ROCK] = SPRITE_ASSET_MG_ROCK,
+    [OBSTACLE_FISH] = SPRITE_ASSET_MG_FISH,
+};
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+static uint32_t s_rng_state = 0x2545F491;
+
+static uint32_t bench_random(void)
+{
+    // xorshift32: deterministic across runs
+    s_rng_state ^= s_rng_state << 13;
+    s_rng_state ^= s_rng_state >> 17;
+    s_rng_state ^= s_rng_state << 5;
+    return s_rng_state;
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Pixel test of the obstacles in the dolphin's column
+ * @return Number of touching obstacles
+ */
+static int collide(const obstacle_pool_t *pool, const sprite_mask_t *dolphin, int dolphin_y)
+{
+    uint8_t near[OBSTACLE_MAX];
+    int n = obstacles_query(pool, DOLPHIN_X, DOLPHIN_X + DOLPHIN_W, near, OBSTACLE_MAX);
+    int hits = 0;
+    for (int k = 0; k < n; k++) {
+        int i = near[k];
+        const sprite_mask_t *mask = sprite_mask_get(s_kind_sprites[pool->kind[i]]);
+        if (sprite_mask_overlap(dolphin, DOLPHIN_X, dolphin_y,
+                                mask, pool->x[i] >> OBSTACLE_FP_SHIFT, pool->y[i])) {
+            hits++;
+        }
+    }
+    return hits;
+}
+
+/**
+ * @brief Top up the pool with obstacles spread over a wide track
+ */
+static void refill(obstacle_pool_t *pool)
+{
+    while (pool->count < POOL_TARGET) {
+        obstacle_kind_t kind = (obstacle_kind_t)(bench_random() % OBSTACLE_KIND_COUNT);
+        int32_t x = (int32_t)(SCREEN_W + bench_random() % (SCREEN_W * 4)) << OBSTACLE_FP_SHIFT;
+        int32_t vx = SPEED_Q8 + (int32_t)(bench_random() % 32);
+        if (obstacles_spawn(pool, kind, x, GROUND_Y - obstacle_kinds[kind].h, vx) < 0) break;
+    }
+}
+
+//=============================================================================
+// Main
+//=============================================================================
+
+int main(void)
+{
+    static obstacle_pool_t pool;
+    obstacle_spawner_t spawner;
+    const sprite_mask_t *dolphin = sprite_mask_get(SPRITE_ASSET_BABY_IDLE_1);
+    uint8_t visible[OBSTACLE_MAX];
+    uint64_t checksum = 0;
+    uint32_t min_count = OBSTACLE_MAX, max_count = 0;
+
+    obstacles_reset(&pool);
+    obstacles_spawner_init(&spawner, 2, 255, GROUND_Y, SPEED_Q8, bench_random);
+    refill(&pool);
+
+    uint64_t start = now_ns();
+    uint64_t worst = 0;
+
+    for (int frame = 0; frame < FRAMES; frame++) {
+        uint64_t t0 = now_ns();
+
+        for (int step = 0; step < STEPS_PER_FRAME; step++) {
+            obstacles_spawner_step(&spawner, &pool, SCREEN_W + 8);
+            obstacles_step(&pool, 0);
+            // Dolphin bobs through the whole jump range
+            checksum += (uint64_t)collide(&pool, dolphin, GROUND_Y - DOLPHIN_H - (frame + step) % 64);
+        }
+        checksum += (uint64_t)obstacles_query(&pool, -4, SCREEN_W, visible, OBSTACLE_MAX);
+
+        uint64_t elapsed = now_ns() - t0;
+        if (elapsed > worst) worst = elapsed;
+
+        if (pool.count < min_count) min_count = pool.count;
+        if (pool.count > max_count) max_count = pool.count;
+
+        // Outside the timed region: keep the pool at dozens of objects
+        refill(&pool);
+        if (obstacles_spawner_done(&spawner)) spawner.patterns_left = 255;
+    }
+
+    uint64_t total = now_ns() - start;
+    double avg_us = (double)total / FRAMES / 1000.0;
+
+    // Worst case for the mask test: bounding boxes always overlap
+    uint32_t mask_hits = 0;
+    uint64_t mask_start = now_ns();
+    for (int i = 0; i < MASK_PAIRS; i++) {
+        const sprite_mask_t *mask = sprite_mask_get(s_kind_sprites[i % OBSTACLE_KIND_COUNT]);
+        int dx = (int)(bench_random() % (DOLPHIN_W + mask->w - 1)) - (mask->w - 1);
+        int dy = (int)(bench_random() % (DOLPHIN_H + mask->h - 1)) - (mask->h - 1);
+        mask_hits += sprite_mask_overlap(dolphin, 0, 0, mask, dx, dy);
+    }
+    double mask_ns = (double)(now_ns() - mask_start) / MASK_PAIRS;
+    double worst_us = (double)worst / 1000.0;
+    double budget_us = FRAME_MS * 1000.0 / BUDGET_SHARE;
+
+    // Sanity: the pool must still be sorted
+    for (int i = 1; i < pool.count; i++) {
+        if (pool.x[i - 1] > pool.x[i]) {
+            printf("FAIL: pool not sorted at %d\n", i);
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf("obstacles: %lu-%lu live, %d steps per frame (checksum %llu)\n",
+           (unsigned long)min_count, (unsigned long)max_count, STEPS_PER_FRAME,
+           (unsigned long long)checksum);
+    printf("masks: %.1f ns per overlapping pair (%lu of %d touch)\n",
+           mask_ns, (unsigned long)mask_hits, MASK_PAIRS);
+    printf("frame: avg %.2f us, worst %.2f us, budget %.0f us (1/%d of %d ms)\n",
+           avg_us, worst_us, budget_us, BUDGET_SHARE, FRAME_MS);
+
+    if (avg_us > budget_us) {
+        printf("FAIL: over budget\n");
+        return EXIT_FAILURE;
+    }
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
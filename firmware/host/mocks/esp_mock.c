@@ -0,0 +1,163 @@
+/**
+ * @file esp_mock.c
+ * @brief Clock, task delay, random numbers and asset partition for host builds
+ *
+ * REQ-SW-055: Host Build
+ * esp_timer runs on the host's monotonic clock until a program switches
+ * to the virtual clock; then time only moves through
+ * mock_clock_advance_us() and task delays, so runs repeat exactly.
+ */
+
+#include "host_mocks.h"
+#include "esp_timer.h"
+#include "esp_random.h"
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+#include "freertos/task.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+//=============================================================================
+// Configuration
+//=============================================================================
+
+#define PARTITION_SIZE      0xF0000     // "assets" in partitions.csv
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+static bool s_virtual = false;
+static int64_t s_virtual_us = 0;
+static uint32_t s_random = 0x2545F491;
+
+static const esp_partition_t s_assets_partition = {
+    .type = ESP_PARTITION_TYPE_DATA,
+    .subtype = 0x40,
+    .size = PARTITION_SIZE,
+    .label = "assets",
+};
+static uint8_t s_partition_data[PARTITION_SIZE];
+static bool s_partition_loaded = false;
+
+// GPIO script (gpio_mock.c)
+int64_t mock_gpio_script_next_us(void);
+void mock_gpio_script_step(void);
+
+//=============================================================================
+// Clock
+//=============================================================================
+
+int64_t esp_timer_get_time(void)
+{
+    if (s_virtual) return s_virtual_us;
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+void mock_clock_set_virtual(bool on)
+{
+    s_virtual = on;
+    s_virtual_us = 0;
+}
+
+void mock_clock_advance_us(int64_t us)
+{
+    int64_t until = s_virtual_us + us;
+
+    // Each scripted edge happens, and is timestamped, at its own time
+    for (int64_t at = mock_gpio_script_next_us(); at <= until; at = mock_gpio_script_next_us()) {
+        if (at > s_virtual_us) s_virtual_us = at;
+        mock_gpio_script_step();
+    }
+    s_virtual_us = until;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    if (s_virtual) {
+        mock_clock_advance_us((int64_t)ticks * portTICK_PERIOD_MS * 1000);
+    }
+}
+
+//=============================================================================
+// Random Numbers
+//=============================================================================
+
+uint32_t esp_random(void)
+{
+    // xorshift32: fixed sequence, so host runs repeat
+    s_random ^= s_random << 13;
+    s_random ^= s_random >> 17;
+    s_random ^= s_random << 5;
+    return s_random;
+}
+
+//=============================================================================
+// Asset Partition
+//=============================================================================
+
+esp_err_t mock_partition_load(const char *path)
+{
+    s_partition_loaded = false;
+    memset(s_partition_data, 0xFF, sizeof(s_partition_data));    // Erased flash
+    if (path == NULL) return ESP_OK;
+
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) return ESP_ERR_NOT_FOUND;
+    fread(s_partition_data, 1, sizeof(s_partition_data), f);
+    fclose(f);
+    s_partition_loaded = true;
+    return ESP_OK;
+}
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type,
+                                                esp_partition_subtype_t subtype,
+                                                const char *label)
+{
+    if (!s_partition_loaded || type != s_assets_partition.type ||
+        subtype != s_assets_partition.subtype ||
+        (label != NULL && strcmp(label, s_assets_partition.label) != 0)) {
+        return NULL;
+    }
+    return &s_assets_partition;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *part, size_t offset, void *dst, size_t size)
+{
+    if (offset + size > part->size) return ESP_ERR_INVALID_SIZE;
+    memcpy(dst, s_partition_data + offset, size);
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_mmap(const esp_partition_t *part, size_t offset, size_t size,
+                             esp_partition_mmap_memory_t memory, const void **out_ptr,
+                             esp_partition_mmap_handle_t *out_handle)
+{
+    (void)memory;
+    if (offset + size > part->size) return ESP_ERR_INVALID_SIZE;
+    *out_ptr = s_partition_data + offset;
+    *out_handle = 1;
+    return ESP_OK;
+}
+
+void esp_partition_munmap(esp_partition_mmap_handle_t handle)
+{
+    (void)handle;
+}
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    // Reflected CRC-32 (zlib), as the asset compiler computes it
+    crc = ~crc;
+    while (len--) {
+        crc ^= *buf++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file gpio_mock.c
+ * @brief Scripted GPIO for host builds
+ *
+ * REQ-SW-055: Host Build
+ * Outputs remember their level; inputs are driven by the program, either
+ * at once or from a script applied as the virtual clock passes each
+ * entry. Edge interrupts call the handlers registered through the ISR
+ * service, on the caller's thread, like an ISR preempting the firmware.
+ */
+
+#include "host_mocks.h"
+#include "driver/gpio.h"
+#include <stddef.h>
+#include <stdint.h>
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+typedef struct {
+    int64_t at_us;
+    uint8_t gpio;
+    uint8_t level;
+} gpio_step_t;
+
+static uint8_t s_level[MOCK_GPIO_COUNT];
+static gpio_int_type_t s_intr[MOCK_GPIO_COUNT];
+static gpio_isr_t s_isr[MOCK_GPIO_COUNT];
+static void *s_isr_arg[MOCK_GPIO_COUNT];
+
+static gpio_step_t s_script[MOCK_GPIO_SCRIPT_MAX];
+static int s_script_len = 0;
+static int s_script_next = 0;
+
+static inline bool valid_gpio(int gpio)
+{
+    return gpio >= 0 && gpio < MOCK_GPIO_COUNT;
+}
+
+//=============================================================================
+// Driver API
+//=============================================================================
+
+esp_err_t gpio_config(const gpio_config_t *config)
+{
+    for (int gpio = 0; gpio < MOCK_GPIO_COUNT; gpio++) {
+        if (!(config->pin_bit_mask & (1ULL << gpio))) continue;
+        s_intr[gpio] = config->intr_type;
+        if (config->mode == GPIO_MODE_INPUT) {
+            s_level[gpio] = config->pull_up_en == GPIO_PULLUP_ENABLE;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio, uint32_t level)
+{
+    if (!valid_gpio(gpio)) return ESP_ERR_INVALID_ARG;
+    s_level[gpio] = level != 0;
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio)
+{
+    return valid_gpio(gpio) ? s_level[gpio] : 0;
+}
+
+esp_err_t gpio_install_isr_service(int intr_alloc_flags)
+{
+    (void)intr_alloc_flags;
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio, gpio_isr_t handler, void *arg)
+{
+    if (!valid_gpio(gpio)) return ESP_ERR_INVALID_ARG;
+    s_isr[gpio] = handler;
+    s_isr_arg[gpio] = arg;
+    return ESP_OK;
+}
+
+//=============================================================================
+// Mock Control
+//=============================================================================
+
+void mock_gpio_drive(int gpio, int level)
+{
+    if (!valid_gpio(gpio)) return;
+
+    level = level != 0;
+    if (s_level[gpio] == level) return;
+    s_level[gpio] = (uint8_t)level;
+
+    gpio_int_type_t intr = s_intr[gpio];
+    bool fire = intr == GPIO_INTR_ANYEDGE ||
+                (intr == GPIO_INTR_POSEDGE && level) ||
+                (intr == GPIO_INTR_NEGEDGE && !level);
+    if (fire && s_isr[gpio] != NULL) {
+        s_isr[gpio](s_isr_arg[gpio]);
+    }
+}
+
+esp_err_t mock_gpio_script(int64_t at_us, int gpio, int level)
+{
+    if (s_script_len >= MOCK_GPIO_SCRIPT_MAX) return ESP_ERR_NO_MEM;
+    if (!valid_gpio(gpio)) return ESP_ERR_INVALID_ARG;
+
+    // Keep the script sorted by time (stable for equal times)
+    int i = s_script_len++;
+    while (i > s_script_next && s_script[i - 1].at_us > at_us) {
+        s_script[i] = s_script[i - 1];
+        i--;
+    }
+    s_script[i] = (gpio_step_t){ .at_us = at_us, .gpio = (uint8_t)gpio, .level = (uint8_t)level };
+    return ESP_OK;
+}
+
+void mock_gpio_script_clear(void)
+{
+    s_script_len = 0;
+    s_script_next = 0;
+}
+
+/**
+ * @brief Time of the next script entry (INT64_MAX: none), for the clock
+ */
+int64_t mock_gpio_script_next_us(void)
+{
+    return s_script_next < s_script_len ? s_script[s_script_next].at_us : INT64_MAX;
+}
+
+/**
+ * @brief Apply the next script entry (the clock has reached its time)
+ */
+void mock_gpio_script_step(void)
+{
+    if (s_script_next < s_script_len) {
+        const gpio_step_t *step = &s_script[s_script_next++];
+        mock_gpio_drive(step->gpio, step->level);
+    }
+}
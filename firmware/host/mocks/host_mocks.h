@@ -0,0 +1,147 @@
+/**
+ * @file host_mocks.h
+ * @brief Control of the mocked ESP-IDF drivers in host builds
+ *
+ * REQ-SW-055: Host Build
+ * The firmware components call the ESP-IDF API as on the device; these
+ * functions let a host program or test steer what that API sees:
+ *   - clock:     esp_timer on the host clock, or a virtual clock that only
+ *                moves when told to (task delays advance it)
+ *   - GPIO:      input levels driven directly or from a time script, with
+ *                the registered edge ISRs called like on the device
+ *   - LCD:       an ST7789 model decoding the SPI traffic into the panel
+ *                image (what would be on the glass), with an estimate of
+ *                the bus time the traffic would take on the device
+ *   - NVS:       in-memory keys, cleared with nvs_flash_erase()
+ *   - partition: the asset pack partition backed by a file
+ * Everything is single-threaded and static.
+ */
+
+#ifndef HOST_MOCKS_H
+#define HOST_MOCKS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define MOCK_LCD_WIDTH      240     // Visible panel, landscape
+#define MOCK_LCD_HEIGHT     135
+#define MOCK_GPIO_COUNT     40
+#define MOCK_GPIO_SCRIPT_MAX 256    // Scheduled level changes
+
+// SPI cost model defaults (REQ-SW-056): polling transaction setup and
+// completion in the ESP-IDF driver, and one gpio_set_level() that changes DC
+#define MOCK_SPI_TRANSACTION_NS 2500
+#define MOCK_SPI_DC_TOGGLE_NS   150
+
+//=============================================================================
+// Types
+//=============================================================================
+
+/**
+ * @brief SPI cost model; the clock comes from spi_bus_add_device()
+ */
+typedef struct {
+    uint32_t transaction_ns;    // Fixed cost per transaction
+    uint32_t dc_toggle_ns;      // Cost when a transaction follows a DC change
+} mock_spi_cost_t;
+
+/**
+ * @brief Traffic on the mocked SPI bus since the last reset
+ */
+typedef struct {
+    uint64_t bus_ns;            // Modelled time: clocked bits plus overheads
+    uint32_t transactions;
+    uint32_t bytes;
+    uint32_t dc_toggles;
+} mock_spi_stats_t;
+
+//=============================================================================
+// Clock
+//=============================================================================
+
+/**
+ * @brief Switch esp_timer to the virtual clock (starts at 0) or back
+ */
+void mock_clock_set_virtual(bool on);
+
+/**
+ * @brief Move the virtual clock forward, applying scripted GPIO changes
+ *        at their times on the way
+ */
+void mock_clock_advance_us(int64_t us);
+
+//=============================================================================
+// GPIO
+//=============================================================================
+
+/**
+ * @brief Drive an input pin; calls its ISR if the level changes
+ */
+void mock_gpio_drive(int gpio, int level);
+
+/**
+ * @brief Schedule mock_gpio_drive() at a virtual clock time
+ * @return ESP_ERR_NO_MEM when the script is full
+ */
+esp_err_t mock_gpio_script(int64_t at_us, int gpio, int level);
+
+/**
+ * @brief Drop all scheduled changes
+ */
+void mock_gpio_script_clear(void);
+
+//=============================================================================
+// LCD
+//=============================================================================
+
+/**
+ * @brief Panel image, MOCK_LCD_WIDTH x MOCK_LCD_HEIGHT RGB565, row-major
+ */
+const uint16_t *mock_lcd_pixels(void);
+
+/**
+ * @brief Pixel of the panel image (0 outside)
+ */
+uint16_t mock_lcd_pixel(int x, int y);
+
+/**
+ * @brief Pixels written outside the visible panel or without a window
+ */
+uint32_t mock_lcd_stray_pixels(void);
+
+/**
+ * @brief Save the panel image as a binary PPM
+ */
+esp_err_t mock_lcd_write_ppm(const char *path);
+
+/**
+ * @brief Replace the SPI cost model (NULL: defaults)
+ */
+void mock_spi_set_cost(const mock_spi_cost_t *cost);
+
+/**
+ * @brief SPI traffic and its modelled bus time since the last reset
+ */
+void mock_spi_get_stats(mock_spi_stats_t *stats);
+
+/**
+ * @brief Zero the SPI traffic counters
+ */
+void mock_spi_reset_stats(void);
+
+//=============================================================================
+// Asset Partition
+//=============================================================================
+
+/**
+ * @brief Back the asset pack partition with a file (NULL: no partition)
+ * @return ESP_ERR_NOT_FOUND if the file cannot be read
+ */
+esp_err_t mock_partition_load(const char *path);
+
+#endif // HOST_MOCKS_H
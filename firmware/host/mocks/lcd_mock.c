@@ -0,0 +1,254 @@
+/**
+ * @file lcd_mock.c
+ * @brief SPI master and ST7789 panel model for host builds
+ *
+ * REQ-SW-055: Host Build
+ * Decodes what display.c sends over SPI the way the controller would: a
+ * byte sent with DC low is a command, bytes with DC high its parameters.
+ * CASET/RASET set the address window, RAMWR streams big-endian RGB565
+ * pixels into it row by row. The TTGO T-Display shows a 240x135 part of
+ * controller RAM at a fixed offset; that part is the panel image.
+ *
+ * REQ-SW-056: Display Benchmarks
+ * Every transaction is also costed as on the device: its bits at the
+ * device clock plus a fixed driver overhead, and a DC pin change before
+ * it. The estimate does not move the virtual clock.
+ */
+
+#include "host_mocks.h"
+#include "driver/spi_master.h"
+#include "driver/gpio.h"
+#include <stdio.h>
+#include <string.h>
+
+//=============================================================================
+// Configuration
+//=============================================================================
+
+#define LCD_PIN_DC          16      // Must match display.c
+#define LCD_COL_OFFSET      52      // Visible area in controller RAM
+#define LCD_ROW_OFFSET      40
+
+#define CMD_CASET           0x2A
+#define CMD_RASET           0x2B
+#define CMD_RAMWR           0x2C
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+static uint16_t s_panel[MOCK_LCD_HEIGHT][MOCK_LCD_WIDTH];
+static int s_max_transfer = 4092;
+static int s_clock_hz = 40 * 1000 * 1000;
+static mock_spi_cost_t s_cost = {
+    .transaction_ns = MOCK_SPI_TRANSACTION_NS,
+    .dc_toggle_ns = MOCK_SPI_DC_TOGGLE_NS,
+};
+static mock_spi_stats_t s_spi;
+static int s_last_dc = -1;
+
+static struct {
+    uint8_t cmd;                // Last command
+    uint8_t params[4];
+    int param_count;
+    uint16_t xs, xe, ys, ye;    // Address window (controller RAM)
+    uint16_t x, y;              // Write pointer
+    bool writing;               // RAMWR active, pointer inside the window
+    int pending;                // High byte waiting for its low byte, -1 none
+    uint32_t stray;
+} s_lcd;
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+static void lcd_command(uint8_t cmd)
+{
+    s_lcd.cmd = cmd;
+    s_lcd.param_count = 0;
+    s_lcd.pending = -1;
+    s_lcd.writing = false;
+
+    if (cmd == CMD_RAMWR) {
+        s_lcd.x = s_lcd.xs;
+        s_lcd.y = s_lcd.ys;
+        s_lcd.writing = true;
+    }
+}
+
+static void lcd_pixel(uint16_t color)
+{
+    if (!s_lcd.writing) {
+        s_lcd.stray++;      // Window already full
+        return;
+    }
+
+    int px = s_lcd.x - LCD_COL_OFFSET;
+    int py = s_lcd.y - LCD_ROW_OFFSET;
+    if (px >= 0 && px < MOCK_LCD_WIDTH && py >= 0 && py < MOCK_LCD_HEIGHT) {
+        s_panel[py][px] = color;
+    } else {
+        s_lcd.stray++;
+    }
+
+    if (s_lcd.x < s_lcd.xe) {
+        s_lcd.x++;
+    } else if (s_lcd.y < s_lcd.ye) {
+        s_lcd.x = s_lcd.xs;
+        s_lcd.y++;
+    } else {
+        s_lcd.writing = false;
+    }
+}
+
+static void lcd_data(uint8_t byte)
+{
+    switch (s_lcd.cmd) {
+        case CMD_CASET:
+        case CMD_RASET:
+            if (s_lcd.param_count < 4) {
+                s_lcd.params[s_lcd.param_count++] = byte;
+            }
+            if (s_lcd.param_count == 4) {
+                uint16_t start = (uint16_t)(s_lcd.params[0] << 8 | s_lcd.params[1]);
+                uint16_t end = (uint16_t)(s_lcd.params[2] << 8 | s_lcd.params[3]);
+                if (s_lcd.cmd == CMD_CASET) {
+                    s_lcd.xs = start;
+                    s_lcd.xe = end;
+                } else {
+                    s_lcd.ys = start;
+                    s_lcd.ye = end;
+                }
+            }
+            break;
+
+        case CMD_RAMWR:
+            if (s_lcd.pending < 0) {
+                s_lcd.pending = byte;
+            } else {
+                lcd_pixel((uint16_t)(s_lcd.pending << 8 | byte));
+                s_lcd.pending = -1;
+            }
+            break;
+
+        default:
+            break;          // Other commands' parameters do not change the image
+    }
+}
+
+//=============================================================================
+// Driver API
+//=============================================================================
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *config, int dma_chan)
+{
+    (void)host;
+    (void)dma_chan;
+    s_max_transfer = config->max_transfer_sz;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *config,
+                             spi_device_handle_t *handle)
+{
+    static int s_device;
+
+    (void)host;
+    s_clock_hz = config->clock_speed_hz;
+    memset(&s_lcd, 0, sizeof(s_lcd));
+    memset(s_panel, 0, sizeof(s_panel));
+    s_lcd.pending = -1;
+    *handle = (spi_device_handle_t)&s_device;
+    return ESP_OK;
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans)
+{
+    (void)handle;
+    size_t bytes = trans->length / 8;
+    if (trans->length % 8 != 0 || (int)bytes > s_max_transfer) {
+        return ESP_ERR_INVALID_ARG;     // As the real driver rejects it
+    }
+
+    const uint8_t *data = trans->tx_buffer;
+    int dc = gpio_get_level(LCD_PIN_DC);
+    bool command = dc == 0;
+
+    s_spi.bus_ns += s_cost.transaction_ns + (uint64_t)trans->length * 1000000000u / s_clock_hz;
+    if (dc != s_last_dc) {
+        s_spi.bus_ns += s_cost.dc_toggle_ns;
+        s_spi.dc_toggles++;
+        s_last_dc = dc;
+    }
+    s_spi.transactions++;
+    s_spi.bytes += bytes;
+
+    for (size_t i = 0; i < bytes; i++) {
+        if (command) {
+            lcd_command(data[i]);
+        } else {
+            lcd_data(data[i]);
+        }
+    }
+    return ESP_OK;
+}
+
+//=============================================================================
+// Mock Control
+//=============================================================================
+
+const uint16_t *mock_lcd_pixels(void)
+{
+    return &s_panel[0][0];
+}
+
+uint16_t mock_lcd_pixel(int x, int y)
+{
+    if (x < 0 || x >= MOCK_LCD_WIDTH || y < 0 || y >= MOCK_LCD_HEIGHT) return 0;
+    return s_panel[y][x];
+}
+
+uint32_t mock_lcd_stray_pixels(void)
+{
+    return s_lcd.stray;
+}
+
+esp_err_t mock_lcd_write_ppm(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) return ESP_FAIL;
+
+    fprintf(f, "P6\n%d %d\n255\n", MOCK_LCD_WIDTH, MOCK_LCD_HEIGHT);
+    for (int y = 0; y < MOCK_LCD_HEIGHT; y++) {
+        for (int x = 0; x < MOCK_LCD_WIDTH; x++) {
+            uint16_t c = s_panel[y][x];
+            uint8_t rgb[3] = {
+                (uint8_t)((c >> 11) * 255 / 31),
+                (uint8_t)(((c >> 5) & 0x3F) * 255 / 63),
+                (uint8_t)((c & 0x1F) * 255 / 31),
+            };
+            fwrite(rgb, 1, sizeof(rgb), f);
+        }
+    }
+    return fclose(f) == 0 ? ESP_OK : ESP_FAIL;
+}
+
+void mock_spi_set_cost(const mock_spi_cost_t *cost)
+{
+    if (cost != NULL) {
+        s_cost = *cost;
+    } else {
+        s_cost.transaction_ns = MOCK_SPI_TRANSACTION_NS;
+        s_cost.dc_toggle_ns = MOCK_SPI_DC_TOGGLE_NS;
+    }
+}
+
+void mock_spi_get_stats(mock_spi_stats_t *stats)
+{
+    *stats = s_spi;
+}
+
+void mock_spi_reset_stats(void)
+{
+    memset(&s_spi, 0, sizeof(s_spi));
+}
@@ -0,0 +1,140 @@
+/**
+ * @file nvs_mock.c
+ * @brief In-memory NVS for host builds
+ *
+ * One namespace's worth of keys in a static table: blobs and u32 values,
+ * erased when the process exits. Enough for save_manager.
+ */
+
+#include "nvs_flash.h"
+#include <stdbool.h>
+#include <string.h>
+
+//=============================================================================
+// Configuration
+//=============================================================================
+
+#define NVS_MOCK_KEYS       8
+#define NVS_MOCK_KEY_LEN    16      // NVS keys are at most 15 characters
+#define NVS_MOCK_BLOB_MAX   4608    // Largest blob (replay recording)
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+typedef struct {
+    bool used;
+    char key[NVS_MOCK_KEY_LEN];
+    size_t len;
+    uint8_t data[NVS_MOCK_BLOB_MAX];
+} nvs_entry_t;
+
+static nvs_entry_t s_entries[NVS_MOCK_KEYS];
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+static nvs_entry_t *find(const char *key)
+{
+    for (int i = 0; i < NVS_MOCK_KEYS; i++) {
+        if (s_entries[i].used && strcmp(s_entries[i].key, key) == 0) {
+            return &s_entries[i];
+        }
+    }
+    return NULL;
+}
+
+static esp_err_t store(const char *key, const void *value, size_t len)
+{
+    if (strlen(key) >= NVS_MOCK_KEY_LEN || len > NVS_MOCK_BLOB_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    nvs_entry_t *e = find(key);
+    for (int i = 0; e == NULL && i < NVS_MOCK_KEYS; i++) {
+        if (!s_entries[i].used) e = &s_entries[i];
+    }
+    if (e == NULL) return ESP_ERR_NVS_NO_FREE_PAGES;
+
+    e->used = true;
+    strcpy(e->key, key);
+    memcpy(e->data, value, len);
+    e->len = len;
+    return ESP_OK;
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+esp_err_t nvs_flash_init(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void)
+{
+    memset(s_entries, 0, sizeof(s_entries));
+    return ESP_OK;
+}
+
+esp_err_t nvs_open(const char *name, nvs_open_mode_t mode, nvs_handle_t *handle)
+{
+    (void)name;
+    (void)mode;
+    *handle = 1;
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length)
+{
+    (void)handle;
+    return store(key, value, length);
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out, size_t *length)
+{
+    (void)handle;
+    const nvs_entry_t *e = find(key);
+    if (e == NULL) return ESP_ERR_NVS_NOT_FOUND;
+
+    // NULL output: report the size only, like the real API
+    if (out != NULL) {
+        if (*length < e->len) return ESP_ERR_INVALID_SIZE;
+        memcpy(out, e->data, e->len);
+    }
+    *length = e->len;
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_u32(nvs_handle_t handle, const char *key, uint32_t value)
+{
+    (void)handle;
+    return store(key, &value, sizeof(value));
+}
+
+esp_err_t nvs_get_u32(nvs_handle_t handle, const char *key, uint32_t *out)
+{
+    (void)handle;
+    const nvs_entry_t *e = find(key);
+    if (e == NULL) return ESP_ERR_NVS_NOT_FOUND;
+    if (e->len != sizeof(*out)) return ESP_ERR_INVALID_ARG;
+    memcpy(out, e->data, sizeof(*out));
+    return ESP_OK;
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char *key)
+{
+    (void)handle;
+    nvs_entry_t *e = find(key);
+    if (e == NULL) return ESP_ERR_NVS_NOT_FOUND;
+    e->used = false;
+    return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle)
+{
+    (void)handle;
+    return ESP_OK;
+}
@@ -0,0 +1,12 @@
+/**
+ * @file esp_attr.h
+ * @brief ESP-IDF placement attributes for host builds (no effect)
+ */
+
+#ifndef ESP_ATTR_H
+#define ESP_ATTR_H
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+
+#endif // ESP_ATTR_H
@@ -0,0 +1,34 @@
+/**
+ * @file esp_log.h
+ * @brief ESP-IDF logging macros for host builds
+ *
+ * Errors and warnings go to stderr; info lines only with HOST_LOG_INFO
+ * (tools that show what the firmware logs, like the console). HOST_LOG_QUIET
+ * drops errors and warnings too, for tools that run the firmware code in
+ * bulk (the pet balance simulator would print every death).
+ */
+
+#ifndef ESP_LOG_H
+#define ESP_LOG_H
+
+#include <stdio.h>
+
+// Compiled out, but the arguments still count as used and are format-checked
+#define ESP_LOG_NONE_(tag, fmt, ...) \
+    do { (void)(tag); if (0) printf(fmt, ##__VA_ARGS__); } while (0)
+#if HOST_LOG_QUIET
+#define ESP_LOGE(tag, fmt, ...) ESP_LOG_NONE_(tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) ESP_LOG_NONE_(tag, fmt, ##__VA_ARGS__)
+#else
+#define ESP_LOGE(tag, fmt, ...) fprintf(stderr, "E %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) fprintf(stderr, "W %s: " fmt "\n", tag, ##__VA_ARGS__)
+#endif
+#if HOST_LOG_INFO
+#define ESP_LOGI(tag, fmt, ...) printf("I %s: " fmt "\n", tag, ##__VA_ARGS__)
+#else
+#define ESP_LOGI(tag, fmt, ...) ESP_LOG_NONE_(tag, fmt, ##__VA_ARGS__)
+#endif
+#define ESP_LOGD(tag, fmt, ...) ESP_LOG_NONE_(tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGV(tag, fmt, ...) ESP_LOG_NONE_(tag, fmt, ##__VA_ARGS__)
+
+#endif // ESP_LOG_H
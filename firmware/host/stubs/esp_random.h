@@ -0,0 +1,13 @@
+/**
+ * @file esp_random.h
+ * @brief ESP-IDF hardware RNG for host builds (fixed sequence, see mocks/esp_mock.c)
+ */
+
+#ifndef ESP_RANDOM_H
+#define ESP_RANDOM_H
+
+#include <stdint.h>
+
+uint32_t esp_random(void);
+
+#endif // ESP_RANDOM_H
@@ -0,0 +1,13 @@
+/**
+ * @file esp_timer.h
+ * @brief ESP-IDF microsecond clock for host builds (see mocks/esp_mock.c)
+ */
+
+#ifndef ESP_TIMER_H
+#define ESP_TIMER_H
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void);
+
+#endif // ESP_TIMER_H
@@ -0,0 +1,22 @@
+/**
+ * @file FreeRTOS.h
+ * @brief FreeRTOS types for host builds (single-threaded, see mocks/esp_mock.c)
+ */
+
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+#include <stdint.h>
+#include "esp_attr.h"
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(ms))
+#define portTICK_PERIOD_MS  1
+#define portMAX_DELAY       UINT32_MAX
+#define pdTRUE              1
+#define pdFALSE             0
+
+#endif // FREERTOS_H
@@ -0,0 +1,13 @@
+/**
+ * @file task.h
+ * @brief FreeRTOS task delays for host builds (see mocks/esp_mock.c)
+ */
+
+#ifndef TASK_H
+#define TASK_H
+
+#include "FreeRTOS.h"
+
+void vTaskDelay(TickType_t ticks);
+
+#endif // TASK_H
@@ -0,0 +1,14 @@
+/**
+ * @file nvs_flash.h
+ * @brief ESP-IDF NVS partition setup for host builds (see mocks/nvs_mock.c)
+ */
+
+#ifndef NVS_FLASH_H
+#define NVS_FLASH_H
+
+#include "nvs.h"
+
+esp_err_t nvs_flash_init(void);
+esp_err_t nvs_flash_erase(void);
+
+#endif // NVS_FLASH_H
@@ -0,0 +1,691 @@
+/**
+ * @file golden_tests.c
+ * @brief Golden-image regression tests for every game screen
+ *
+ * REQ-SW-057: Golden-image Tests
+ * Plays a fixed script through every reachable game state and both
+ * mini-games (playing, round won, round lost, result screens) with a
+ * fixed seed on the virtual clock. Named screens are compared with the
+ * stored images in this directory, and every frame's panel checksum
+ * with frames.txt, so a renderer change has to be pixel-identical at
+ * every frame, not just at the checkpoints.
+ *
+ * The script runs once per render mode. The goldens are recorded in
+ * framebuffer mode; immediate and banded must produce the same panel.
+ *   golden_tests                 compare, report into ./golden_diff
+ *   golden_tests --update        re-record after an intended change
+ *   golden_tests --mode banded   one mode only
+ * A differing screen leaves <name>.actual.ppm and <name>.diff.ppm
+ * (changed pixels red on a dimmed golden) in the report directory.
+ * GAME_STATE_NEW_GAME has no input leading to it and is not covered.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include "host_game.h"
+#include "host_mocks.h"
+#include "display.h"
+#include "game.h"
+#include "minigame.h"
+#include "pet.h"
+#include "save_manager.h"
+#include "sim.h"
+#include "esp_rom_crc.h"
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define SEED                2024
+#define FRAMES_MAX          8192
+#define PATH_MAX_LEN        512
+#define LINE_MAX_LEN        64
+#define PANEL_PIXELS        (MOCK_LCD_WIDTH * MOCK_LCD_HEIGHT)
+#define PPM_BYTES           (PANEL_PIXELS * 3)
+
+#define CHORD_HOLD_MS       120
+#define LONG_PRESS_MS       2200
+#define DOUBLE_GAP_MS       120
+#define WAIT_MAX_MS         60000
+
+// Result overlay text of both mini-games (size 2, y 50)
+#define OVERLAY_X           70
+#define OVERLAY_Y           50
+#define OVERLAY_W           80
+#define OVERLAY_H           16
+#define OVERLAY_MIN_PIXELS  20
+#define COLOR_OVERLAY_WIN   0x07E0
+#define COLOR_OVERLAY_FAIL  0xF800
+
+// Jumps that clear the first round of Jump the Wave after the reboot,
+// ms after the game starts
+static const uint32_t s_wave_jumps[] = { 462, 2460, 4077 };
+
+//=============================================================================
+// Types
+//=============================================================================
+
+typedef struct {
+    const char *name;           // Golden image <name>.ppm
+    game_state_t state;         // State the step must end in
+    void (*run)(void);
+} golden_step_t;
+
+typedef struct {
+    uint32_t crc;
+    uint8_t state;
+} frame_record_t;
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+static frame_record_t s_frames[FRAMES_MAX];
+static uint32_t s_frame_count;
+static uint32_t s_frame_base;           // Frames of earlier boots in this run
+static bool s_visited[GAME_STATE_COUNT];
+
+static uint8_t s_actual[PPM_BYTES];
+static uint8_t s_golden[PPM_BYTES];
+
+static const char *s_mode_names[DISPLAY_RENDER_COUNT] = {
+    [DISPLAY_RENDER_IMMEDIATE] = "immediate",
+    [DISPLAY_RENDER_FRAMEBUFFER] = "framebuffer",
+    [DISPLAY_RENDER_BANDED] = "banded",
+};
+
+static display_render_mode_t s_mode;
+static bool s_step_failed;
+
+//=============================================================================
+// Script Helpers
+//=============================================================================
+
+static void on_frame(uint32_t frame)
+{
+    uint32_t n = s_frame_base + frame;
+    if (n > FRAMES_MAX) return;
+
+    game_state_t state = game_get_state();
+    s_frames[n - 1].crc = esp_rom_crc32_le(0, (const uint8_t *)mock_lcd_pixels(),
+                                           PANEL_PIXELS * sizeof(uint16_t));
+    s_frames[n - 1].state = (uint8_t)state;
+    s_visited[state] = true;
+    if (n > s_frame_count) s_frame_count = n;
+}
+
+static void boot(bool keep_save)
+{
+    host_game_config_t config = { .seed = SEED, .assets = HOST_ASSET_PACK, .keep_save = keep_save };
+
+    s_frame_base = s_frame_count;
+    if (host_game_boot(&config) != ESP_OK || display_set_render_mode(s_mode) != ESP_OK) {
+        fprintf(stderr, "boot failed\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void click(button_id_t button)
+{
+    host_game_click(button);
+}
+
+static void clicks(button_id_t button, int n)
+{
+    for (int i = 0; i < n; i++) {
+        click(button);
+    }
+}
+
+static void double_click(button_id_t button)
+{
+    host_game_press(button, 0, 60);
+    host_game_press(button, 60 + DOUBLE_GAP_MS, 60);
+    host_game_run_ms(800);
+}
+
+static void chord(void)
+{
+    host_game_press(BUTTON_LEFT, 0, CHORD_HOLD_MS);
+    host_game_press(BUTTON_RIGHT, 10, CHORD_HOLD_MS);
+    host_game_run_ms(600);
+}
+
+static void long_press(button_id_t button)
+{
+    host_game_press(button, 0, LONG_PRESS_MS);
+    host_game_run_ms(LONG_PRESS_MS + 600);
+}
+
+static bool state_is(int state)
+{
+    return game_get_state() == (game_state_t)state;
+}
+
+/**
+ * @brief Result overlay of a mini-game ("NICE!", "OOPS!", "YUMMY!") in
+ *        the given colour across the middle of the screen
+ */
+static bool overlay_shown(int color)
+{
+    int n = 0;
+    for (int y = OVERLAY_Y; y < OVERLAY_Y + OVERLAY_H; y++) {
+        for (int x = OVERLAY_X; x < OVERLAY_X + OVERLAY_W; x++) {
+            if (mock_lcd_pixel(x, y) == (uint16_t)color) n++;
+        }
+    }
+    return n >= OVERLAY_MIN_PIXELS;
+}
+
+/**
+ * @brief Run until cond(arg) holds; fails the step after WAIT_MAX_MS
+ */
+static void wait_for(bool (*cond)(int), int arg)
+{
+    for (uint32_t waited = 0; !cond(arg); waited += SIM_TICK_MS) {
+        if (waited >= WAIT_MAX_MS) {
+            s_step_failed = true;
+            return;
+        }
+        host_game_tick();
+    }
+}
+
+//=============================================================================
+// Script
+//=============================================================================
+
+// Start screen, then a fresh egg
+
+static void step_splash(void)
+{
+    boot(false);
+    host_game_run_ms(500);
+}
+
+static void step_main_egg(void)
+{
+    click(BUTTON_RIGHT);
+    host_game_run_ms(1000);
+}
+
+// A hatched pet in need of care, restored from the save like after a reboot
+
+static void step_main_baby(void)
+{
+    pet_state_t *pet = pet_get_state_mutable();
+    pet->stage = PET_STAGE_BABY;
+    pet->age_minutes = 600;
+    pet->hunger = 15;
+    pet->happiness = 35;
+    pet->energy = 80;
+    pet->has_poop = true;
+    pet->poop_count = 1;
+    save_manager_save();
+
+    boot(true);
+    host_game_run_ms(1000);
+}
+
+static void step_stats(void)
+{
+    chord();
+}
+
+static void step_stats_next(void)
+{
+    click(BUTTON_LEFT);
+}
+
+// Menu and food picker
+
+static void step_menu(void)
+{
+    click(BUTTON_RIGHT);        // Stats back to main
+    click(BUTTON_LEFT);
+}
+
+static void step_menu_medicine(void)
+{
+    clicks(BUTTON_LEFT, MENU_MEDICINE);
+}
+
+static void step_feed(void)
+{
+    clicks(BUTTON_LEFT, MENU_COUNT - MENU_MEDICINE);
+    click(BUTTON_RIGHT);
+}
+
+static void step_feed_back(void)
+{
+    clicks(BUTTON_LEFT, FOOD_MENU_BACK);
+}
+
+static void step_fed(void)
+{
+    click(BUTTON_LEFT);         // Wraps to fish
+    click(BUTTON_RIGHT);
+    host_game_run_ms(1000);
+}
+
+static void step_cleaned(void)
+{
+    double_click(BUTTON_LEFT);
+    host_game_run_ms(500);
+}
+
+// Jump the Wave: a session without jumping, then a round won after a
+// reboot so the obstacles depend only on what follows it
+
+static void open_games(void)
+{
+    click(BUTTON_LEFT);
+    clicks(BUTTON_LEFT, MENU_PLAY);
+    click(BUTTON_RIGHT);
+}
+
+static void step_games(void)
+{
+    open_games();
+}
+
+static void step_wave_playing(void)
+{
+    click(BUTTON_RIGHT);
+    host_game_run_ms(300);
+}
+
+static void step_wave_fail(void)
+{
+    wait_for(overlay_shown, COLOR_OVERLAY_FAIL);
+}
+
+static void step_wave_results(void)
+{
+    wait_for(state_is, GAME_STATE_RESULTS);
+}
+
+static void step_wave_success(void)
+{
+    click(BUTTON_RIGHT);        // Results back to main
+    boot(true);
+    host_game_run_ms(500);
+    open_games();
+    click(BUTTON_RIGHT);
+    for (size_t i = 0; i < sizeof(s_wave_jumps) / sizeof(s_wave_jumps[0]); i++) {
+        host_game_press(BUTTON_RIGHT, s_wave_jumps[i], 60);
+    }
+    wait_for(overlay_shown, COLOR_OVERLAY_WIN);
+}
+
+// Catch the Fish: swim a little, then let the fish drop
+
+static void step_catch_playing(void)
+{
+    wait_for(state_is, GAME_STATE_RESULTS);
+    click(BUTTON_RIGHT);        // Results back to main
+    open_games();
+    clicks(BUTTON_LEFT, MINIGAME_CATCH - MINIGAME_WAVE);
+    click(BUTTON_RIGHT);
+    host_game_press(BUTTON_LEFT, 200, 500);
+    host_game_run_ms(1000);
+}
+
+static void step_catch_done(void)
+{
+    wait_for(overlay_shown, COLOR_OVERLAY_FAIL);
+}
+
+static void step_catch_results(void)
+{
+    wait_for(state_is, GAME_STATE_RESULTS);
+}
+
+// Settings, sleep, death
+
+static void step_settings(void)
+{
+    click(BUTTON_RIGHT);        // Results back to main
+    click(BUTTON_LEFT);
+    clicks(BUTTON_LEFT, MENU_SETTINGS);
+    click(BUTTON_RIGHT);
+}
+
+static void step_settings_brightness(void)
+{
+    click(BUTTON_RIGHT);        // First item: brightness
+}
+
+static void step_sleep(void)
+{
+    long_press(BUTTON_LEFT);    // Back to the menu, selection kept
+    clicks(BUTTON_LEFT, MENU_COUNT - MENU_SETTINGS + MENU_SLEEP);
+    click(BUTTON_RIGHT);
+    host_game_run_ms(1000);
+}
+
+static void step_awake(void)
+{
+    click(BUTTON_RIGHT);
+    host_game_run_ms(500);
+}
+
+static void step_death(void)
+{
+    pet_get_state_mutable()->stage = PET_STAGE_DEAD;
+    host_game_run_ms(1000);
+}
+
+static void step_new_pet(void)
+{
+    click(BUTTON_RIGHT);
+    host_game_run_ms(500);
+}
+
+static const golden_step_t s_steps[] = {
+    { "splash",              GAME_STATE_SPLASH,   step_splash },
+    { "main_egg",            GAME_STATE_MAIN,     step_main_egg },
+    { "main_baby",           GAME_STATE_MAIN,     step_main_baby },
+    { "stats",               GAME_STATE_STATS,    step_stats },
+    { "stats_next",          GAME_STATE_STATS,    step_stats_next },
+    { "menu",                GAME_STATE_MENU,     step_menu },
+    { "menu_medicine",       GAME_STATE_MENU,     step_menu_medicine },
+    { "feed",                GAME_STATE_FEED,     step_feed },
+    { "feed_back",           GAME_STATE_FEED,     step_feed_back },
+    { "main_fed",            GAME_STATE_MAIN,     step_fed },
+    { "main_cleaned",        GAME_STATE_MAIN,     step_cleaned },
+    { "games",               GAME_STATE_GAMES,    step_games },
+    { "wave_playing",        GAME_STATE_PLAY,     step_wave_playing },
+    { "wave_fail",           GAME_STATE_PLAY,     step_wave_fail },
+    { "wave_results",        GAME_STATE_RESULTS,  step_wave_results },
+    { "wave_success",        GAME_STATE_PLAY,     step_wave_success },
+    { "catch_playing",       GAME_STATE_PLAY,     step_catch_playing },
+    { "catch_done",          GAME_STATE_PLAY,     step_catch_done },
+    { "catch_results",       GAME_STATE_RESULTS,  step_catch_results },
+    { "settings",            GAME_STATE_SETTINGS, step_settings },
+    { "settings_brightness", GAME_STATE_SETTINGS, step_settings_brightness },
+    { "sleep",               GAME_STATE_SLEEP,    step_sleep },
+    { "main_awake",          GAME_STATE_MAIN,     step_awake },
+    { "death",               GAME_STATE_DEATH,    step_death },
+    { "main_new_pet",        GAME_STATE_MAIN,     step_new_pet },
+};
+
+#define STEP_COUNT (sizeof(s_steps) / sizeof(s_steps[0]))
+
+//=============================================================================
+// Images
+//=============================================================================
+
+static void panel_rgb(uint8_t *rgb)
+{
+    // Same conversion as mock_lcd_write_ppm()
+    const uint16_t *px = mock_lcd_pixels();
+    for (int i = 0; i < PANEL_PIXELS; i++) {
+        rgb[i * 3 + 0] = (uint8_t)((px[i] >> 11) * 255 / 31);
+        rgb[i * 3 + 1] = (uint8_t)(((px[i] >> 5) & 0x3F) * 255 / 63);
+        rgb[i * 3 + 2] = (uint8_t)((px[i] & 0x1F) * 255 / 31);
+    }
+}
+
+static esp_err_t write_ppm(const char *path, const uint8_t *rgb)
+{
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) return ESP_FAIL;
+
+    fprintf(f, "P6\n%d %d\n255\n", MOCK_LCD_WIDTH, MOCK_LCD_HEIGHT);
+    fwrite(rgb, 1, PPM_BYTES, f);
+    return fclose(f) == 0 ? ESP_OK : ESP_FAIL;
+}
+
+static esp_err_t read_ppm(const char *path, uint8_t *rgb)
+{
+    int w, h, max;
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) return ESP_ERR_NOT_FOUND;
+
+    esp_err_t ret = ESP_ERR_INVALID_SIZE;
+    if (fscanf(f, "P6 %d %d %d", &w, &h, &max) == 3 && fgetc(f) != EOF &&
+        w == MOCK_LCD_WIDTH && h == MOCK_LCD_HEIGHT && max == 255 &&
+        fread(rgb, 1, PPM_BYTES, f) == PPM_BYTES) {
+        ret = ESP_OK;
+    }
+    fclose(f);
+    return ret;
+}
+
+/**
+ * @brief Compare the panel with a golden image, write the report images
+ * @return Differing pixels, -1 if the golden cannot be read
+ */
+static int compare_screen(const char *name, const char *golden_dir, const char *out_dir)
+{
+    char path[PATH_MAX_LEN];
+    int x0 = MOCK_LCD_WIDTH, y0 = MOCK_LCD_HEIGHT, x1 = -1, y1 = -1;
+    int diff = 0;
+
+    snprintf(path, sizeof(path), "%s/%s.ppm", golden_dir, name);
+    if (read_ppm(path, s_golden) != ESP_OK) {
+        printf("  %-20s missing golden %s\n", name, path);
+        diff = -1;
+    } else {
+        for (int i = 0; i < PANEL_PIXELS; i++) {
+            if (memcmp(&s_actual[i * 3], &s_golden[i * 3], 3) == 0) continue;
+            int x = i % MOCK_LCD_WIDTH, y = i / MOCK_LCD_WIDTH;
+            if (x < x0) x0 = x;
+            if (x > x1) x1 = x;
+            if (y < y0) y0 = y;
+            if (y > y1) y1 = y;
+            diff++;
+        }
+        if (diff == 0) return 0;
+        printf("  %-20s %d pixels differ in (%d,%d)-(%d,%d)\n", name, diff, x0, y0, x1, y1);
+    }
+
+    snprintf(path, sizeof(path), "%s/%s.actual.ppm", out_dir, name);
+    write_ppm(path, s_actual);
+    if (diff > 0) {
+        // Changed pixels red on the golden at a quarter brightness
+        for (int i = 0; i < PANEL_PIXELS; i++) {
+            bool changed = memcmp(&s_actual[i * 3], &s_golden[i * 3], 3) != 0;
+            for (int c = 0; c < 3; c++) {
+                s_golden[i * 3 + c] = changed ? (c == 0 ? 255 : 0) : s_golden[i * 3 + c] / 4;
+            }
+        }
+        snprintf(path, sizeof(path), "%s/%s.diff.ppm", out_dir, name);
+        write_ppm(path, s_golden);
+    }
+    return diff;
+}
+
+//=============================================================================
+// Frame Log
+//=============================================================================
+
+static esp_err_t write_frames(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (f == NULL) return ESP_FAIL;
+
+    for (uint32_t i = 0; i < s_frame_count; i++) {
+        fprintf(f, "%lu %s %08lx\n", (unsigned long)(i + 1),
+                game_state_name((game_state_t)s_frames[i].state), (unsigned long)s_frames[i].crc);
+    }
+    return fclose(f) == 0 ? ESP_OK : ESP_FAIL;
+}
+
+/**
+ * @brief Compare this run's frame checksums with the golden log
+ * @return Differing frames (extra or missing ones included), -1 if unreadable
+ */
+static int compare_frames(const char *path)
+{
+    char line[LINE_MAX_LEN];
+    char state[LINE_MAX_LEN];
+    unsigned long n, crc;
+    uint32_t count = 0;
+    int diff = 0;
+
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        printf("  missing frame log %s\n", path);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (sscanf(line, "%lu %63s %lx", &n, state, &crc) != 3) continue;
+        count++;
+        if (n > s_frame_count) {
+            diff++;
+            continue;
+        }
+        if (s_frames[n - 1].crc != crc) {
+            if (diff == 0) {
+                printf("  first differing frame %lu (%s, golden state %s)\n", n,
+                       game_state_name((game_state_t)s_frames[n - 1].state), state);
+            }
+            diff++;
+        }
+    }
+    fclose(f);
+
+    if (count != s_frame_count) {
+        printf("  %lu frames, golden log has %lu\n",
+               (unsigned long)s_frame_count, (unsigned long)count);
+        if (s_frame_count > count) diff += (int)(s_frame_count - count);
+    }
+    return diff;
+}
+
+//=============================================================================
+// Runner
+//=============================================================================
+
+/**
+ * @brief Play the script in one render mode
+ * @param update Record the goldens from this run
+ * @return Failures (differing screens and frames, wrong states)
+ */
+static int run_script(const char *golden_dir, const char *out_dir, bool update)
+{
+    char path[PATH_MAX_LEN];
+    int failures = 0;
+    int screens = 0;
+
+    s_frame_count = 0;
+    memset(s_visited, 0, sizeof(s_visited));
+
+    for (size_t i = 0; i < STEP_COUNT; i++) {
+        const golden_step_t *step = &s_steps[i];
+        s_step_failed = false;
+        step->run();
+        if (s_step_failed || game_get_state() != step->state) {
+            printf("  %-20s ended in %s, expected %s\n", step->name,
+                   game_state_name(game_get_state()), game_state_name(step->state));
+            failures++;
+        }
+
+        panel_rgb(s_actual);
+        if (update) {
+            snprintf(path, sizeof(path), "%s/%s.ppm", golden_dir, step->name);
+            if (write_ppm(path, s_actual) != ESP_OK) {
+                printf("  cannot write %s\n", path);
+                failures++;
+            }
+        } else if (compare_screen(step->name, golden_dir, out_dir) != 0) {
+            failures++;
+            screens++;
+        }
+    }
+
+    if (s_frame_count >= FRAMES_MAX) {
+        printf("  more than %d frames, raise FRAMES_MAX\n", FRAMES_MAX);
+        failures++;
+    }
+    snprintf(path, sizeof(path), "%s/frames.txt", golden_dir);
+    if (update) {
+        if (write_frames(path) != ESP_OK) failures++;
+    } else {
+        int frames = compare_frames(path);
+        if (frames != 0) {
+            printf("  %d of %lu frames differ\n", frames, (unsigned long)s_frame_count);
+            failures++;
+        }
+    }
+
+    for (int st = 0; st < GAME_STATE_COUNT; st++) {
+        if (!s_visited[st] && st != GAME_STATE_NEW_GAME) {
+            printf("  state %s never shown\n", game_state_name((game_state_t)st));
+            failures++;
+        }
+    }
+
+    printf("%s: %lu frames, %d screens, %d differ%s\n", s_mode_names[s_mode],
+           (unsigned long)s_frame_count, (int)STEP_COUNT, screens, update ? " (recorded)" : "");
+    return failures;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [--update] [--mode immediate|framebuffer|banded]\n"
+                    "          [--golden DIR] [--out DIR]\n", prog);
+}
+
+//=============================================================================
+// Main
+//=============================================================================
+
+int main(int argc, char **argv)
+{
+    const char *golden_dir = GOLDEN_DIR;
+    const char *out_dir = "golden_diff";
+    bool update = false;
+    int only = -1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--update") == 0) {
+            update = true;
+        } else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+            golden_dir = argv[++i];
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_dir = argv[++i];
+        } else if (strcmp(argv[i], "--mode") == 0 && i + 1 < argc) {
+            i++;
+            for (only = 0; only < DISPLAY_RENDER_COUNT && strcmp(argv[i], s_mode_names[only]) != 0; only++) {}
+            if (only == DISPLAY_RENDER_COUNT) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        } else {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (mkdir(out_dir, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "cannot create %s\n", out_dir);
+        return EXIT_FAILURE;
+    }
+
+    // Framebuffer first: it records the goldens the other modes must match
+    static const display_render_mode_t order[] = {
+        DISPLAY_RENDER_FRAMEBUFFER, DISPLAY_RENDER_IMMEDIATE, DISPLAY_RENDER_BANDED,
+    };
+    int failures = 0;
+    bool recorded = false;
+
+    host_game_set_frame_hook(on_frame);
+    for (size_t i = 0; i < sizeof(order) / sizeof(order[0]); i++) {
+        if (only >= 0 && order[i] != (display_render_mode_t)only) continue;
+        s_mode = order[i];
+        failures += run_script(golden_dir, out_dir, update && !recorded);
+        recorded = true;
+    }
+
+    if (failures != 0) {
+        printf("FAIL: %d differences, report in %s\n", failures, out_dir);
+        return EXIT_FAILURE;
+    }
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file heap_guard.c
+ * @brief Heap allocation guard for host tests
+ *
+ * REQ-SW-039: Static Memory Budget
+ */
+
+#include "heap_guard.h"
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+static bool s_armed = false;
+static const char *s_what = NULL;
+static uint32_t s_count = 0;
+static size_t s_first_size = 0;
+static const char *s_first_fn = NULL;
+
+static void note(const char *fn, size_t size)
+{
+    if (!s_armed) return;
+    if (s_count++ == 0) {
+        s_first_fn = fn;
+        s_first_size = size;
+    }
+}
+
+void *__wrap_malloc(size_t size)
+{
+    note("malloc", size);
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t n, size_t size)
+{
+    note("calloc", n * size);
+    return __real_calloc(n, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    note("realloc", size);
+    return __real_realloc(ptr, size);
+}
+
+void heap_guard_arm(const char *what)
+{
+    s_what = what;
+    s_count = 0;
+    s_armed = true;
+}
+
+uint32_t heap_guard_disarm(void)
+{
+    s_armed = false;
+    if (s_count) {
+        printf("%s: %u allocations, first %s(%zu)\n", s_what, s_count, s_first_fn, s_first_size);
+    }
+    return s_count;
+}
@@ -0,0 +1,29 @@
+/**
+ * @file heap_guard.h
+ * @brief Heap allocation guard for host tests
+ *
+ * REQ-SW-039: Static Memory Budget
+ * Tests linked with heap_guard.c and
+ * -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc count every allocation
+ * made by firmware code while the guard is armed. The C library's own
+ * internal allocations (stdio buffers) are not wrapped and not counted.
+ */
+
+#ifndef HEAP_GUARD_H
+#define HEAP_GUARD_H
+
+#include <stdint.h>
+
+/**
+ * @brief Start counting allocations
+ * @param what Code path being guarded (for the failure message)
+ */
+void heap_guard_arm(const char *what);
+
+/**
+ * @brief Stop counting; prints the path and size of the first allocation
+ * @return Allocations seen while armed (0: the path is heap-free)
+ */
+uint32_t heap_guard_disarm(void);
+
+#endif // HEAP_GUARD_H
@@ -0,0 +1,221 @@
+/**
+ * @file hot_path_alloc.c
+ * @brief Host test: the per-frame code paths never touch the heap
+ *
+ * REQ-SW-039: Static Memory Budget
+ * Sets every module up outside the guard, then runs what the firmware
+ * does every sim tick or frame under heap_guard for many iterations:
+ * pet simulation and snapshot publishing, input recording, obstacle
+ * physics with pixel collision, telemetry recording and the SPSC queue.
+ * Then boots the whole game like golden_tests and plays it under the
+ * guard through scripted buttons: the main screen, the menu, a round of
+ * each mini-game and its results screen, rendered to the mocked panel.
+ * Fails if any of them allocates, or if the guard itself does not see
+ * a deliberate allocation (wrapping not linked in).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "heap_guard.h"
+#include "host_game.h"
+#include "game.h"
+#include "minigame.h"
+#include "pet.h"
+#include "sim.h"
+#include "replay.h"
+#include "telemetry.h"
+#include "obstacles.h"
+#include "sprite_mask.h"
+#include "spsc_queue.h"
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define TICKS               100000  // ~55 minutes of sim time
+#define GROUND_Y            95
+#define GAME_SEED           4242
+#define MAIN_RUN_MS         (10 * 60 * 1000)
+#define ROUND_MAX_MS        (5 * 60 * 1000)
+#define JUMP_EVERY_MS       700
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+static uint32_t test_random(void)
+{
+    return sim_random();
+}
+
+static bool run_pet(void)
+{
+    pet_state_t copy;
+
+    heap_guard_arm("pet tick");
+    for (int i = 0; i < TICKS; i++) {
+        sim_step();
+        pet_update(SIM_TICK_MS);
+        pet_publish_snapshot();
+        pet_get_snapshot(&copy);
+    }
+    return heap_guard_disarm() == 0;
+}
+
+static bool run_replay(void)
+{
+    size_t len;
+
+    replay_record_start();
+    heap_guard_arm("replay recording");
+    for (int i = 0; i < REPLAY_MAX_EVENTS + 16; i++) {
+        sim_step();
+        replay_record_event((button_id_t)(i & 1), BUTTON_EVENT_CLICK);
+    }
+    replay_get_data(&len);
+    return heap_guard_disarm() == 0;
+}
+
+static bool run_obstacles(void)
+{
+    static obstacle_pool_t pool;
+    obstacle_spawner_t spawner;
+    uint8_t near[OBSTACLE_MAX];
+    const sprite_mask_t *dolphin = sprite_mask_get(SPRITE_ASSET_BABY_IDLE_1);
+    uint32_t hits = 0;
+
+    obstacles_reset(&pool);
+    obstacles_spawner_init(&spawner, 2, 255, GROUND_Y, 3 << OBSTACLE_FP_SHIFT, test_random);
+
+    heap_guard_arm("obstacles");
+    for (int i = 0; i < TICKS; i++) {
+        obstacles_spawner_step(&spawner, &pool, 248);
+        obstacles_step(&pool, 0);
+        int n = obstacles_query(&pool, 30, 62, near, OBSTACLE_MAX);
+        for (int k = 0; k < n; k++) {
+            int j = near[k];
+            const sprite_mask_t *mask = sprite_mask_get(SPRITE_ASSET_MG_ROCK);
+            hits += sprite_mask_overlap(dolphin, 30, GROUND_Y - 24 - i % 64,
+                                        mask, pool.x[j] >> OBSTACLE_FP_SHIFT, pool.y[j]);
+        }
+        if (obstacles_spawner_done(&spawner)) spawner.patterns_left = 255;
+    }
+    printf("obstacles: %u hits\n", hits);
+    return heap_guard_disarm() == 0;
+}
+
+static bool run_telemetry(void)
+{
+    telemetry_summary_t sum;
+
+    telemetry_init(NULL);
+    heap_guard_arm("telemetry");
+    for (int i = 0; i < TICKS; i++) {
+        int state = i % TELEMETRY_MAX_STATES;
+        telemetry_record(state, TELEMETRY_FRAME, 33000 + i % 5000);
+        telemetry_record(state, TELEMETRY_SIM, 800 + i % 300);
+        if (i % 97 == 0) telemetry_missed(state);
+    }
+    telemetry_get_summary(0, TELEMETRY_FRAME, &sum);
+    return heap_guard_disarm() == 0;
+}
+
+SPSC_QUEUE_DEFINE(s_queue, uint32_t, 8);
+
+static bool run_queue(void)
+{
+    uint32_t item;
+
+    heap_guard_arm("spsc queue");
+    for (uint32_t i = 0; i < TICKS; i++) {
+        spsc_push(&s_queue, &i);
+        if (i & 1) spsc_pop(&s_queue, &item);
+    }
+    while (spsc_pop(&s_queue, &item)) {
+    }
+    return heap_guard_disarm() == 0;
+}
+
+static void clicks(button_id_t button, int n)
+{
+    for (int i = 0; i < n; i++) {
+        host_game_click(button);
+    }
+}
+
+/**
+ * @brief Menu, games picker, then a round of a mini-game to its results
+ */
+static bool play_round(minigame_id_t id)
+{
+    host_game_click(BUTTON_LEFT);
+    clicks(BUTTON_LEFT, MENU_PLAY);
+    host_game_click(BUTTON_RIGHT);
+    clicks(BUTTON_LEFT, (id - minigame_current() + MINIGAME_COUNT) % MINIGAME_COUNT);
+    host_game_click(BUTTON_RIGHT);
+    if (game_get_state() != GAME_STATE_PLAY) return false;
+
+    for (uint32_t ms = 0; game_get_state() == GAME_STATE_PLAY; ms += JUMP_EVERY_MS) {
+        if (ms >= ROUND_MAX_MS) return false;
+        host_game_press((ms / JUMP_EVERY_MS) & 1 ? BUTTON_RIGHT : BUTTON_LEFT, 0, 60);
+        host_game_run_ms(JUMP_EVERY_MS);
+    }
+    if (game_get_state() != GAME_STATE_RESULTS) return false;
+    host_game_run_ms(1000);
+    host_game_click(BUTTON_RIGHT);
+    return game_get_state() == GAME_STATE_MAIN;
+}
+
+static bool run_game(void)
+{
+    host_game_config_t config = { .seed = GAME_SEED, .assets = HOST_ASSET_PACK };
+
+    // Boot and a hatched pet (eggs cannot play) outside the guard
+    if (host_game_boot(&config) != ESP_OK) return false;
+    host_game_run_ms(500);
+    host_game_click(BUTTON_RIGHT);
+    pet_get_state_mutable()->stage = PET_STAGE_BABY;
+
+    heap_guard_arm("game screens and mini-games");
+    host_game_run_ms(MAIN_RUN_MS);
+    bool played = play_round(MINIGAME_WAVE) && play_round(MINIGAME_CATCH);
+    host_game_run_ms(1000);
+    uint32_t allocs = heap_guard_disarm();
+
+    printf("game: %u frames\n", host_game_frames());
+    if (!played) printf("game: script lost its way in %s\n", game_state_name(game_get_state()));
+    return played && allocs == 0;
+}
+
+//=============================================================================
+// Main
+//=============================================================================
+
+int main(void)
+{
+    // The guard must see an allocation, or every check below is vacuous
+    void *volatile probe;
+    heap_guard_arm("self test (expects 1)");
+    probe = malloc(16);
+    free(probe);
+    if (heap_guard_disarm() != 1) {
+        printf("FAIL: allocations are not being counted (link with --wrap=malloc)\n");
+        return EXIT_FAILURE;
+    }
+
+    sim_init(12345);
+    pet_init();
+    pet_new();
+    pet_publish_snapshot();
+
+    bool ok = true;
+    ok &= run_pet();
+    ok &= run_replay();
+    ok &= run_obstacles();
+    ok &= run_telemetry();
+    ok &= run_queue();
+    ok &= run_game();
+
+    printf("%s\n", ok ? "PASS: no heap allocation on the hot paths" : "FAIL");
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file snapshot_stress.c
+ * @brief Host stress test for pet state snapshot publishing
+ *
+ * REQ-SW-038: Pet State Snapshots
+ * One writer thread plays the simulation task: it changes the live pet
+ * state so that every field follows from one counter, then publishes it,
+ * back to back with no pause (far more often than the firmware's once
+ * per sim tick). Reader threads play the render and persistence tasks
+ * and check every copy they get: all fields from the same counter (no
+ * torn read) and the counter never going backwards. Reports reads,
+ * retries and the worst retry count; fails on any inconsistent copy.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "pet.h"
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define READERS             3
+#define PUBLISHES           2000000
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+static atomic_bool s_done;
+
+typedef struct {
+    pthread_t thread;
+    uint32_t reads;
+    uint32_t torn;              // Fields from different publishes
+    uint32_t backwards;         // Older than a copy read before
+} reader_t;
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+/**
+ * @brief Fill every field the test checks from one counter
+ */
+static void fill_state(pet_state_t *pet, uint32_t k)
+{
+    pet->hunger = (uint8_t)k;
+    pet->happiness = (uint8_t)(k >> 8);
+    pet->health = (uint8_t)(k >> 16);
+    pet->energy = (uint8_t)(k >> 24);
+    pet->age_minutes = k;
+    pet->last_update_ms = ~k;
+    pet->last_fed_ms = k * 3;
+    pet->sleep_start_ms = k ^ 0xA5A5A5A5u;
+}
+
+static bool state_consistent(const pet_state_t *pet)
+{
+    uint32_t k = pet->age_minutes;
+    return pet->hunger == (uint8_t)k &&
+           pet->happiness == (uint8_t)(k >> 8) &&
+           pet->health == (uint8_t)(k >> 16) &&
+           pet->energy == (uint8_t)(k >> 24) &&
+           pet->last_update_ms == ~k &&
+           pet->last_fed_ms == k * 3 &&
+           pet->sleep_start_ms == (k ^ 0xA5A5A5A5u);
+}
+
+static void *writer_main(void *arg)
+{
+    (void)arg;
+    pet_state_t *pet = pet_get_state_mutable();
+    for (uint32_t k = 1; k <= PUBLISHES; k++) {
+        fill_state(pet, k);
+        pet_publish_snapshot();
+    }
+    atomic_store(&s_done, true);
+    return NULL;
+}
+
+static void *reader_main(void *arg)
+{
+    reader_t *reader = arg;
+    uint32_t last = 0;
+    pet_state_t pet;
+
+    while (!atomic_load_explicit(&s_done, memory_order_relaxed)) {
+        pet_get_snapshot(&pet);
+        reader->reads++;
+        if (!state_consistent(&pet)) {
+            reader->torn++;
+        } else if (pet.age_minutes < last) {
+            reader->backwards++;
+        } else {
+            last = pet.age_minutes;
+        }
+    }
+    return NULL;
+}
+
+//=============================================================================
+// Main
+//=============================================================================
+
+int main(void)
+{
+    reader_t readers[READERS] = {0};
+    pthread_t writer;
+
+    fill_state(pet_get_state_mutable(), 0);
+    pet_publish_snapshot();
+
+    for (int i = 0; i < READERS; i++) {
+        pthread_create(&readers[i].thread, NULL, reader_main, &readers[i]);
+    }
+    pthread_create(&writer, NULL, writer_main, NULL);
+
+    pthread_join(writer, NULL);
+    uint32_t reads = 0, torn = 0, backwards = 0;
+    for (int i = 0; i < READERS; i++) {
+        pthread_join(readers[i].thread, NULL);
+        printf("reader %d: %u reads\n", i, readers[i].reads);
+        reads += readers[i].reads;
+        torn += readers[i].torn;
+        backwards += readers[i].backwards;
+    }
+
+    pet_snapshot_stats_t stats;
+    pet_get_snapshot_stats(&stats);
+    printf("publishes %u, reads %u, retries %u (%.3f per read), max %u retries in one read\n",
+           stats.publishes, stats.reads, stats.retries,
+           stats.reads ? (double)stats.retries / stats.reads : 0.0, stats.max_retries);
+    printf("torn copies %u, out-of-order copies %u\n", torn, backwards);
+
+    bool ok = torn == 0 && backwards == 0 &&
+              stats.publishes == PUBLISHES + 1 && stats.reads == reads;
+    for (int i = 0; i < READERS; i++) {
+        ok = ok && readers[i].reads > 0;
+    }
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
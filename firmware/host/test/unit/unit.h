@@ -0,0 +1,47 @@
+/**
+ * @file unit.h
+ * @brief Minimal unit-test harness for the host build
+ *
+ * REQ-SW-055: Host Build
+ * A test is a void function; CHECK and CHECK_EQ record a failure with
+ * its location and end the test. Each unit_*.c file has a suite function
+ * that runs its tests with UNIT_RUN; unit_main.c runs every suite.
+ */
+
+#ifndef UNIT_H
+#define UNIT_H
+
+#include <stdbool.h>
+
+//=============================================================================
+// Macros
+//=============================================================================
+
+#define CHECK(cond) \
+    do { if (!unit_check((cond), #cond, __FILE__, __LINE__)) return; } while (0)
+
+#define CHECK_EQ(actual, expected) \
+    do { \
+        long long actual_ = (long long)(actual), expected_ = (long long)(expected); \
+        if (!unit_check_eq(actual_, expected_, #actual, __FILE__, __LINE__)) return; \
+    } while (0)
+
+#define UNIT_RUN(fn)    unit_run(#fn, fn)
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+bool unit_check(bool ok, const char *expr, const char *file, int line);
+bool unit_check_eq(long long actual, long long expected, const char *expr, const char *file, int line);
+void unit_run(const char *name, void (*fn)(void));
+
+// Suites
+void unit_suite_pet(void);
+void unit_suite_save(void);
+void unit_suite_input(void);
+void unit_suite_display(void);
+void unit_suite_sprites(void);
+void unit_suite_game(void);
+
+#endif // UNIT_H
@@ -0,0 +1,178 @@
+/**
+ * @file unit_display.c
+ * @brief Unit tests: display driver against the ST7789 panel model, sprites
+ *
+ * REQ-SW-055: Host Build
+ * What the driver sends over SPI is decoded into the panel image, so the
+ * tests check pixels as they would appear on the glass.
+ */
+
+#include "unit.h"
+#include <stddef.h>
+#include "display.h"
+#include "sprites.h"
+#include "host_mocks.h"
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define RED                 0xF800
+#define GREEN               0x07E0
+#define BLUE                0x001F
+#define WHITE               0xFFFF
+#define BLACK               0x0000
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+static void start(display_render_mode_t mode)
+{
+    display_init();
+    display_set_render_mode(mode);
+}
+
+/**
+ * @brief Count panel pixels of a color inside and outside a rectangle
+ */
+static void count_rect(int x, int y, int w, int h, uint16_t color, int *inside, int *outside)
+{
+    *inside = 0;
+    *outside = 0;
+    for (int py = 0; py < MOCK_LCD_HEIGHT; py++) {
+        for (int px = 0; px < MOCK_LCD_WIDTH; px++) {
+            if (mock_lcd_pixel(px, py) != color) continue;
+            bool in = px >= x && px < x + w && py >= y && py < y + h;
+            if (in) (*inside)++;
+            else (*outside)++;
+        }
+    }
+}
+
+static void check_rect_mode(display_render_mode_t mode)
+{
+    int inside, outside;
+    start(mode);
+    display_start_frame();
+    display_fill(BLACK);
+    display_fill_rect(10, 20, 30, 40, RED);
+    display_end_frame();
+    count_rect(10, 20, 30, 40, RED, &inside, &outside);
+    CHECK_EQ(inside, 30 * 40);
+    CHECK_EQ(outside, 0);
+    CHECK_EQ(mock_lcd_stray_pixels(), 0);
+}
+
+//=============================================================================
+// Tests
+//=============================================================================
+
+static void display_fill_covers_panel(void)
+{
+    int inside, outside;
+    start(DISPLAY_RENDER_IMMEDIATE);
+    display_fill(GREEN);
+    count_rect(0, 0, MOCK_LCD_WIDTH, MOCK_LCD_HEIGHT, GREEN, &inside, &outside);
+    CHECK_EQ(inside, MOCK_LCD_WIDTH * MOCK_LCD_HEIGHT);
+    CHECK_EQ(mock_lcd_stray_pixels(), 0);
+}
+
+static void display_rect_immediate(void)
+{
+    check_rect_mode(DISPLAY_RENDER_IMMEDIATE);
+}
+
+static void display_rect_framebuffer(void)
+{
+    check_rect_mode(DISPLAY_RENDER_FRAMEBUFFER);
+}
+
+static void display_rect_banded(void)
+{
+    check_rect_mode(DISPLAY_RENDER_BANDED);
+}
+
+static void display_clipped_at_edges(void)
+{
+    int inside, outside;
+    start(DISPLAY_RENDER_IMMEDIATE);
+    display_fill(BLACK);
+    display_fill_rect(-10, -10, 20, 20, BLUE);
+    display_fill_rect(230, 125, 20, 20, BLUE);
+    count_rect(0, 0, 10, 10, BLUE, &inside, &outside);
+    CHECK_EQ(inside, 100);
+    CHECK_EQ(outside, 100);         // The bottom-right corner
+    CHECK_EQ(mock_lcd_stray_pixels(), 0);
+}
+
+static void display_framebuffer_waits_for_end_frame(void)
+{
+    start(DISPLAY_RENDER_FRAMEBUFFER);
+    display_start_frame();
+    display_fill(BLACK);
+    display_end_frame();
+
+    display_start_frame();
+    display_fill_rect(50, 50, 8, 8, WHITE);
+    CHECK_EQ(mock_lcd_pixel(52, 52), BLACK);
+    display_end_frame();
+    CHECK_EQ(mock_lcd_pixel(52, 52), WHITE);
+}
+
+static void display_text_stays_in_its_box(void)
+{
+    int inside, outside;
+    start(DISPLAY_RENDER_IMMEDIATE);
+    display_fill(BLACK);
+    display_draw_string(20, 30, "HOST", WHITE, BLACK, 2);
+    count_rect(20, 30, 4 * 6 * 2, 8 * 2, WHITE, &inside, &outside);
+    CHECK(inside > 40);
+    CHECK_EQ(outside, 0);
+}
+
+//=============================================================================
+// Sprites
+//=============================================================================
+
+static void sprites_builtin_without_partition(void)
+{
+    mock_partition_load(NULL);
+    CHECK_EQ(sprites_init(), ESP_ERR_NOT_FOUND);
+    CHECK(!sprites_has_pack());
+
+    int w, h;
+    CHECK(sprites_get(SPRITE_ASSET_MG_ROCK, &w, &h) != NULL);
+    CHECK(w > 0 && h > 0);
+}
+
+static void sprites_pack_from_partition(void)
+{
+    CHECK_EQ(mock_partition_load(HOST_ASSET_PACK), ESP_OK);
+    CHECK_EQ(sprites_init(), ESP_OK);
+    CHECK(sprites_has_pack());
+    CHECK(sprites_get_font() != NULL);
+    mock_partition_load(NULL);
+    sprites_init();
+}
+
+//=============================================================================
+// Suites
+//=============================================================================
+
+void unit_suite_display(void)
+{
+    UNIT_RUN(display_fill_covers_panel);
+    UNIT_RUN(display_rect_immediate);
+    UNIT_RUN(display_rect_framebuffer);
+    UNIT_RUN(display_rect_banded);
+    UNIT_RUN(display_clipped_at_edges);
+    UNIT_RUN(display_framebuffer_waits_for_end_frame);
+    UNIT_RUN(display_text_stays_in_its_box);
+}
+
+void unit_suite_sprites(void)
+{
+    UNIT_RUN(sprites_builtin_without_partition);
+    UNIT_RUN(sprites_pack_from_partition);
+}
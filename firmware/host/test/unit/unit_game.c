@@ -0,0 +1,228 @@
+/**
+ * @file unit_game.c
+ * @brief Unit tests: the whole game loop on mocked hardware
+ *
+ * REQ-SW-055: Host Build
+ * Boots like the firmware, presses buttons through scripted GPIO and
+ * checks the game state and the panel.
+ */
+
+#include "unit.h"
+#include "host_game.h"
+#include "host_mocks.h"
+#include "game.h"
+#include "pet.h"
+#include "pet_history.h"
+#include "save_manager.h"
+#include "display.h"
+#include "sim.h"
+#include <string.h>
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+static int lit_pixels(void)
+{
+    const uint16_t *px = mock_lcd_pixels();
+    int n = 0;
+    for (int i = 0; i < MOCK_LCD_WIDTH * MOCK_LCD_HEIGHT; i++) {
+        if (px[i] != 0) n++;
+    }
+    return n;
+}
+
+/**
+ * @brief Draw one frame of what was last published, as the render task
+ */
+static void render_frame(void)
+{
+    display_start_frame();
+    game_render();
+    display_end_frame();
+}
+
+/**
+ * @brief Run sim ticks without handing a frame over (render busy)
+ */
+static void sim_only_ticks(int ticks)
+{
+    for (int i = 0; i < ticks; i++) {
+        game_update(SIM_TICK_MS);
+        sim_step();
+    }
+}
+
+/**
+ * @brief Append minutes of history as the sim task does, hunger at level
+ */
+static void history_minutes(int minutes, uint8_t hunger)
+{
+    for (int m = 0; m < minutes; m++) {
+        pet_get_state_mutable()->hunger = hunger;
+        pet_history_update(PET_HISTORY_SAMPLE_MS);
+    }
+}
+
+static bool panel_equals(const uint16_t *copy)
+{
+    return memcmp(copy, mock_lcd_pixels(), MOCK_LCD_WIDTH * MOCK_LCD_HEIGHT * sizeof(uint16_t)) == 0;
+}
+
+static bool boot(bool keep_save)
+{
+    host_game_config_t config = { .seed = 42, .keep_save = keep_save };
+    return host_game_boot(&config) == ESP_OK;
+}
+
+//=============================================================================
+// Tests
+//=============================================================================
+
+static void game_boots_to_splash(void)
+{
+    CHECK(boot(false));
+    host_game_run_ms(500);
+    CHECK_EQ(game_get_state(), GAME_STATE_SPLASH);
+    CHECK(lit_pixels() > 0);
+    CHECK_EQ(mock_lcd_stray_pixels(), 0);
+}
+
+static void game_click_starts_pet(void)
+{
+    CHECK(boot(false));
+    host_game_run_ms(500);
+    host_game_click(BUTTON_RIGHT);
+    CHECK_EQ(game_get_state(), GAME_STATE_MAIN);
+    CHECK(pet_is_alive());
+}
+
+static void game_menu_opens_and_closes(void)
+{
+    CHECK(boot(false));
+    host_game_run_ms(500);
+    host_game_click(BUTTON_RIGHT);
+    host_game_click(BUTTON_LEFT);
+    CHECK_EQ(game_get_state(), GAME_STATE_MENU);
+    host_game_press(BUTTON_LEFT, 0, 2200);      // Long press backs out
+    host_game_run_ms(3000);
+    CHECK_EQ(game_get_state(), GAME_STATE_MAIN);
+}
+
+static void game_saved_pet_skips_splash(void)
+{
+    CHECK(boot(false));
+    host_game_run_ms(500);
+    host_game_click(BUTTON_RIGHT);
+    host_game_run_ms(1000);
+    pet_get_state_mutable()->happiness = 42;
+    CHECK_EQ(save_manager_save(), ESP_OK);
+
+    CHECK(boot(true));
+    host_game_run_ms(100);
+    CHECK_EQ(game_get_state(), GAME_STATE_MAIN);
+    CHECK_EQ(pet_get_state()->happiness, 42);
+}
+
+static void game_runs_repeat_exactly(void)
+{
+    uint16_t first[MOCK_LCD_WIDTH * MOCK_LCD_HEIGHT];
+
+    for (int run = 0; run < 2; run++) {
+        CHECK(boot(false));
+        host_game_run_ms(500);
+        host_game_click(BUTTON_RIGHT);
+        host_game_run_ms(5 * 60 * 1000);
+        const uint16_t *px = mock_lcd_pixels();
+        for (int i = 0; i < MOCK_LCD_WIDTH * MOCK_LCD_HEIGHT; i++) {
+            if (run == 0) {
+                first[i] = px[i];
+            } else if (first[i] != px[i]) {
+                CHECK_EQ(i, -1);        // First differing pixel
+            }
+        }
+    }
+}
+
+static void game_renders_published_frame_only(void)
+{
+    static uint16_t before[MOCK_LCD_WIDTH * MOCK_LCD_HEIGHT];
+
+    CHECK(boot(false));
+    host_game_run_ms(500);
+    host_game_click(BUTTON_RIGHT);
+    pet_get_state_mutable()->stage = PET_STAGE_BABY;   // Eggs cannot play
+    host_game_run_ms(1000);
+
+    // Main scene: animation frames advance on the sim side only
+    memcpy(before, mock_lcd_pixels(), sizeof(before));
+    sim_only_ticks(20);
+    render_frame();
+    CHECK(panel_equals(before));
+    game_publish_frame();
+    render_frame();
+    CHECK(!panel_equals(before));
+
+    // Mini-game: obstacles move in the model, not in the render copy
+    game_handle_input(BUTTON_RIGHT, BUTTON_EVENT_HOLD_CLICK);
+    CHECK_EQ(game_get_state(), GAME_STATE_PLAY);
+    host_game_run_ms(1000);
+    memcpy(before, mock_lcd_pixels(), sizeof(before));
+    sim_only_ticks(20);
+    render_frame();
+    CHECK(panel_equals(before));
+    game_publish_frame();
+    render_frame();
+    CHECK(!panel_equals(before));
+    CHECK_EQ(mock_lcd_stray_pixels(), 0);
+}
+
+static void game_renders_published_history_only(void)
+{
+    static uint16_t before[MOCK_LCD_WIDTH * MOCK_LCD_HEIGHT];
+
+    CHECK(boot(false));
+    host_game_run_ms(500);
+    host_game_click(BUTTON_RIGHT);
+    history_minutes(6 * 60, 80);
+
+    // 24 hour trends page
+    host_game_click(BUTTON_LEFT);
+    for (int i = 0; i < MENU_STATS; i++) {
+        host_game_click(BUTTON_LEFT);
+    }
+    host_game_click(BUTTON_RIGHT);
+    host_game_click(BUTTON_LEFT);
+    CHECK_EQ(game_get_state(), GAME_STATE_STATS);
+    memcpy(before, mock_lcd_pixels(), sizeof(before));
+
+    // Back to the same page with a full redraw due; the sim appends
+    // starving hours after the frame was handed over
+    for (int i = 0; i < 3; i++) {
+        game_handle_input(BUTTON_LEFT, BUTTON_EVENT_CLICK);
+    }
+    game_publish_frame();
+    history_minutes(3 * 60, 5);
+    render_frame();
+    CHECK(panel_equals(before));
+
+    game_publish_frame();
+    render_frame();
+    CHECK(!panel_equals(before));
+    CHECK_EQ(mock_lcd_stray_pixels(), 0);
+}
+
+//=============================================================================
+// Suite
+//=============================================================================
+
+void unit_suite_game(void)
+{
+    UNIT_RUN(game_boots_to_splash);
+    UNIT_RUN(game_click_starts_pet);
+    UNIT_RUN(game_menu_opens_and_closes);
+    UNIT_RUN(game_saved_pet_skips_splash);
+    UNIT_RUN(game_runs_repeat_exactly);
+    UNIT_RUN(game_renders_published_frame_only);
+    UNIT_RUN(game_renders_published_history_only);
+}
@@ -0,0 +1,146 @@
+/**
+ * @file unit_input.c
+ * @brief Unit tests: button input through scripted GPIO
+ *
+ * REQ-SW-055: Host Build
+ * Buttons are driven on the GPIO pins (active low), so every test goes
+ * through the edge ISR, debounce, long-press and gesture code.
+ */
+
+#include "unit.h"
+#include "input.h"
+#include "host_mocks.h"
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define GPIO_LEFT           0
+#define GPIO_RIGHT          35
+#define POLL_MS             10
+#define MAX_EVENTS          32
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+typedef struct {
+    int count;
+    input_event_t ev[MAX_EVENTS];
+} event_log_t;
+
+static void start(uint32_t gestures)
+{
+    mock_clock_set_virtual(true);
+    mock_gpio_script_clear();
+    input_init();
+    input_set_gestures(gestures);
+}
+
+static void press(int gpio, uint32_t at_ms, uint32_t hold_ms)
+{
+    mock_gpio_script((int64_t)at_ms * 1000, gpio, 0);
+    mock_gpio_script((int64_t)(at_ms + hold_ms) * 1000, gpio, 1);
+}
+
+/**
+ * @brief Poll like the input task for a while, collecting events
+ */
+static void run(event_log_t *log, uint32_t ms)
+{
+    log->count = 0;
+    for (uint32_t t = 0; t < ms; t += POLL_MS) {
+        mock_clock_advance_us(POLL_MS * 1000);
+        input_update();
+        input_event_t ev;
+        while (input_get_event(&ev) && log->count < MAX_EVENTS) {
+            log->ev[log->count++] = ev;
+        }
+    }
+}
+
+static int count(const event_log_t *log, button_id_t button, button_event_t event)
+{
+    int n = 0;
+    for (int i = 0; i < log->count; i++) {
+        if (log->ev[i].button == button && log->ev[i].event == event) n++;
+    }
+    return n;
+}
+
+//=============================================================================
+// Tests
+//=============================================================================
+
+static void input_short_press_clicks(void)
+{
+    event_log_t log;
+    start(0);
+    press(GPIO_LEFT, 100, 120);
+    run(&log, 1000);
+    CHECK_EQ(count(&log, BUTTON_LEFT, BUTTON_EVENT_PRESSED), 1);
+    CHECK_EQ(count(&log, BUTTON_LEFT, BUTTON_EVENT_CLICK), 1);
+    CHECK_EQ(count(&log, BUTTON_RIGHT, BUTTON_EVENT_PRESSED), 0);
+    CHECK_EQ(log.ev[0].time_us, 100 * 1000);     // Stamped at the edge, not the poll
+}
+
+static void input_bounce_is_one_press(void)
+{
+    event_log_t log;
+    start(0);
+    // Contact bounce for 6 ms, then held
+    mock_gpio_script(100000, GPIO_RIGHT, 0);
+    mock_gpio_script(102000, GPIO_RIGHT, 1);
+    mock_gpio_script(104000, GPIO_RIGHT, 0);
+    mock_gpio_script(105000, GPIO_RIGHT, 1);
+    mock_gpio_script(106000, GPIO_RIGHT, 0);
+    mock_gpio_script(300000, GPIO_RIGHT, 1);
+    run(&log, 1000);
+    CHECK_EQ(count(&log, BUTTON_RIGHT, BUTTON_EVENT_PRESSED), 1);
+    CHECK_EQ(count(&log, BUTTON_RIGHT, BUTTON_EVENT_CLICK), 1);
+}
+
+static void input_long_press(void)
+{
+    event_log_t log;
+    start(0);
+    press(GPIO_LEFT, 100, 2600);
+    run(&log, 3500);
+    CHECK_EQ(count(&log, BUTTON_LEFT, BUTTON_EVENT_LONG_PRESS), 1);
+    CHECK_EQ(count(&log, BUTTON_LEFT, BUTTON_EVENT_CLICK), 0);
+}
+
+static void input_chord(void)
+{
+    event_log_t log;
+    start(INPUT_GESTURE_CHORD_ANY);
+    press(GPIO_LEFT, 100, 200);
+    press(GPIO_RIGHT, 140, 200);
+    run(&log, 1000);
+    CHECK_EQ(count(&log, BUTTON_RIGHT, BUTTON_EVENT_CHORD), 1);
+    CHECK_EQ(count(&log, BUTTON_LEFT, BUTTON_EVENT_CLICK), 0);
+}
+
+static void input_double_click(void)
+{
+    event_log_t log;
+    start(INPUT_GESTURE_BIT(INPUT_GESTURE_DOUBLE_CLICK, BUTTON_RIGHT));
+    press(GPIO_RIGHT, 100, 80);
+    press(GPIO_RIGHT, 300, 80);
+    run(&log, 1000);
+    CHECK_EQ(count(&log, BUTTON_RIGHT, BUTTON_EVENT_DOUBLE_CLICK), 1);
+    CHECK_EQ(count(&log, BUTTON_RIGHT, BUTTON_EVENT_CLICK), 0);
+}
+
+//=============================================================================
+// Suite
+//=============================================================================
+
+void unit_suite_input(void)
+{
+    UNIT_RUN(input_short_press_clicks);
+    UNIT_RUN(input_bounce_is_one_press);
+    UNIT_RUN(input_long_press);
+    UNIT_RUN(input_chord);
+    UNIT_RUN(input_double_click);
+}
@@ -0,0 +1,77 @@
+/**
+ * @file unit_main.c
+ * @brief Host unit-test runner
+ *
+ * REQ-SW-055: Host Build
+ * Runs every suite, or only the tests whose name contains the first
+ * argument, and prints one line per test and a summary:
+ *   ./unit_tests            all tests
+ *   ./unit_tests input_     tests with "input_" in the name
+ */
+
+#include "unit.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+static const char *s_filter = NULL;
+static bool s_failed;
+static int s_run = 0;
+static int s_failures = 0;
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+bool unit_check(bool ok, const char *expr, const char *file, int line)
+{
+    if (!ok) {
+        printf("    %s:%d: CHECK(%s) failed\n", file, line, expr);
+        s_failed = true;
+    }
+    return ok;
+}
+
+bool unit_check_eq(long long actual, long long expected, const char *expr, const char *file, int line)
+{
+    if (actual != expected) {
+        printf("    %s:%d: %s is %lld, expected %lld\n", file, line, expr, actual, expected);
+        s_failed = true;
+    }
+    return actual == expected;
+}
+
+void unit_run(const char *name, void (*fn)(void))
+{
+    if (s_filter != NULL && strstr(name, s_filter) == NULL) return;
+
+    s_failed = false;
+    fn();
+    s_run++;
+    if (s_failed) s_failures++;
+    printf("%s %s\n", s_failed ? "FAIL" : "ok  ", name);
+}
+
+//=============================================================================
+// Main
+//=============================================================================
+
+int main(int argc, char **argv)
+{
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    s_filter = argc > 1 ? argv[1] : NULL;
+
+    unit_suite_pet();
+    unit_suite_save();
+    unit_suite_input();
+    unit_suite_display();
+    unit_suite_sprites();
+    unit_suite_game();
+
+    printf("%d tests, %d failed\n", s_run, s_failures);
+    return (s_failures == 0 && s_run > 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
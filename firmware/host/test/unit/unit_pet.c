@@ -0,0 +1,173 @@
+/**
+ * @file unit_pet.c
+ * @brief Unit tests: pet simulation and save manager
+ *
+ * REQ-SW-055: Host Build
+ */
+
+#include "unit.h"
+#include "pet.h"
+#include "sim.h"
+#include "save_manager.h"
+#include "nvs_flash.h"
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+static void new_pet(void)
+{
+    sim_init(1);
+    pet_init();
+    pet_new();
+}
+
+static void run_minutes(uint32_t minutes)
+{
+    // Poop timing reads the sim clock, so keep it in step
+    for (uint32_t i = 0; i < minutes; i++) {
+        sim_advance((60000 + SIM_TICK_MS - 1) / SIM_TICK_MS);
+        pet_update(60000);
+    }
+}
+
+static void fresh_save_manager(void)
+{
+    nvs_flash_erase();
+    save_manager_init();
+}
+
+//=============================================================================
+// Pet
+//=============================================================================
+
+static void pet_new_is_egg(void)
+{
+    new_pet();
+    const pet_state_t *pet = pet_get_state();
+    CHECK_EQ(pet->stage, PET_STAGE_EGG);
+    CHECK_EQ(pet->age_minutes, 0);
+    CHECK(pet_is_alive());
+    CHECK(!pet_feed(FOOD_FISH));    // Eggs do not eat
+}
+
+static void pet_hatches_after_two_minutes(void)
+{
+    new_pet();
+    run_minutes(1);
+    CHECK_EQ(pet_get_state()->stage, PET_STAGE_EGG);
+    run_minutes(1);
+    CHECK_EQ(pet_get_state()->stage, PET_STAGE_BABY);
+}
+
+static void pet_feeding_raises_hunger(void)
+{
+    new_pet();
+    run_minutes(2);
+    uint8_t before = pet_get_state()->hunger;
+    CHECK(pet_feed(FOOD_FISH));
+    CHECK(pet_get_state()->hunger > before);
+    CHECK_EQ(pet_get_state()->times_fed, 1);
+}
+
+static void pet_sub_minute_updates_do_not_age(void)
+{
+    new_pet();
+    for (int i = 0; i < 1000; i++) {
+        pet_update(SIM_TICK_MS);
+    }
+    CHECK_EQ(pet_get_state()->age_minutes, 0);
+}
+
+static void pet_time_away_is_capped(void)
+{
+    new_pet();
+    pet_apply_time_away(100 * 60);
+    CHECK(pet_get_state()->age_minutes <= 48 * 60);
+}
+
+static void pet_neglect_kills(void)
+{
+    new_pet();
+    run_minutes(24 * 60);
+    CHECK(!pet_is_alive());
+    CHECK_EQ(pet_get_state()->stage, PET_STAGE_DEAD);
+}
+
+//=============================================================================
+// Save Manager
+//=============================================================================
+
+static void save_round_trip(void)
+{
+    new_pet();
+    fresh_save_manager();
+    run_minutes(5);
+    pet_state_t *pet = pet_get_state_mutable();
+    pet->hunger = 77;
+    pet->happiness = 33;
+    pet->poop_count = 2;
+    CHECK_EQ(save_manager_save(), ESP_OK);
+    CHECK(save_manager_exists());
+
+    pet->hunger = 1;
+    pet->happiness = 1;
+    pet->poop_count = 0;
+    CHECK_EQ(save_manager_load(), ESP_OK);
+    CHECK_EQ(pet->hunger, 77);
+    CHECK_EQ(pet->happiness, 33);
+    CHECK_EQ(pet->poop_count, 2);
+    CHECK_EQ(pet->age_minutes, 5);
+}
+
+static void save_load_without_save(void)
+{
+    new_pet();
+    fresh_save_manager();
+    CHECK(!save_manager_exists());
+    CHECK_EQ(save_manager_load(), ESP_ERR_NOT_FOUND);
+}
+
+static void save_delete(void)
+{
+    new_pet();
+    fresh_save_manager();
+    CHECK_EQ(save_manager_save(), ESP_OK);
+    CHECK_EQ(save_manager_delete(), ESP_OK);
+    CHECK(!save_manager_exists());
+}
+
+static void save_blob_round_trip(void)
+{
+    static const uint8_t data[] = { 1, 2, 3, 4, 5 };
+    uint8_t out[8];
+    size_t len = sizeof(out);
+
+    fresh_save_manager();
+    CHECK_EQ(save_manager_write_blob("blob", data, sizeof(data)), ESP_OK);
+    CHECK_EQ(save_manager_read_blob("blob", out, &len), ESP_OK);
+    CHECK_EQ(len, sizeof(data));
+    CHECK_EQ(out[4], 5);
+}
+
+//=============================================================================
+// Suites
+//=============================================================================
+
+void unit_suite_pet(void)
+{
+    UNIT_RUN(pet_new_is_egg);
+    UNIT_RUN(pet_hatches_after_two_minutes);
+    UNIT_RUN(pet_feeding_raises_hunger);
+    UNIT_RUN(pet_sub_minute_updates_do_not_age);
+    UNIT_RUN(pet_time_away_is_capped);
+    UNIT_RUN(pet_neglect_kills);
+}
+
+void unit_suite_save(void)
+{
+    UNIT_RUN(save_round_trip);
+    UNIT_RUN(save_load_without_save);
+    UNIT_RUN(save_delete);
+    UNIT_RUN(save_blob_round_trip);
+}
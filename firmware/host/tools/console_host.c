@@ -0,0 +1,65 @@
+/**
+ * @file console_host.c
+ * @brief Host build of the debug console on stdin/stdout
+ *
+ * REQ-SW-054: Debug Console
+ * Runs the pet simulation, save manager (in-memory NVS) and display
+ * (discarding SPI bus) with the same command table as the device. Reads
+ * commands from stdin, so a script can be piped in:
+ *   printf 'pet set hunger 10\nwarp 14d\nsave\n' | ./console_host
+ * A time warp runs to completion before the next line is read.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "console.h"
+#include "pet.h"
+#include "pet_history.h"
+#include "sim.h"
+#include "save_manager.h"
+#include "display.h"
+#include "telemetry.h"
+
+//=============================================================================
+// Main
+//=============================================================================
+
+int main(int argc, char **argv)
+{
+    char line[CONSOLE_LINE_MAX];
+    bool interactive = isatty(STDIN_FILENO);
+    int failures = 0;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);   // Keep replies in order with the log
+    // Fixed seed unless given: scripted sessions repeat exactly
+    sim_init(argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : 12345);
+    if (pet_init() != ESP_OK || save_manager_init() != ESP_OK || display_init() != ESP_OK) {
+        fprintf(stderr, "init failed\n");
+        return EXIT_FAILURE;
+    }
+    telemetry_init(NULL);
+    pet_new();
+    pet_history_reset();
+
+    while (1) {
+        if (interactive) {
+            printf(CONSOLE_PROMPT);
+            fflush(stdout);
+        }
+        if (fgets(line, sizeof(line), stdin) == NULL) break;
+        if (!interactive) {
+            printf(CONSOLE_PROMPT "%s", line);
+        }
+
+        if (console_exec_line(line) != 0) failures++;
+        while (console_warp_active()) {
+            console_warp_step(UINT32_MAX);
+        }
+        pet_publish_snapshot();
+    }
+
+    // A piped script fails if any of its commands did
+    return (interactive || failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
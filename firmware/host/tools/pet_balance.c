@@ -0,0 +1,615 @@
+/**
+ * @file pet_balance.c
+ * @brief Pet balance simulator: whole lifetimes under scripted care
+ *
+ * REQ-SW-058: Pet Balance Simulator
+ * Raises populations of pets with the real pet.c, one simulated minute at
+ * a time, each looked after by a care policy (when the owner checks, what
+ * they do about hunger, boredom, poop, sickness and bedtime). pet.c and
+ * sim.c are built for this tool with SIM_THREAD_LOCAL=_Thread_local, so
+ * every worker thread raises its own pet. Lifetimes go out in batches to
+ * a work-stealing pool: each worker takes from the back of its own deque
+ * and, when that is empty, steals from the front of another's, which
+ * keeps the cores busy although a neglected pet dies in hours and a
+ * well-kept one lives the whole run.
+ *
+ * Reports per policy the survival curve, when pets first got sick and
+ * the throughput in pet-days simulated per second:
+ *   pet_balance --pets 20000 --days 30 --threads 8 --csv balance.csv
+ * Every lifetime has its own seed, so the results do not depend on the
+ * thread count or the order the batches ran in. --check fails the run
+ * unless the counts agree with each other and the attentive owner's pets
+ * outlive the neglectful owner's and fall sick later. Build with
+ * -DPET_BALANCE_DEFINES="SICK_THRESHOLD=25;POOP_INTERVAL_MIN=45" to try
+ * other values of the pet.c tunables.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "pet.h"
+#include "sim.h"
+
+//=============================================================================
+// Constants
+//=============================================================================
+
+#define MAX_THREADS         256
+#define MAX_DAYS            45      // sim_now_ms() wraps after 49 days
+#define MAX_HOURS           (MAX_DAYS * 24)
+#define BATCH_LIFETIMES     32      // Lifetimes per pool task
+#define HATCH_HOUR          8       // Every pet is born at 08:00
+#define PLAY_WIN_PERCENT    60      // Chance the owner wins the minigame
+#define MAX_FEEDS           3       // Fish per check at most
+#define TICKS_PER_MIN       ((60000 + SIM_TICK_MS - 1) / SIM_TICK_MS)
+
+//=============================================================================
+// Care Policies
+//=============================================================================
+
+/**
+ * @brief How an owner looks after the pet
+ *
+ * The owner is up from wake_hour to sleep_hour (the range may wrap past
+ * midnight) and checks the pet every check_min minutes while up.
+ */
+typedef struct {
+    const char *name;
+    uint16_t check_min;         // Minutes between checks
+    uint8_t wake_hour;
+    uint8_t sleep_hour;
+    uint8_t feed_below;         // Feed fish while hunger is under this
+    uint8_t play_below;         // Play once when happiness is under this
+    uint8_t rest_below;         // Put to sleep when energy is under this
+    bool cleans;
+    bool medicates;
+    bool bedtime;               // Puts the pet to bed and wakes it with them
+} care_policy_t;
+
+enum {
+    POLICY_ATTENTIVE,
+    POLICY_NEGLECTFUL,
+    POLICY_NIGHT_OWL,
+};
+
+static const care_policy_t s_policies[] = {
+    [POLICY_ATTENTIVE]  = { "attentive",  30,  7, 23, 70, 60, 30, true,  true,  true  },
+    [POLICY_NEGLECTFUL] = { "neglectful", 480, 8, 22, 30, 20, 10, true,  false, false },
+    [POLICY_NIGHT_OWL]  = { "night_owl",  45, 12,  4, 60, 50, 30, true,  true,  true  },
+};
+#define POLICY_COUNT        (sizeof(s_policies) / sizeof(s_policies[0]))
+
+//=============================================================================
+// Types
+//=============================================================================
+
+/**
+ * @brief Outcomes of the lifetimes raised under one policy
+ */
+typedef struct {
+    uint64_t lifetimes;
+    uint64_t minutes;               // Simulated pet-minutes (until death or the cap)
+    uint64_t deaths;
+    uint64_t never_sick;
+    uint64_t adults;                // Alive and grown up at the end
+    uint64_t died_in_hour[MAX_HOURS];
+    uint64_t first_sick_in_hour[MAX_HOURS];
+} balance_stats_t;
+
+/**
+ * @brief One pool task: a batch of lifetimes under one policy
+ */
+typedef struct {
+    uint32_t policy;
+    uint32_t first;                 // Lifetime index (seeds the pet)
+    uint32_t count;
+} balance_task_t;
+
+/**
+ * @brief Pool worker with its deque; the owner pops at bottom, thieves at top
+ */
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    balance_task_t *tasks;
+    uint32_t top;
+    uint32_t bottom;
+    uint32_t index;
+    uint32_t rng;                   // Victim choice
+    uint32_t executed;
+    uint32_t stolen;
+    balance_stats_t stats[POLICY_COUNT];
+} worker_t;
+
+//=============================================================================
+// Static State
+//=============================================================================
+
+static worker_t *s_workers;
+static uint32_t s_worker_count;
+static uint32_t s_days = 30;
+static uint32_t s_seed = 1;
+
+//=============================================================================
+// Lifetime
+//=============================================================================
+
+static uint32_t lifetime_seed(uint32_t policy, uint32_t index)
+{
+    // splitmix32-style mix, so neighbouring lifetimes are unrelated
+    uint32_t x = s_seed ^ (policy * 0x9E3779B9u) ^ (index * 0x85EBCA6Bu);
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+static bool owner_awake(const care_policy_t *policy, uint32_t hour)
+{
+    if (policy->wake_hour < policy->sleep_hour) {
+        return hour >= policy->wake_hour && hour < policy->sleep_hour;
+    }
+    return hour >= policy->wake_hour || hour < policy->sleep_hour;
+}
+
+/**
+ * @brief What the owner does when they look at the pet
+ */
+static void owner_check(const care_policy_t *policy)
+{
+    const pet_state_t *pet = pet_get_state();
+
+    if (policy->medicates && pet->is_sick) {
+        pet_give_medicine();
+    }
+    if (policy->cleans && pet->has_poop) {
+        pet_clean();
+    }
+    if (pet->is_sleeping) return;
+
+    for (int i = 0; i < MAX_FEEDS && pet->hunger < policy->feed_below; i++) {
+        pet_feed(FOOD_FISH);
+    }
+    if (pet->happiness < policy->play_below && pet_play_start()) {
+        pet_play_complete(sim_random() % 100 < PLAY_WIN_PERCENT);
+    }
+    if (pet->energy < policy->rest_below) {
+        pet_sleep();
+    }
+}
+
+/**
+ * @brief Raise one pet until it dies or the run ends
+ */
+static void run_lifetime(const care_policy_t *policy, uint32_t seed, balance_stats_t *stats)
+{
+    uint32_t minutes = s_days * 24 * 60;
+    uint32_t m;
+    bool sick = false;
+
+    sim_init(seed);
+    pet_init();
+    pet_new();
+    const pet_state_t *pet = pet_get_state();
+
+    for (m = 0; m < minutes && pet_is_alive(); m++) {
+        // Poop timing reads the sim clock, so keep it in step
+        sim_advance(TICKS_PER_MIN);
+        pet_update(60000);
+
+        if (!sick && pet->is_sick) {
+            sick = true;
+            stats->first_sick_in_hour[m / 60]++;
+        }
+        if (!pet_is_alive()) {
+            stats->deaths++;
+            stats->died_in_hour[m / 60]++;
+            m++;
+            break;
+        }
+
+        uint32_t clock_min = (HATCH_HOUR * 60 + m) % (24 * 60);
+        uint32_t hour = clock_min / 60;
+        if (policy->bedtime && clock_min % 60 == 0) {
+            if (hour == policy->sleep_hour) pet_sleep();
+            if (hour == policy->wake_hour) pet_wake();
+        }
+        if (owner_awake(policy, hour) &&
+            (clock_min + 24 * 60 - policy->wake_hour * 60) % policy->check_min == 0) {
+            owner_check(policy);
+        }
+    }
+
+    stats->lifetimes++;
+    stats->minutes += m;
+    if (!sick) stats->never_sick++;
+    if (pet_is_alive() && pet->stage == PET_STAGE_ADULT) stats->adults++;
+}
+
+//=============================================================================
+// Work-stealing Pool
+//=============================================================================
+
+static bool pop_own(worker_t *worker, balance_task_t *task)
+{
+    bool found = false;
+    pthread_mutex_lock(&worker->lock);
+    if (worker->bottom > worker->top) {
+        *task = worker->tasks[--worker->bottom];
+        found = true;
+    }
+    pthread_mutex_unlock(&worker->lock);
+    return found;
+}
+
+static bool steal(worker_t *thief, balance_task_t *task)
+{
+    // Start at a random victim so thieves spread over the deques
+    thief->rng ^= thief->rng << 13;
+    thief->rng ^= thief->rng >> 17;
+    thief->rng ^= thief->rng << 5;
+    uint32_t start = thief->rng % s_worker_count;
+
+    for (uint32_t i = 0; i < s_worker_count; i++) {
+        worker_t *victim = &s_workers[(start + i) % s_worker_count];
+        if (victim == thief) continue;
+
+        bool found = false;
+        pthread_mutex_lock(&victim->lock);
+        if (victim->bottom > victim->top) {
+            *task = victim->tasks[victim->top++];
+            found = true;
+        }
+        pthread_mutex_unlock(&victim->lock);
+        if (found) return true;
+    }
+    return false;
+}
+
+static void *worker_main(void *arg)
+{
+    worker_t *worker = arg;
+    balance_task_t task;
+
+    // No task creates tasks, so once every deque is empty the run is over
+    while (1) {
+        if (!pop_own(worker, &task)) {
+            if (!steal(worker, &task)) break;
+            worker->stolen++;
+        }
+        for (uint32_t i = 0; i < task.count; i++) {
+            run_lifetime(&s_policies[task.policy], lifetime_seed(task.policy, task.first + i),
+                         &worker->stats[task.policy]);
+        }
+        worker->executed++;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Deal the batches round robin over the deques and run the pool
+ */
+static bool run_pool(const bool *enabled, uint32_t pets)
+{
+    uint32_t batches = (pets + BATCH_LIFETIMES - 1) / BATCH_LIFETIMES;
+    uint32_t per_worker = (batches * (uint32_t)POLICY_COUNT + s_worker_count - 1) / s_worker_count;
+    uint32_t next = 0;
+
+    s_workers = calloc(s_worker_count, sizeof(worker_t));
+    if (s_workers == NULL) return false;
+    for (uint32_t w = 0; w < s_worker_count; w++) {
+        s_workers[w].tasks = calloc(per_worker, sizeof(balance_task_t));
+        if (s_workers[w].tasks == NULL) return false;
+        pthread_mutex_init(&s_workers[w].lock, NULL);
+        s_workers[w].index = w;
+        s_workers[w].rng = 0x9E3779B9u * (w + 1);
+    }
+
+    // Policies interleaved, so every deque starts with a mix of cheap
+    // (short-lived) and expensive lifetimes
+    for (uint32_t b = 0; b < batches; b++) {
+        for (uint32_t p = 0; p < POLICY_COUNT; p++) {
+            if (!enabled[p]) continue;
+            worker_t *worker = &s_workers[next++ % s_worker_count];
+            uint32_t first = b * BATCH_LIFETIMES;
+            worker->tasks[worker->bottom++] = (balance_task_t){
+                .policy = p,
+                .first = first,
+                .count = pets - first < BATCH_LIFETIMES ? pets - first : BATCH_LIFETIMES,
+            };
+        }
+    }
+
+    for (uint32_t w = 0; w < s_worker_count; w++) {
+        if (pthread_create(&s_workers[w].thread, NULL, worker_main, &s_workers[w]) != 0) {
+            fprintf(stderr, "cannot start worker %lu\n", (unsigned long)w);
+            return false;
+        }
+    }
+    for (uint32_t w = 0; w < s_worker_count; w++) {
+        pthread_join(s_workers[w].thread, NULL);
+    }
+    return true;
+}
+
+//=============================================================================
+// Report
+//=============================================================================
+
+static void merge_stats(balance_stats_t *total)
+{
+    memset(total, 0, sizeof(balance_stats_t) * POLICY_COUNT);
+    for (uint32_t w = 0; w < s_worker_count; w++) {
+        for (uint32_t p = 0; p < POLICY_COUNT; p++) {
+            const balance_stats_t *s = &s_workers[w].stats[p];
+            balance_stats_t *t = &total[p];
+            t->lifetimes += s->lifetimes;
+            t->minutes += s->minutes;
+            t->deaths += s->deaths;
+            t->never_sick += s->never_sick;
+            t->adults += s->adults;
+            for (uint32_t h = 0; h < MAX_HOURS; h++) {
+                t->died_in_hour[h] += s->died_in_hour[h];
+                t->first_sick_in_hour[h] += s->first_sick_in_hour[h];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Hour of age by which a fraction of the pets that got sick had
+ */
+static uint32_t sick_percentile(const balance_stats_t *stats, uint32_t percent)
+{
+    uint64_t sick = stats->lifetimes - stats->never_sick;
+    uint64_t seen = 0;
+    for (uint32_t h = 0; h < s_days * 24; h++) {
+        seen += stats->first_sick_in_hour[h];
+        if (seen * 100 >= sick * percent) return h + 1;
+    }
+    return s_days * 24;
+}
+
+static void print_report(const bool *enabled, const balance_stats_t *total)
+{
+    printf("%-11s %9s %7s %8s %9s %7s  first sick at (h) p10/p50/p90\n",
+           "policy", "lifetimes", "alive", "adults", "life (d)", "sick");
+    for (uint32_t p = 0; p < POLICY_COUNT; p++) {
+        const balance_stats_t *s = &total[p];
+        if (!enabled[p] || s->lifetimes == 0) continue;
+        double n = (double)s->lifetimes;
+        printf("%-11s %9llu %6.1f%% %7.1f%% %9.2f %6.1f%%",
+               s_policies[p].name, (unsigned long long)s->lifetimes,
+               100.0 * (double)(s->lifetimes - s->deaths) / n,
+               100.0 * (double)s->adults / n,
+               (double)s->minutes / n / (24 * 60),
+               100.0 * (double)(s->lifetimes - s->never_sick) / n);
+        if (s->never_sick < s->lifetimes) {
+            printf("  %lu/%lu/%lu\n", (unsigned long)sick_percentile(s, 10),
+                   (unsigned long)sick_percentile(s, 50), (unsigned long)sick_percentile(s, 90));
+        } else {
+            printf("  -\n");
+        }
+    }
+
+    printf("\nsurvival (%% alive at the end of the day)\nday ");
+    for (uint32_t p = 0; p < POLICY_COUNT; p++) {
+        if (enabled[p]) printf(" %11s", s_policies[p].name);
+    }
+    printf("\n");
+
+    uint64_t died[POLICY_COUNT] = {0};
+    for (uint32_t d = 0; d < s_days; d++) {
+        printf("%3lu ", (unsigned long)(d + 1));
+        for (uint32_t p = 0; p < POLICY_COUNT; p++) {
+            if (!enabled[p]) continue;
+            for (uint32_t h = d * 24; h < (d + 1) * 24; h++) {
+                died[p] += total[p].died_in_hour[h];
+            }
+            printf(" %10.1f%%", total[p].lifetimes ?
+                   100.0 * (double)(total[p].lifetimes - died[p]) / (double)total[p].lifetimes : 0.0);
+        }
+        printf("\n");
+    }
+}
+
+/**
+ * @brief Per policy and hour of age: still alive, deaths and first sicknesses
+ */
+static bool write_csv(const char *path, const bool *enabled, const balance_stats_t *total)
+{
+    FILE *f = fopen(path, "w");
+    if (f == NULL) return false;
+
+    fprintf(f, "policy,hour,alive,died,first_sick\n");
+    for (uint32_t p = 0; p < POLICY_COUNT; p++) {
+        if (!enabled[p]) continue;
+        uint64_t alive = total[p].lifetimes;
+        for (uint32_t h = 0; h < s_days * 24; h++) {
+            alive -= total[p].died_in_hour[h];
+            fprintf(f, "%s,%lu,%llu,%llu,%llu\n", s_policies[p].name, (unsigned long)(h + 1),
+                    (unsigned long long)alive,
+                    (unsigned long long)total[p].died_in_hour[h],
+                    (unsigned long long)total[p].first_sick_in_hour[h]);
+        }
+    }
+    return fclose(f) == 0;
+}
+
+//=============================================================================
+// Checks
+//=============================================================================
+
+static bool expect(bool ok, const char *policy, const char *what)
+{
+    if (!ok) printf("check failed: %s: %s\n", policy, what);
+    return ok;
+}
+
+/**
+ * @brief Counts of one policy agree with each other and with the run
+ *
+ * A pet that died in hour h lived more than h hours and at most h + 1;
+ * a survivor lived the whole run.
+ */
+static bool check_counts(uint32_t p, const balance_stats_t *s, uint32_t pets)
+{
+    const char *name = s_policies[p].name;
+    uint64_t full = (uint64_t)s_days * 24 * 60;
+    uint64_t died = 0, sick = 0, min_minutes = 0, max_minutes = 0;
+
+    for (uint32_t h = 0; h < MAX_HOURS; h++) {
+        died += s->died_in_hour[h];
+        sick += s->first_sick_in_hour[h];
+        min_minutes += s->died_in_hour[h] * (h * 60 + 1);
+        max_minutes += s->died_in_hour[h] * (h + 1) * 60;
+    }
+
+    bool ok = true;
+    ok &= expect(s->lifetimes == pets, name, "lifetimes differ from --pets");
+    ok &= expect(s->deaths <= s->lifetimes, name, "more deaths than lifetimes");
+    ok &= expect(died == s->deaths, name, "deaths per hour do not add up");
+    ok &= expect(s->never_sick <= s->lifetimes, name, "more never sick than lifetimes");
+    ok &= expect(sick == s->lifetimes - s->never_sick, name,
+                 "first sicknesses per hour do not match the pets that got sick");
+    ok &= expect(s->adults <= s->lifetimes - s->deaths, name, "more adults than survivors");
+    if (ok) {
+        min_minutes += (s->lifetimes - s->deaths) * full;
+        max_minutes += (s->lifetimes - s->deaths) * full;
+        ok &= expect(s->minutes >= min_minutes && s->minutes <= max_minutes, name,
+                     "pet-minutes do not match the hours of death");
+    }
+    return ok;
+}
+
+static double mean_life_days(const balance_stats_t *s)
+{
+    return s->lifetimes ? (double)s->minutes / (double)s->lifetimes / (24 * 60) : 0.0;
+}
+
+/**
+ * @brief --check: consistent counts, and care must pay off
+ */
+static bool check_stats(const bool *enabled, const balance_stats_t *total, uint32_t pets)
+{
+    bool ok = true;
+    for (uint32_t p = 0; p < POLICY_COUNT; p++) {
+        if (enabled[p]) ok &= check_counts(p, &total[p], pets);
+    }
+
+    if (enabled[POLICY_ATTENTIVE] && enabled[POLICY_NEGLECTFUL]) {
+        const balance_stats_t *good = &total[POLICY_ATTENTIVE];
+        const balance_stats_t *bad = &total[POLICY_NEGLECTFUL];
+        ok &= expect(mean_life_days(good) > mean_life_days(bad), "attentive",
+                     "mean life not longer than neglectful");
+        if (good->never_sick < good->lifetimes && bad->never_sick < bad->lifetimes) {
+            ok &= expect(sick_percentile(good, 50) >= sick_percentile(bad, 50), "attentive",
+                         "median first sickness earlier than neglectful");
+        }
+    }
+
+    printf("check: %s\n", ok ? "ok" : "FAILED");
+    return ok;
+}
+
+//=============================================================================
+// Main
+//=============================================================================
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--pets N] [--days N] [--threads N] [--seed N]\n"
+            "          [--policy <attentive|neglectful|night_owl>]... [--csv FILE] [--check]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    bool enabled[POLICY_COUNT] = {0};
+    bool any_policy = false;
+    uint32_t pets = 2000;
+    const char *csv = NULL;
+    bool check = false;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+
+    s_worker_count = cores > 0 ? (uint32_t)cores : 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--pets") == 0 && i + 1 < argc) {
+            pets = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--days") == 0 && i + 1 < argc) {
+            s_days = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            s_worker_count = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            s_seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csv = argv[++i];
+        } else if (strcmp(argv[i], "--check") == 0) {
+            check = true;
+        } else if (strcmp(argv[i], "--policy") == 0 && i + 1 < argc) {
+            const char *name = argv[++i];
+            uint32_t p;
+            for (p = 0; p < POLICY_COUNT && strcmp(s_policies[p].name, name) != 0; p++) {
+            }
+            if (p == POLICY_COUNT) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            enabled[p] = true;
+            any_policy = true;
+        } else {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (pets == 0 || s_days == 0 || s_days > MAX_DAYS ||
+        s_worker_count == 0 || s_worker_count > MAX_THREADS) {
+        fprintf(stderr, "need 1..%d days, 1..%d threads and at least one pet\n",
+                MAX_DAYS, MAX_THREADS);
+        return EXIT_FAILURE;
+    }
+    if (!any_policy) {
+        for (uint32_t p = 0; p < POLICY_COUNT; p++) enabled[p] = true;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (!run_pool(enabled, pets)) {
+        fprintf(stderr, "cannot set up the pool\n");
+        return EXIT_FAILURE;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    static balance_stats_t total[POLICY_COUNT];
+    merge_stats(total);
+    print_report(enabled, total);
+
+    uint64_t minutes = 0;
+    uint32_t tasks = 0, stolen = 0;
+    for (uint32_t p = 0; p < POLICY_COUNT; p++) minutes += total[p].minutes;
+    for (uint32_t w = 0; w < s_worker_count; w++) {
+        tasks += s_workers[w].executed;
+        stolen += s_workers[w].stolen;
+    }
+    double seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    double pet_days = (double)minutes / (24 * 60);
+    printf("\n%.0f pet-days in %.2f s on %lu threads: %.0f pet-days/s, %lu batches, %lu stolen\n",
+           pet_days, seconds, (unsigned long)s_worker_count,
+           seconds > 0 ? pet_days / seconds : 0.0, (unsigned long)tasks, (unsigned long)stolen);
+
+    if (csv != NULL && !write_csv(csv, enabled, total)) {
+        fprintf(stderr, "cannot write %s\n", csv);
+        return EXIT_FAILURE;
+    }
+    if (check && !check_stats(enabled, total, pets)) {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -107,7 +107,7 @@
 #define FRAME_TIME_IDLE_MS      (1000 / ANIMATION_FPS_IDLE)
 #define FRAME_TIME_ACTIVE_MS    (1000 / ANIMATION_FPS_ACTIVE)
 
-// Display brightness
+// Display brightness (runtime values come from settings.h)
 #define BRIGHTNESS_NORMAL       200
 #define BRIGHTNESS_DIM          50
 #define DIM_TIMEOUT_MS          30000  // 30 seconds
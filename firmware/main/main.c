@@ -20,13 +20,30 @@
 #include "esp_timer.h"
 #include "esp_log.h"
 #include "esp_system.h"
+#include "esp_random.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
 
 #include "display.h"
 #include "input.h"
 #include "pet.h"
+#include "pet_history.h"
 #include "game.h"
+#include "minigame.h"
+#include "leaderboard.h"
+#include "ui.h"
+#include "settings.h"
 #include "save_manager.h"
 #include "sprites.h"
+#include "latency.h"
+#include "trace.h"
+#include "telemetry.h"
+#include "replay.h"
+#include "sim.h"
+#include "runtime.h"
+#include "spsc_queue.h"
+#include "console.h"
 
 static const char *TAG = "main";
 
@@ -34,65 +51,480 @@ static const char *TAG = "main";
 // Configuration
 //=============================================================================
 
-#define GAME_TICK_MS        33      // ~30 FPS
+#define GAME_TICK_MS        SIM_TICK_MS  // ~30 FPS, one sim tick per frame
+#define MAX_CATCHUP_TICKS   4       // Sim ticks per period before time is dropped
 #define SAVE_INTERVAL_MS    (5 * 60 * 1000)  // Auto-save every 5 minutes
-#define INPUT_POLL_MS       20      // Button polling rate
+#define INPUT_POLL_MS       10      // Input task period (debounce, long press)
+#define LATENCY_REPORT_MS   (60 * 1000)  // Input latency, per-state CPU and task log
+#define MEMORY_REPORT_MS    2000    // Budget report this long after the tasks start
+#define WARP_SLICE_US       15000   // Console time warp per sim period (REQ-SW-054)
+
+// Input recording / replay (REQ-SW-051)
+#define REPLAY_RECORD       1       // Record input, stored with each auto-save
+#define REPLAY_PLAYBACK     0       // 1: replay the stored recording at boot
+#define REPLAY_SPEEDUP      8       // Sim ticks per sim period in playback
+#define NVS_KEY_REPLAY      "replay"
+
+// Tasks (REQ-SW-037), index = runtime task ID
+enum {
+    TASK_INPUT, TASK_SIM, TASK_RENDER, TASK_PERSIST,
+#if TRACE_ENABLED
+    TASK_TRACE,
+#endif
+#if CONSOLE_ENABLED
+    TASK_CONSOLE,
+#endif
+    TASK_COUNT
+};
+
+static void input_task(void *param);
+static void sim_task(void *param);
+static void render_task(void *param);
+static void persist_task(void *param);
+
+RUNTIME_STACK_DEFINE(s_input_stack, 3072);
+RUNTIME_STACK_DEFINE(s_sim_stack, 6144);
+RUNTIME_STACK_DEFINE(s_render_stack, 4096);
+RUNTIME_STACK_DEFINE(s_persist_stack, 4096);
+#if TRACE_ENABLED
+RUNTIME_STACK_DEFINE(s_trace_stack, 3072);
+#endif
+#if CONSOLE_ENABLED
+RUNTIME_STACK_DEFINE(s_console_stack, 4096);
+#endif
+
+static const runtime_task_def_t s_tasks[TASK_COUNT] = {
+    [TASK_INPUT]   = { "input",   input_task,   s_input_stack,   sizeof(s_input_stack),   10, 0 },
+    [TASK_SIM]     = { "sim",     sim_task,     s_sim_stack,     sizeof(s_sim_stack),      6, 0 },
+    [TASK_RENDER]  = { "render",  render_task,  s_render_stack,  sizeof(s_render_stack),   5, 1 },
+    [TASK_PERSIST] = { "persist", persist_task, s_persist_stack, sizeof(s_persist_stack),  2, 0 },
+#if TRACE_ENABLED
+    [TASK_TRACE]   = { "trace",   trace_task,   s_trace_stack,   sizeof(s_trace_stack),    1, 0 },
+#endif
+#if CONSOLE_ENABLED
+    [TASK_CONSOLE] = { "console", console_task, s_console_stack, sizeof(s_console_stack),  3, 0 },
+#endif
+};
+
+// Memory budget (REQ-SW-039): every large buffer, static unless marked as
+// allocated at boot; the task stacks are added by runtime_memory_report()
+static const runtime_mem_def_t s_memory[] = {
+    { "spi buffer",  DISPLAY_SPI_BUFFER_BYTES },
+    { "framebuffer", DISPLAY_FRAMEBUFFER_BYTES, true },    // display_init()
+    { "pet cache",   GAME_PET_CACHE_BYTES },
+    { "minigame",    MINIGAME_RAM_BYTES },      // Simulation and render arenas
+    { "ui nodes",    UI_RAM_BYTES },
+    { "records",     sizeof(leaderboard_record_t) + sizeof(settings_t) },   // Leaderboard, settings
+    { "replay",      2 * REPLAY_MAX_SIZE },     // Recording and its save copy
+    { "pet history", PET_HISTORY_RAM_BYTES },
+    { "telemetry",   TELEMETRY_RAM_BYTES },
+    { "latency",     LATENCY_RAM_BYTES },
+    { "trace",       TRACE_RAM_BYTES },
+};
+
+/**
+ * @brief Work for the persistence task
+ */
+typedef struct {
+    bool save_pet;              // Save the published pet snapshot
+    uint16_t replay_len;        // Recording copied to s_replay_copy, 0 = none
+    uint16_t replay_events;     // Its event count
+} persist_job_t;
+
+#if CONSOLE_ENABLED
+/**
+ * @brief Console command run on the simulation task (REQ-SW-054)
+ */
+typedef struct {
+    console_fn_t fn;
+    int argc;
+    char **argv;
+    int ret;
+} console_job_t;
+#endif
 
 //=============================================================================
 // Static State
 //=============================================================================
 
 static uint32_t s_last_save_ms = 0;
-static uint32_t s_last_tick_ms = 0;
+static uint32_t s_last_latency_ms = 0;
+static uint32_t s_last_input_ms = 0;
+static uint32_t s_last_render_ms = 0;
+static int64_t s_last_frame_us = 0;     // Last frame handoff (telemetry)
+
+// Frame handoff: the sim task copies the frame view (game_publish_frame)
+// and publishes frame s_frame_seq; the view and the display belong to the
+// render task until it stores s_frame_done. The sim keeps ticking on its
+// own state meanwhile and publishes the next view once the frame is done.
+static atomic_uint s_frame_seq;
+static atomic_uint s_frame_done;
+static game_state_t s_frame_state;      // State of the frame in flight (telemetry)
+static uint32_t s_frames_deferred = 0;  // Frames due while the previous one was drawn
+
+// Sim -> persistence
+SPSC_QUEUE_DEFINE(s_persist_queue, persist_job_t, 4);
+static atomic_bool s_save_in_flight;    // s_replay_copy in use
+static uint8_t s_replay_copy[REPLAY_MAX_SIZE];
+static atomic_int s_replay_saved = -1;  // Events in the recording last written, -1: none yet
+
+#if CONSOLE_ENABLED
+// Console -> sim: the console task waits for each job it posts
+SPSC_QUEUE_DEFINE(s_console_queue, console_job_t *, 2);
+#endif
 
 //=============================================================================
-// Button Callback
+// Helper Functions
 //=============================================================================
 
-static void button_callback(button_id_t button, button_event_t event)
+static inline uint32_t get_ms(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+/**
+ * @brief Hand a live input event to the game, recording it for replay
+ */
+static void dispatch_input(button_id_t button, button_event_t event)
 {
+    replay_record_event(button, event);
     game_handle_input(button, event);
 }
 
+/**
+ * @brief Advance the simulation by one fixed tick
+ */
+static void run_tick(void)
+{
+    // Recorded events go in on the tick they were originally handled on
+    button_id_t button;
+    button_event_t event;
+    while (replay_next_event(&button, &event)) {
+        game_handle_input(button, event);
+    }
+
+    game_update(GAME_TICK_MS);
+    sim_step();
+}
+
+/**
+ * @brief Queue an auto-save for the persistence task
+ * @return false if the previous save is still being written
+ */
+static bool request_save(void)
+{
+    if (atomic_load_explicit(&s_save_in_flight, memory_order_acquire)) return false;
+
+    // The recording changes only with new events and not at all once
+    // full, so the blob is rewritten only when its event count moved
+    persist_job_t job = { .save_pet = true };
+    uint16_t events = replay_event_count();
+    if (REPLAY_RECORD && events != atomic_load_explicit(&s_replay_saved, memory_order_relaxed)) {
+        size_t len;
+        const void *data = replay_get_data(&len);
+        memcpy(s_replay_copy, data, len);
+        job.replay_len = (uint16_t)len;
+        job.replay_events = events;
+    }
+
+    atomic_store_explicit(&s_save_in_flight, true, memory_order_relaxed);
+    if (!spsc_push(&s_persist_queue, &job)) {
+        atomic_store_explicit(&s_save_in_flight, false, memory_order_relaxed);
+        return false;
+    }
+    xTaskNotifyGive(runtime_task_handle(TASK_PERSIST));
+    return true;
+}
+
+/**
+ * @brief Load the stored recording and start playing it
+ *
+ * Runs at boot, before the persistence task could use s_replay_copy.
+ */
+static esp_err_t start_playback(void)
+{
+    size_t len = sizeof(s_replay_copy);
+    esp_err_t ret = save_manager_read_blob(NVS_KEY_REPLAY, s_replay_copy, &len);
+    if (ret == ESP_OK) {
+        ret = replay_load_data(s_replay_copy, len);
+    }
+
+    if (ret == ESP_OK) {
+        ret = replay_play_start();
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "No usable recording, running live");
+        return ret;
+    }
+
+    // Recording starts on the splash screen at the restored sim time
+    return game_init();
+}
+
+_Static_assert(GAME_STATE_COUNT <= TELEMETRY_MAX_STATES, "telemetry cannot hold every game state");
+
+static const char *telemetry_state_name(int state)
+{
+    return game_state_name((game_state_t)state);
+}
+
+#if CONSOLE_ENABLED
+/**
+ * @brief Console executor: run a command on the sim task and wait for it
+ *
+ * Commands change game state, which only the sim task may touch.
+ */
+static int run_on_sim_task(console_fn_t fn, int argc, char **argv)
+{
+    console_job_t job = { .fn = fn, .argc = argc, .argv = argv };
+    console_job_t *ptr = &job;
+
+    if (!spsc_push(&s_console_queue, &ptr)) {
+        return -1;      // Cannot happen with one waiting producer
+    }
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    return job.ret;
+}
+
+/**
+ * @brief Run posted console commands and a slice of a running time warp
+ */
+static void run_console_jobs(void)
+{
+    console_job_t *job;
+    while (spsc_pop(&s_console_queue, &job)) {
+        job->ret = job->fn(job->argc, job->argv);
+        xTaskNotifyGive(runtime_task_handle(TASK_CONSOLE));
+    }
+    if (console_warp_active()) {
+        console_warp_step(WARP_SLICE_US);
+    }
+}
+#endif // CONSOLE_ENABLED
+
+static inline bool frame_in_flight(void)
+{
+    return atomic_load_explicit(&s_frame_seq, memory_order_relaxed) !=
+           atomic_load_explicit(&s_frame_done, memory_order_acquire);
+}
+
 //=============================================================================
 // Task Functions
 //=============================================================================
 
 /**
- * @brief Main game loop task
+ * @brief Input task: turns ISR edges into queued events (highest priority)
+ */
+static void input_task(void *param)
+{
+    TickType_t wake = xTaskGetTickCount();
+
+    while (1) {
+        runtime_busy_begin(TASK_INPUT);
+        input_update();
+        runtime_busy_end(TASK_INPUT);
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(INPUT_POLL_MS));
+    }
+}
+
+/**
+ * @brief Simulation task: input dispatch, fixed sim ticks, frame pacing
+ *
+ * Owns game state at all times and ticks every period, also while the
+ * render task draws; a frame that falls due meanwhile is published once
+ * the previous one is done.
  */
-static void game_task(void *param)
+static void sim_task(void *param)
 {
-    ESP_LOGI(TAG, "Game task started");
+    ESP_LOGI(TAG, "Simulation task started");
 
-    uint32_t last_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    TickType_t wake = xTaskGetTickCount();
+    uint32_t last_ms = get_ms();
+    uint32_t lag_ms = 0;
+    uint32_t replay_start_ms = last_ms;
+    uint32_t replay_start_tick = sim_get_tick();
+    uint32_t replay_frames = 0;
+    bool playing = false;
+    bool frame_wanted = false;          // Due, waiting for the render task
 
     while (1) {
-        uint32_t now = (uint32_t)(esp_timer_get_time() / 1000);
-        uint32_t delta = now - last_ms;
+        if (playing) {
+            vTaskDelay(1);  // Playback runs flat out; frames show where it is
+            wake = xTaskGetTickCount();
+        } else {
+            vTaskDelayUntil(&wake, pdMS_TO_TICKS(GAME_TICK_MS));
+        }
+
+        uint32_t now = get_ms();
+        lag_ms += now - last_ms;
         last_ms = now;
 
-        // Update input
-        input_update();
+        runtime_busy_begin(TASK_SIM);
+        int64_t work_start_us = esp_timer_get_time();
+        playing = (replay_get_mode() == REPLAY_PLAYING);
+
+        // Dispatch queued input events in order
+        input_event_t ev;
+        bool handled_input = false;
+        while (input_get_event(&ev)) {
+            s_last_input_ms = now;  // Any press wakes the backlight
+            if (playing) continue;  // Live input ignored during playback
+            latency_begin(ev.trace_id, ev.time_us);
+            dispatch_input(ev.button, ev.event);
+            latency_end();
+            handled_input = true;
+        }
+        settings_update_backlight(now - s_last_input_ms);
+#if CONSOLE_ENABLED
+        run_console_jobs();
+#endif
+
+        // Update game state in fixed sim ticks
+        if (playing) {
+            for (int i = 0; i < REPLAY_SPEEDUP && !replay_is_finished(); i++) {
+                run_tick();
+            }
+            lag_ms = 0;
+        } else {
+            int ticks = 0;
+            while (lag_ms >= GAME_TICK_MS && ticks < MAX_CATCHUP_TICKS) {
+                run_tick();
+                lag_ms -= GAME_TICK_MS;
+                ticks++;
+            }
+            if (lag_ms >= GAME_TICK_MS) {
+                lag_ms = 0;  // Overloaded: slow the game down rather than spiral
+            }
+        }
+        pet_publish_snapshot();
+
+        if (playing && replay_is_finished()) {
+            uint32_t wall_ms = get_ms() - replay_start_ms;
+            uint32_t ticks = sim_get_tick() - replay_start_tick;
+            ESP_LOGI(TAG, "Replay done: %lu ticks (%lu ms sim) in %lu ms, %lu frames",
+                     (unsigned long)ticks, (unsigned long)(ticks * GAME_TICK_MS),
+                     (unsigned long)wall_ms, (unsigned long)replay_frames);
+            replay_stop();
+        }
 
-        // Update game state
-        game_update(delta);
+        // Auto-save check (never overwrite the real save with a replay)
+        if (!REPLAY_PLAYBACK && game_is_running() && (now - s_last_save_ms) > SAVE_INTERVAL_MS) {
+            if (request_save()) {
+                s_last_save_ms = now;
+            }
+        }
 
-        // Render frame
-        game_render();
+        // Input latency, per-state CPU and per-task report
+        if ((now - s_last_latency_ms) > LATENCY_REPORT_MS) {
+            latency_report();
+            game_report_profile();
+            telemetry_report(true);
+            runtime_report();
+            pet_snapshot_stats_t snap;
+            pet_get_snapshot_stats(&snap);
+            ESP_LOGI(TAG, "Frames deferred for a frame in flight: %lu; "
+                     "pet snapshots: %lu published, %lu read, %lu retries (max %lu)",
+                     (unsigned long)s_frames_deferred, (unsigned long)snap.publishes,
+                     (unsigned long)snap.reads, (unsigned long)snap.retries,
+                     (unsigned long)snap.max_retries);
+            s_frames_deferred = 0;
+            s_last_latency_ms = now;
+        }
 
-        // Auto-save check
-        if (game_is_running() && (now - s_last_save_ms) > SAVE_INTERVAL_MS) {
-            save_manager_save();
-            s_last_save_ms = now;
+        // Hand a frame to the render task, at most at the frame cap except
+        // to show input (half a tick of slack so timer jitter does not
+        // halve a 30 FPS cap). One due while the previous frame is still
+        // drawn waits; the sim does not.
+        game_state_t state = game_get_state();
+        uint32_t frame_ms = settings_frame_interval_ms(state == GAME_STATE_PLAY);
+        frame_wanted |= playing || handled_input ||
+                        (now - s_last_render_ms) + GAME_TICK_MS / 2 >= frame_ms;
+        bool render = frame_wanted && !frame_in_flight();
+        if (frame_wanted && !render) {
+            s_frames_deferred++;
+        }
+        if (render) {
+            s_frame_state = state;
+            game_publish_frame();
+            latency_frame_queue();
         }
 
-        // Maintain frame rate
-        int32_t sleep_time = GAME_TICK_MS - (int32_t)delta;
-        if (sleep_time > 0) {
-            vTaskDelay(pdMS_TO_TICKS(sleep_time));
-        } else {
-            vTaskDelay(1);  // Yield at minimum
+        int64_t now_us = esp_timer_get_time();
+        telemetry_record(state, TELEMETRY_SIM, (uint32_t)(now_us - work_start_us));
+        runtime_busy_end(TASK_SIM);
+
+        if (render) {
+            // A frame is late once it misses its slot by half a tick: the
+            // sim period overran or the previous frame was still drawn
+            if (s_last_frame_us != 0 && !playing) {
+                uint32_t interval_us = (uint32_t)(now_us - s_last_frame_us);
+                telemetry_record(state, TELEMETRY_FRAME, interval_us);
+                if (interval_us > (frame_ms + GAME_TICK_MS / 2) * 1000) {
+                    telemetry_missed(state);
+                }
+            }
+            s_last_frame_us = now_us;
+            s_last_render_ms = now;
+            frame_wanted = false;
+            if (playing) replay_frames++;
+            atomic_fetch_add_explicit(&s_frame_seq, 1, memory_order_release);
+            xTaskNotifyGive(runtime_task_handle(TASK_RENDER));
+        }
+    }
+}
+
+/**
+ * @brief Render task (core 1): draws each frame view the sim task hands over
+ */
+static void render_task(void *param)
+{
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        unsigned seq = atomic_load_explicit(&s_frame_seq, memory_order_acquire);
+
+        runtime_busy_begin(TASK_RENDER);
+        game_state_t state = s_frame_state;
+        display_stats_t spi_before, spi_after;
+        display_get_stats(&spi_before);
+        int64_t start_us = esp_timer_get_time();
+
+        latency_frame_begin();
+        display_start_frame();
+        game_render();
+        display_end_frame();
+        latency_frame_end();
+
+        telemetry_record(state, TELEMETRY_RENDER, (uint32_t)(esp_timer_get_time() - start_us));
+        display_get_stats(&spi_after);
+        telemetry_record(state, TELEMETRY_SPI, spi_after.busy_us - spi_before.busy_us);
+        runtime_busy_end(TASK_RENDER);
+
+        atomic_store_explicit(&s_frame_done, seq, memory_order_release);
+    }
+}
+
+/**
+ * @brief Persistence task (lowest priority): NVS writes off the frame path
+ */
+static void persist_task(void *param)
+{
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        persist_job_t job;
+        while (spsc_pop(&s_persist_queue, &job)) {
+            runtime_busy_begin(TASK_PERSIST);
+            if (job.save_pet) {
+                pet_state_t pet;
+                pet_get_snapshot(&pet);
+                save_manager_save_state(&pet);
+            }
+            if (job.replay_len &&
+                save_manager_write_blob(NVS_KEY_REPLAY, s_replay_copy, job.replay_len) == ESP_OK) {
+                atomic_store_explicit(&s_replay_saved, job.replay_events, memory_order_relaxed);
+            }
+            atomic_store_explicit(&s_save_in_flight, false, memory_order_release);
+            runtime_busy_end(TASK_PERSIST);
         }
     }
 }
@@ -116,6 +548,11 @@ void app_main(void)
         return;
     }
 
+    // Map asset pack (falls back to built-in sprites and font)
+    if (sprites_init() == ESP_OK && sprites_get_font() != NULL) {
+        display_set_font(sprites_get_font());
+    }
+
     // Show startup message
     display_fill(0x0000);
     display_draw_string(30, 50, "DOLPHIN PET", 0xFFFF, 0x0000, 2);
@@ -128,7 +565,14 @@ void app_main(void)
         ESP_LOGE(TAG, "Input init failed!");
         return;
     }
-    input_register_callback(button_callback);
+
+#if TRACE_ENABLED
+    // Profiling zones stream on their own UART; the game runs without it
+    trace_init();
+#endif
+
+    // Simulation clock and PRNG used by all game logic
+    sim_init(esp_random());
 
     // Initialize pet system
     ESP_LOGI(TAG, "Initializing pet system...");
@@ -145,6 +589,9 @@ void app_main(void)
         ESP_LOGW(TAG, "Save manager init failed, saves disabled");
     }
 
+    // Frame-time histograms per game state
+    telemetry_init(telemetry_state_name);
+
     // Initialize game
     ESP_LOGI(TAG, "Initializing game...");
     ret = game_init();
@@ -154,6 +601,7 @@ void app_main(void)
     }
 
     // Try to load saved game
+    bool loaded = false;
     if (save_manager_exists()) {
         ESP_LOGI(TAG, "Loading saved game...");
         ret = save_manager_load();
@@ -165,28 +613,48 @@ void app_main(void)
                 pet_apply_time_away(offline_min);
             }
 
-            // Skip splash, go directly to game
-            game_handle_input(BUTTON_RIGHT, BUTTON_EVENT_CLICK);
+            loaded = true;
         } else {
             ESP_LOGW(TAG, "Failed to load save, starting new game");
         }
     }
 
-    s_last_save_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    if (REPLAY_PLAYBACK && start_playback() == ESP_OK) {
+        // The recording brings its own start state and splash skip
+    } else {
+        if (REPLAY_RECORD) {
+            replay_record_start();
+        }
+        if (loaded) {
+            // Skip splash, go directly to game
+            dispatch_input(BUTTON_RIGHT, BUTTON_EVENT_CLICK);
+        }
+    }
+
+    s_last_save_ms = get_ms();
+    s_last_input_ms = s_last_save_ms;
+    s_last_latency_ms = s_last_save_ms;
+    pet_publish_snapshot();
+
+#if CONSOLE_ENABLED
+    // Debug shell on UART0; its commands run on the sim task
+    if (console_init() == ESP_OK) {
+        console_set_executor(run_on_sim_task);
+    }
+#endif
 
     ESP_LOGI(TAG, "Free heap after init: %lu bytes", (unsigned long)esp_get_free_heap_size());
-    ESP_LOGI(TAG, "Starting game loop...");
-
-    // Create game task
-    xTaskCreatePinnedToCore(
-        game_task,
-        "game_task",
-        8192,           // Stack size
-        NULL,
-        5,              // Priority
-        NULL,
-        0               // Core 0
-    );
+    ESP_LOGI(TAG, "Starting tasks...");
+
+    ret = runtime_start(s_tasks, TASK_COUNT);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Task start failed!");
+        return;
+    }
+
+    // Let every task run a few frames so the stack high-water marks mean something
+    vTaskDelay(pdMS_TO_TICKS(MEMORY_REPORT_MS));
+    runtime_memory_report(s_memory, sizeof(s_memory) / sizeof(s_memory[0]));
 
     // Main task can exit, FreeRTOS will keep running
     ESP_LOGI(TAG, "Main task complete, game running");
@@ -0,0 +1,314 @@
+#!/usr/bin/env python3
+"""
+ESP32 Tamagotchi - Host asset compiler
+
+REQ-SW-034: Asset Pack Partition
+Builds the asset pack that is flashed to the "assets" partition and
+memory-mapped by the sprites component (see asset_pack.h for the layout).
+
+By default every asset is taken from the built-in C arrays (sprites.c and
+the display font), so the pack matches the firmware pixel for pixel. Any
+sprite can be replaced with a PNG (needs Pillow):
+
+    python tools/asset_compiler.py -o build/assets.bin \
+        --override SPRITE_ASSET_BABY_IDLE_1=art/baby_idle_1.png
+
+Flash the result with:
+
+    parttool.py -p PORT write_partition --partition-name assets --input build/assets.bin
+
+REQ-SW-063: with --masks it also writes the 1-bit collision masks of the
+sprites listed in MASKS as a C source (see sprite_mask.h). The firmware
+build generates this file itself; overrides apply to masks as well.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+COMPONENTS = os.path.join(ROOT, "firmware", "components")
+SPRITES_H = os.path.join(COMPONENTS, "sprites", "include", "sprites.h")
+ASSET_PACK_H = os.path.join(COMPONENTS, "sprites", "include", "asset_pack.h")
+SPRITES_C = os.path.join(COMPONENTS, "sprites", "sprites.c")
+DISPLAY_C = os.path.join(COMPONENTS, "display", "display.c")
+
+ASSET_TYPE_RGB565 = 0
+ASSET_TYPE_FONT_6X8 = 1
+
+HEADER_FMT = "<IHHII"    # magic, version, entry_count, total_size, crc32
+ENTRY_FMT = "<HBBHHII"   # id, type, reserved, width, height, offset, size
+
+# Asset ID -> (source, type, width, height). Source is a C array name in
+# sprites.c (or display.c for the font). Width/height may name a macro
+# from sprites.h.
+MANIFEST = {
+    "SPRITE_ASSET_EGG_1":          ("sprite_egg_1", ASSET_TYPE_RGB565, "DOLPHIN_EGG_W", "DOLPHIN_EGG_H"),
+    "SPRITE_ASSET_EGG_2":          ("sprite_egg_2", ASSET_TYPE_RGB565, "DOLPHIN_EGG_W", "DOLPHIN_EGG_H"),
+    "SPRITE_ASSET_EGG_3":          ("sprite_egg_3", ASSET_TYPE_RGB565, "DOLPHIN_EGG_W", "DOLPHIN_EGG_H"),
+    "SPRITE_ASSET_BABY_IDLE_1":    ("sprite_baby_idle_1", ASSET_TYPE_RGB565, "DOLPHIN_BABY_W", "DOLPHIN_BABY_H"),
+    "SPRITE_ASSET_BABY_IDLE_2":    ("sprite_baby_idle_2", ASSET_TYPE_RGB565, "DOLPHIN_BABY_W", "DOLPHIN_BABY_H"),
+    "SPRITE_ASSET_BABY_IDLE_3":    ("sprite_baby_idle_3", ASSET_TYPE_RGB565, "DOLPHIN_BABY_W", "DOLPHIN_BABY_H"),
+    "SPRITE_ASSET_BABY_IDLE_4":    ("sprite_baby_idle_4", ASSET_TYPE_RGB565, "DOLPHIN_BABY_W", "DOLPHIN_BABY_H"),
+    "SPRITE_ASSET_ICON_HUNGER":    ("icon_hunger_full", ASSET_TYPE_RGB565, "ICON_SIZE", "ICON_SIZE"),
+    "SPRITE_ASSET_ICON_HAPPY":     ("icon_happy_full", ASSET_TYPE_RGB565, "ICON_SIZE", "ICON_SIZE"),
+    "SPRITE_ASSET_ICON_HEALTH":    ("icon_health_full", ASSET_TYPE_RGB565, "ICON_SIZE", "ICON_SIZE"),
+    "SPRITE_ASSET_ICON_ENERGY":    ("icon_energy_full", ASSET_TYPE_RGB565, "ICON_SIZE", "ICON_SIZE"),
+    "SPRITE_ASSET_ICON_ATTENTION": ("icon_attention", ASSET_TYPE_RGB565, "ICON_SIZE", "ICON_SIZE"),
+    "SPRITE_ASSET_FONT_6X8":       ("s_font_6x8", ASSET_TYPE_FONT_6X8, "ASSET_FONT_GLYPHS", 8),
+    "SPRITE_ASSET_MG_WAVE":        ("sprite_mg_wave", ASSET_TYPE_RGB565, "WAVE_W", "WAVE_H"),
+    "SPRITE_ASSET_MG_ROCK":        ("sprite_mg_rock", ASSET_TYPE_RGB565, "ROCK_W", "ROCK_H"),
+    "SPRITE_ASSET_MG_FISH":        ("sprite_mg_fish", ASSET_TYPE_RGB565, "FOOD_FISH_W", "FOOD_FISH_H"),
+}
+
+# Sprites that get a collision mask (at most SPRITE_MASK_MAX_W wide)
+MASKS = [
+    "SPRITE_ASSET_BABY_IDLE_1",
+    "SPRITE_ASSET_BABY_IDLE_2",
+    "SPRITE_ASSET_BABY_IDLE_3",
+    "SPRITE_ASSET_BABY_IDLE_4",
+    "SPRITE_ASSET_MG_WAVE",
+    "SPRITE_ASSET_MG_ROCK",
+    "SPRITE_ASSET_MG_FISH",
+]
+MASK_MAX_W = 32
+
+
+def strip_comments(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    return re.sub(r"//[^\n]*", "", text)
+
+
+def read_defines(path):
+    """Collect simple '#define NAME value' macros from a C file."""
+    defines = {}
+    with open(path) as f:
+        for line in f:
+            m = re.match(r"\s*#define\s+(\w+)\s+([^\s/]+)", line)
+            if m:
+                defines[m.group(1)] = m.group(2)
+    return defines
+
+
+def eval_token(token, defines):
+    seen = set()
+    while token in defines and token not in seen:
+        seen.add(token)
+        token = defines[token]
+    return int(token.strip("()"), 0)
+
+
+def read_enum(path, enum_name):
+    """Return {member: value} for a C typedef enum."""
+    text = strip_comments(open(path).read())
+    m = re.search(r"typedef\s+enum\s*\{(.*?)\}\s*" + enum_name + r"\s*;", text, re.S)
+    if not m:
+        sys.exit("error: enum %s not found in %s" % (enum_name, path))
+    values, next_value = {}, 0
+    for item in m.group(1).split(","):
+        item = item.strip()
+        if not item:
+            continue
+        name, _, value = item.partition("=")
+        name = name.strip()
+        if value.strip():
+            next_value = int(value.strip(), 0)
+        values[name] = next_value
+        next_value += 1
+    return values
+
+
+def read_array(path, name, defines):
+    """Return the integer elements of a C array initialiser."""
+    text = strip_comments(open(path).read())
+    m = re.search(r"\b" + re.escape(name) + r"\s*\[\s*\]\s*=\s*\{(.*?)\};", text, re.S)
+    if not m:
+        sys.exit("error: array %s not found in %s" % (name, path))
+    return [eval_token(tok.strip(), defines) for tok in m.group(1).split(",") if tok.strip()]
+
+
+def load_png(path, width, height, transparent):
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit("error: PNG overrides need Pillow (pip install pillow)")
+    img = Image.open(path).convert("RGBA")
+    if img.size != (width, height):
+        sys.exit("error: %s is %dx%d, expected %dx%d" % (path, img.size[0], img.size[1], width, height))
+    pixels = []
+    for r, g, b, a in img.getdata():
+        if a < 128:
+            pixels.append(transparent)
+        else:
+            pixels.append(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3))
+    return pixels
+
+
+def sprite_defines():
+    defines = read_defines(SPRITES_H)
+    defines.update(read_defines(SPRITES_C))
+    defines.update(read_defines(ASSET_PACK_H))
+    return defines
+
+
+def sprite_pixels(name, overrides, defines):
+    """Return (width, height, RGB565 pixels) of a sprite asset."""
+    source, _, w, h = MANIFEST[name]
+    width = eval_token(str(w), defines)
+    height = eval_token(str(h), defines)
+    if name in overrides:
+        pixels = load_png(overrides[name], width, height, eval_token("SPRITE_TRANSPARENT", defines))
+    else:
+        pixels = read_array(SPRITES_C, source, defines)
+    if len(pixels) != width * height:
+        sys.exit("error: %s has %d pixels, expected %d" % (source, len(pixels), width * height))
+    return width, height, pixels
+
+
+def align(value, alignment):
+    return (value + alignment - 1) // alignment * alignment
+
+
+def build_pack(overrides):
+    ids = read_enum(SPRITES_H, "sprite_asset_t")
+    pack_defs = read_defines(ASSET_PACK_H)
+    sprite_defs = sprite_defines()
+
+    magic = eval_token("ASSET_PACK_MAGIC", pack_defs)
+    version = eval_token("ASSET_PACK_VERSION", pack_defs)
+    alignment = eval_token("ASSET_PACK_ALIGN", pack_defs)
+
+    missing = [n for n in ids if n != "SPRITE_ASSET_COUNT" and n not in MANIFEST]
+    if missing:
+        sys.exit("error: no manifest entry for %s" % ", ".join(missing))
+
+    assets = []
+    for name, (source, kind, w, h) in MANIFEST.items():
+        if name not in ids:
+            sys.exit("error: %s is not in sprite_asset_t" % name)
+        if kind == ASSET_TYPE_FONT_6X8:
+            width = eval_token(str(w), sprite_defs)
+            height = eval_token(str(h), sprite_defs)
+            glyphs = read_array(DISPLAY_C, source, {})
+            blob = bytes(glyphs)
+            if len(blob) != width * 6:
+                sys.exit("error: font has %d bytes, expected %d" % (len(blob), width * 6))
+        else:
+            width, height, pixels = sprite_pixels(name, overrides, sprite_defs)
+            blob = struct.pack("<%dH" % len(pixels), *pixels)
+
+        assets.append((ids[name], kind, width, height, blob))
+
+    header_size = struct.calcsize(HEADER_FMT)
+    entry_size = struct.calcsize(ENTRY_FMT)
+    offset = align(header_size + entry_size * len(assets), alignment)
+
+    index, data = b"", b""
+    for asset_id, kind, width, height, blob in sorted(assets):
+        index += struct.pack(ENTRY_FMT, asset_id, kind, 0, width, height, offset, len(blob))
+        padded = blob + b"\0" * (align(len(blob), alignment) - len(blob))
+        data += padded
+        offset += len(padded)
+
+    body = index
+    body += b"\0" * (align(header_size + len(index), alignment) - header_size - len(index))
+    body += data
+
+    total = header_size + len(body)
+    crc = zlib.crc32(body) & 0xFFFFFFFF
+    header = struct.pack(HEADER_FMT, magic, version, len(assets), total, crc)
+    return header + body, assets
+
+
+def build_masks(overrides):
+    """Return the C source of the collision mask table."""
+    defines = sprite_defines()
+    transparent = eval_token("SPRITE_TRANSPARENT", defines)
+
+    arrays, entries = [], []
+    for name in MASKS:
+        width, height, pixels = sprite_pixels(name, overrides, defines)
+        if width > MASK_MAX_W:
+            sys.exit("error: %s is %d wide, masks are at most %d" % (name, width, MASK_MAX_W))
+        rows = []
+        for y in range(height):
+            word = 0
+            for x in range(width):
+                if pixels[y * width + x] != transparent:
+                    word |= 1 << (31 - x)
+            rows.append(word)
+
+        array = "s_mask_" + name[len("SPRITE_ASSET_"):].lower()
+        lines = ["static const uint32_t %s[%d] = {" % (array, height)]
+        for i in range(0, height, 4):
+            lines.append("    " + " ".join("0x%08X," % word for word in rows[i:i + 4]))
+        lines.append("};")
+        arrays.append("\n".join(lines))
+        entries.append("    [%s] = { %d, %d, %s }," % (name, width, height, array))
+
+    return "\n".join([
+        "/**",
+        " * @file sprite_masks.c",
+        " * @brief Sprite collision masks, generated by tools/asset_compiler.py",
+        " *",
+        " * REQ-SW-063: Pixel-accurate Mini-game Collision",
+        " * Do not edit: regenerated from sprites.c on every build.",
+        " */",
+        "",
+        '#include "sprite_mask.h"',
+        "",
+        "\n\n".join(arrays),
+        "",
+        "const sprite_mask_t sprite_masks[SPRITE_ASSET_COUNT] = {",
+        "\n".join(entries),
+        "};",
+        "",
+    ])
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build the ESP32 Tamagotchi asset pack")
+    parser.add_argument("-o", "--output", help="output pack file")
+    parser.add_argument("--masks", metavar="FILE", help="output C source with collision masks")
+    parser.add_argument("--override", action="append", default=[], metavar="ASSET=PNG",
+                        help="replace a sprite with a PNG image")
+    parser.add_argument("-v", "--verbose", action="store_true", help="list packed assets")
+    args = parser.parse_args()
+    if not args.output and not args.masks:
+        parser.error("nothing to do: give -o and/or --masks")
+
+    overrides = {}
+    for item in args.override:
+        name, _, path = item.partition("=")
+        if not path:
+            sys.exit("error: --override expects ASSET=PNG")
+        overrides[name] = path
+
+    if args.masks:
+        source = build_masks(overrides)
+        os.makedirs(os.path.dirname(os.path.abspath(args.masks)), exist_ok=True)
+        with open(args.masks, "w") as f:
+            f.write(source)
+        print("Collision masks: %d sprites -> %s" % (len(MASKS), args.masks))
+
+    if not args.output:
+        return
+
+    pack, assets = build_pack(overrides)
+
+    out_dir = os.path.dirname(os.path.abspath(args.output))
+    os.makedirs(out_dir, exist_ok=True)
+    with open(args.output, "wb") as f:
+        f.write(pack)
+
+    if args.verbose:
+        for asset_id, kind, width, height, blob in sorted(assets):
+            print("  %2d  type=%d  %3dx%-3d  %5d bytes" % (asset_id, kind, width, height, len(blob)))
+    print("Asset pack: %d assets, %d bytes -> %s" % (len(assets), len(pack), args.output))
+
+
+if __name__ == "__main__":
+    main()
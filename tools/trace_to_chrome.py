@@ -0,0 +1,202 @@
+#!/usr/bin/env python3
+"""
+ESP32 Tamagotchi - Profiling zone trace converter
+
+REQ-SW-052: Profiling Zones
+Converts the binary zone stream of a `idf.py -DTRACE=1` build (see
+trace.h for the packet layout) into Chrome trace JSON, one track per
+core, for chrome://tracing or https://ui.perfetto.dev.
+
+Capture from the trace UART with any serial tool, or let this script
+read the port for a while (needs pyserial):
+
+    python tools/trace_to_chrome.py --port /dev/ttyUSB1 --seconds 10 -o trace.json
+    python tools/trace_to_chrome.py capture.bin -o trace.json
+
+The capture may start mid-stream: the converter resynchronises on the
+packet header and skips events until the zone table and the first time
+sync of each core have arrived.
+"""
+
+import argparse
+import json
+import struct
+import sys
+import time
+
+SYNC = b"\xa5\x5a"
+PKT_INFO = 1
+PKT_EVENTS = 2
+
+PHASE_BEGIN = 0
+PHASE_END = 1
+PHASE_SYNC = 2
+PHASE_SYNC_US = 3
+
+EVENT_FMT = "<IBB"       # cycles, zone id, phase
+
+
+def read_port(port, seconds, baud):
+    try:
+        import serial
+    except ImportError:
+        sys.exit("error: --port needs pyserial (pip install pyserial)")
+    data = bytearray()
+    with serial.Serial(port, baud, timeout=0.1) as ser:
+        end = time.monotonic() + seconds
+        while time.monotonic() < end:
+            data += ser.read(4096)
+    return bytes(data)
+
+
+def packets(data):
+    """Yield (type, payload) for every packet with a valid checksum."""
+    pos = 0
+    bad = 0
+    while True:
+        pos = data.find(SYNC, pos)
+        if pos < 0 or pos + 5 > len(data):
+            break
+        kind = data[pos + 2]
+        length = struct.unpack_from("<H", data, pos + 3)[0]
+        end = pos + 5 + length
+        if end >= len(data):
+            pos += 1        # Truncated last packet, or a false sync
+            continue
+        payload = data[pos + 5:end]
+        if sum(payload) & 0xFF != data[end] or kind not in (PKT_INFO, PKT_EVENTS):
+            bad += 1
+            pos += 1        # False sync inside a payload, or a damaged packet
+            continue
+        yield kind, payload
+        pos = end + 1
+    if bad:
+        print("warning: skipped %d damaged packets" % bad, file=sys.stderr)
+
+
+class CoreTrack:
+    """Turns one core's cycle stamps into microseconds and zones into spans."""
+
+    def __init__(self, core):
+        self.core = core
+        self.sync_cycles = None     # CCOUNT at the last sync
+        self.sync_us = None         # Unwrapped esp_timer time at the last sync
+        self.pending = None         # SYNC seen, waiting for its SYNC_US
+        self.stack = []             # Open zones: (zone id, start us)
+        self.dropped = 0
+
+    def sync(self, raw_us):
+        if self.sync_us is None:
+            self.sync_us = raw_us
+        else:
+            # esp_timer low 32 bits wrap after ~71 minutes
+            self.sync_us += (raw_us - self.sync_us) & 0xFFFFFFFF
+        self.sync_cycles = self.pending
+        self.pending = None
+
+    def to_us(self, cycles, mhz):
+        # Syncs come every ~1 s, far below one CCOUNT wrap (~17 s at 240 MHz)
+        return self.sync_us + ((cycles - self.sync_cycles) & 0xFFFFFFFF) / mhz
+
+
+def convert(data):
+    names = {}
+    mhz = None
+    tracks = {}
+    events = []
+    skipped = 0
+
+    for kind, payload in packets(data):
+        if kind == PKT_INFO:
+            mhz, count = struct.unpack_from("<HB", payload, 0)
+            pos = 3
+            for _ in range(count):
+                zone, length = payload[pos], payload[pos + 1]
+                names[zone] = payload[pos + 2:pos + 2 + length].decode("ascii", "replace")
+                pos += 2 + length
+            continue
+
+        core, dropped = struct.unpack_from("<BI", payload, 0)
+        track = tracks.setdefault(core, CoreTrack(core))
+        if dropped != track.dropped:
+            # Lost events: spans open across the gap can no longer be closed
+            track.stack.clear()
+            track.dropped = dropped
+
+        for cycles, zone, phase in struct.iter_unpack(EVENT_FMT, payload[5:]):
+            if phase == PHASE_SYNC:
+                track.pending = cycles
+                continue
+            if phase == PHASE_SYNC_US:
+                if track.pending is not None:
+                    track.sync(cycles)
+                continue
+            track.pending = None
+            if mhz is None or track.sync_us is None or zone not in names:
+                skipped += 1
+                continue
+
+            us = track.to_us(cycles, mhz)
+            if phase == PHASE_BEGIN:
+                track.stack.append((zone, us))
+            elif phase == PHASE_END:
+                # Match the innermost open span of this zone
+                for i in range(len(track.stack) - 1, -1, -1):
+                    if track.stack[i][0] == zone:
+                        start = track.stack[i][1]
+                        del track.stack[i:]
+                        events.append({
+                            "name": names[zone], "ph": "X", "pid": 0, "tid": core,
+                            "ts": round(start, 3), "dur": round(us - start, 3),
+                        })
+                        break
+
+    if not events:
+        sys.exit("error: no complete zones in the capture")
+
+    origin = min(e["ts"] for e in events)
+    for e in events:
+        e["ts"] = round(e["ts"] - origin, 3)
+    for core in sorted(tracks):
+        events.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": core,
+                       "args": {"name": "core %d" % core}})
+    events.append({"name": "process_name", "ph": "M", "pid": 0,
+                   "args": {"name": "ESP32 Tamagotchi"}})
+
+    stats = {
+        "zones": len(names),
+        "spans": sum(1 for e in events if e["ph"] == "X"),
+        "skipped": skipped,
+        "dropped": sum(t.dropped for t in tracks.values()),
+    }
+    return {"traceEvents": events, "displayTimeUnit": "ms"}, stats
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert an ESP32 Tamagotchi zone trace to Chrome JSON")
+    parser.add_argument("capture", nargs="?", help="binary capture file ('-' for stdin)")
+    parser.add_argument("-o", "--output", required=True, help="output JSON file")
+    parser.add_argument("--port", help="read the trace UART directly (pyserial)")
+    parser.add_argument("--seconds", type=float, default=10.0, help="capture time with --port")
+    parser.add_argument("--baud", type=int, default=921600, help="trace UART baud rate")
+    args = parser.parse_args()
+
+    if args.port:
+        data = read_port(args.port, args.seconds, args.baud)
+    elif args.capture == "-":
+        data = sys.stdin.buffer.read()
+    elif args.capture:
+        with open(args.capture, "rb") as f:
+            data = f.read()
+    else:
+        parser.error("give a capture file or --port")
+
+    trace, stats = convert(data)
+    with open(args.output, "w") as f:
+        json.dump(trace, f)
+    print("Trace: %d spans of %d zones -> %s (%d events before sync, %d dropped on device)"
+          % (stats["spans"], stats["zones"], args.output, stats["skipped"], stats["dropped"]))
+
+
+if __name__ == "__main__":
+    main()